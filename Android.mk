@@ -504,6 +504,9 @@ include $(BUILD_SHARED_LIBRARY)
 # Build the wds client
 include $(WEBKIT_PATH)/android/wds/client/Android.mk
 
+# Build the software compositor, tile painting, inval replay and RTree benchmarks
+include $(WEBKIT_PATH)/android/benchmark/Android.mk
+
 ifeq ($(ENABLE_WEBAUDIO),true)
 ifeq ($(ARCH_ARM_HAVE_NEON),true)
 # Build the VectorMath NEON routines
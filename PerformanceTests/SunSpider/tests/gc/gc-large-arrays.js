@@ -0,0 +1,20 @@
+// Builds and drops arrays whose vectors are large enough to be allocated
+// outside of the cell heap, while a few of them are kept alive. The memory
+// they use should stay flat from one iteration to the next.
+
+var kept = [];
+var total = 0;
+for (var i = 0; i < 200; ++i) {
+    var array = [];
+    for (var j = 0; j < 20000; ++j)
+        array.push(j);
+    total += array[array.length - 1];
+
+    if (!(i % 20))
+        kept.push(array);
+    else if (i % 2)
+        array.length = 10;
+}
+
+for (var i = 0; i < kept.length; ++i)
+    total += kept[i].length;
@@ -0,0 +1,28 @@
+// Keeps long linked lists alive while allocating garbage. A list can only
+// be marked one node after the other, which is the worst case for splitting
+// the marking work.
+
+function makeList(length)
+{
+    var head = null;
+    for (var i = 0; i < length; ++i)
+        head = { value: i, next: head };
+    return head;
+}
+
+var lists = [];
+for (var i = 0; i < 8; ++i)
+    lists.push(makeList(25000));
+
+var garbage;
+for (var i = 0; i < 150; ++i) {
+    garbage = [];
+    for (var j = 0; j < 2000; ++j)
+        garbage.push("string" + j);
+}
+
+var sum = 0;
+for (var i = 0; i < lists.length; ++i) {
+    for (var node = lists[i]; node; node = node.next)
+        sum += node.value;
+}
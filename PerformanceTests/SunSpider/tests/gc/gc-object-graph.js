@@ -0,0 +1,49 @@
+// Builds a large graph of objects with random edges between them, then
+// replaces parts of it while keeping the rest alive, so that collections
+// mark a big and irregular live graph.
+
+var seed = 49734321;
+function random()
+{
+    // Robert Jenkins' 32 bit integer hash, deterministic across runs
+    seed = ((seed + 0x7ed55d16) + (seed << 12))  & 0xffffffff;
+    seed = ((seed ^ 0xc761c23c) ^ (seed >>> 19)) & 0xffffffff;
+    seed = ((seed + 0x165667b1) + (seed << 5))   & 0xffffffff;
+    seed = ((seed + 0xd3a2646c) ^ (seed << 9))   & 0xffffffff;
+    seed = ((seed + 0xfd7046c5) + (seed << 3))   & 0xffffffff;
+    seed = ((seed ^ 0xb55a4f09) ^ (seed >>> 16)) & 0xffffffff;
+    return (seed & 0xfffffff) / 0x10000000;
+}
+
+var nodeCount = 60000;
+var edgesPerNode = 4;
+var nodes = new Array(nodeCount);
+
+function makeNode(id)
+{
+    return { id: id, name: "node" + id, edges: new Array(edgesPerNode), payload: [id, id * 2, id * 3] };
+}
+
+for (var i = 0; i < nodeCount; ++i)
+    nodes[i] = makeNode(i);
+
+function link(node)
+{
+    for (var j = 0; j < edgesPerNode; ++j)
+        node.edges[j] = nodes[Math.floor(random() * nodeCount)];
+}
+
+for (var i = 0; i < nodeCount; ++i)
+    link(nodes[i]);
+
+for (var round = 0; round < 20; ++round) {
+    for (var i = 0; i < nodeCount / 10; ++i) {
+        var index = Math.floor(random() * nodeCount);
+        nodes[index] = makeNode(index);
+        link(nodes[index]);
+    }
+}
+
+var reachable = 0;
+for (var i = 0; i < nodeCount; i += 100)
+    reachable += nodes[i].edges[0].id;
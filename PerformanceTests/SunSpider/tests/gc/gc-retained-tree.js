@@ -0,0 +1,34 @@
+// Keeps a large balanced tree alive while allocating short lived garbage,
+// so that every collection has to mark the whole tree.
+
+function TreeNode(left, right, value)
+{
+    this.left = left;
+    this.right = right;
+    this.value = value;
+}
+
+function buildTree(depth, value)
+{
+    if (!depth)
+        return new TreeNode(null, null, value);
+    return new TreeNode(buildTree(depth - 1, 2 * value), buildTree(depth - 1, 2 * value + 1), value);
+}
+
+function checkTree(node)
+{
+    if (!node.left)
+        return node.value;
+    return node.value + checkTree(node.left) - checkTree(node.right);
+}
+
+var retained = buildTree(16, 1);
+
+var garbage;
+for (var i = 0; i < 200; ++i) {
+    garbage = [];
+    for (var j = 0; j < 2000; ++j)
+        garbage.push({ index: j, next: garbage[j - 1] });
+}
+
+var result = checkTree(retained);
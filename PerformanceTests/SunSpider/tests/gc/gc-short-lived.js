@@ -0,0 +1,26 @@
+// Allocates mostly temporaries, the way DOM bindings and string building do,
+// while a long lived table keeps being updated with some of the new values.
+// Collections of the young generation only have to mark the survivors and
+// the slots of the table that were written since the previous collection.
+
+var table = [];
+for (var i = 0; i < 20000; ++i)
+    table.push({ key: "k" + i, value: null });
+
+var checksum = 0;
+for (var i = 0; i < 300; ++i) {
+    for (var j = 0; j < 1000; ++j) {
+        var point = { x: i, y: j };
+        var label = "(" + point.x + ", " + point.y + ")";
+        var parts = [label, label.length, point];
+        checksum += parts[1];
+    }
+    // Store a few young objects in old ones.
+    for (var j = 0; j < 50; ++j)
+        table[(i * 50 + j) % table.length].value = { index: i, name: "v" + j };
+}
+
+for (var i = 0; i < table.length; ++i) {
+    if (table[i].value)
+        checksum += table[i].value.index;
+}
@@ -0,0 +1,17 @@
+// Builds int32, double and object arrays one Array.prototype.push at a time.
+
+var total = 0;
+for (var n = 0; n < 200; ++n) {
+    var ints = [];
+    var doubles = [];
+    var objects = [];
+    for (var i = 0; i < 1000; ++i) {
+        ints.push(i);
+        doubles.push(i + 0.5);
+        objects.push({ value: i });
+    }
+    total += ints.length + doubles.length + objects.push(null);
+}
+
+if (total != 200 * 3001)
+    throw "ERROR: bad result: " + total;
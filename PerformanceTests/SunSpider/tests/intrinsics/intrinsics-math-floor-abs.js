@@ -0,0 +1,12 @@
+// Calls Math.floor and Math.abs on int32 and double arguments in a hot loop.
+
+var sum = 0;
+for (var i = 0; i < 500000; ++i) {
+    var x = (i % 2000) - 1000;
+    sum += Math.abs(x);
+    sum += Math.floor(i / 7);
+    sum += Math.floor(Math.abs(x * 0.37));
+}
+
+if (sum != 18199145358)
+    throw "ERROR: bad result: " + sum;
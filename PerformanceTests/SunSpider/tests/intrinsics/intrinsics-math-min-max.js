@@ -0,0 +1,13 @@
+// Clamps int32 and double values with Math.min and Math.max.
+
+var ints = 0;
+var doubles = 0;
+for (var i = 0; i < 500000; ++i) {
+    var x = (i * 7919) % 3001 - 1500;
+    ints += Math.max(-1000, Math.min(1000, x));
+    var y = x * 0.25;
+    doubles += Math.max(-250.5, Math.min(250.5, y));
+}
+
+if (ints != 1284 || doubles != 321)
+    throw "ERROR: bad result: " + ints + " " + doubles;
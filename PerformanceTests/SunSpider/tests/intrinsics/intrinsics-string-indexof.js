@@ -0,0 +1,21 @@
+// Scans flat strings for single character separators with String.prototype.indexOf.
+
+var words = [];
+for (var i = 0; i < 40; ++i)
+    words.push("field" + i);
+var record = words.join(",") + ";";
+
+var fields = 0;
+for (var n = 0; n < 4000; ++n) {
+    var start = 0;
+    var end;
+    while ((end = record.indexOf(",", start)) >= 0) {
+        ++fields;
+        start = end + 1;
+    }
+    if (record.indexOf(";") != record.length - 1 || record.indexOf("#") != -1)
+        throw "ERROR: bad separator position";
+}
+
+if (fields != 4000 * 39)
+    throw "ERROR: bad result: " + fields;
@@ -0,0 +1,25 @@
+// Parses a multi-megabyte array of records that all have the same keys, as
+// returned by a typical web service.
+
+var records = [];
+for (var i = 0; i < 20000; ++i) {
+    records.push({
+        id: i,
+        name: "user" + i,
+        email: "user" + i + "@example.com",
+        active: !(i % 3),
+        score: i * 1.5,
+        tags: ["alpha", "beta", "gamma"].slice(0, i % 4),
+        address: { street: i + " Main Street", city: "Springfield", zip: "0" + (10000 + i) }
+    });
+}
+var text = JSON.stringify(records);
+
+var total = 0;
+for (var i = 0; i < 4; ++i) {
+    var parsed = JSON.parse(text);
+    total += parsed.length + parsed[parsed.length - 1].address.city.length;
+}
+
+if (text.length < 2000000 || total != 80044)
+    throw "ERROR: bad result: " + text.length + " " + total;
@@ -0,0 +1,20 @@
+// Round trips mixed documents: nested objects with varying keys, escaped
+// strings and numeric arrays.
+
+var documents = [];
+for (var i = 0; i < 2000; ++i) {
+    var document = { kind: i % 2 ? "post" : "comment", body: "Line one\nLine \"two\"\t\u00e9\u4e2d", values: [] };
+    for (var j = 0; j < 20; ++j)
+        document.values.push(i * j / 7);
+    document["field" + (i % 50)] = { nested: { deeper: [i, String(i), null, true] } };
+    documents.push(document);
+}
+
+var checksum = 0;
+for (var i = 0; i < 10; ++i) {
+    var copy = JSON.parse(JSON.stringify(documents));
+    checksum += copy.length + copy[1999].values.length;
+}
+
+if (checksum != 20200)
+    throw "ERROR: bad result: " + checksum;
@@ -0,0 +1,19 @@
+// Stringifies a large array of records sharing a few shapes, with and without
+// indentation.
+
+var records = [];
+for (var i = 0; i < 20000; ++i) {
+    var record = { id: i, title: "Item \"" + i + "\"", price: i / 4, inStock: !!(i & 1) };
+    if (i % 5 == 0)
+        record.discount = { percent: 10, until: "2011-12-31" };
+    records.push(record);
+}
+
+var length = 0;
+for (var i = 0; i < 3; ++i) {
+    length += JSON.stringify(records).length;
+    length += JSON.stringify(records, null, 2).length;
+}
+
+if (length < 10000000)
+    throw "ERROR: bad result: " + length;
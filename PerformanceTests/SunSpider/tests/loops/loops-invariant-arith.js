@@ -0,0 +1,16 @@
+// Integer loops whose bodies recompute values depending only on variables that
+// do not change within the loop.
+
+var width = 640;
+var height = 480;
+var stride = 4;
+var checksum = 0;
+for (var frame = 0; frame < 20; ++frame) {
+    var base = frame * 7;
+    for (var y = 0; y < height; ++y) {
+        var row = 0;
+        for (var x = 0; x < width; ++x)
+            row = (row + x * stride + (width * stride ^ base) + (base << 2)) | 0;
+        checksum = (checksum + row) | 0;
+    }
+}
@@ -0,0 +1,27 @@
+// Rotates and scales a set of vertices in long running loops, as 3d-cube does,
+// with the transform coefficients computed once per frame outside the inner loop.
+
+var vertexCount = 2000;
+var xs = new Array(vertexCount), ys = new Array(vertexCount), zs = new Array(vertexCount);
+for (var i = 0; i < vertexCount; ++i) {
+    xs[i] = (i % 10) - 5;
+    ys[i] = ((i / 10) % 10) - 5;
+    zs[i] = ((i / 100) % 10) - 5;
+}
+
+var checksum = 0;
+for (var frame = 0; frame < 100; ++frame) {
+    var angle = frame * Math.PI / 180;
+    var c = Math.cos(angle);
+    var s = Math.sin(angle);
+    var scale = 1 + frame / 1000;
+    for (var i = 0; i < vertexCount; ++i) {
+        var x = xs[i];
+        var y = ys[i] * c - zs[i] * s;
+        var z = ys[i] * s + zs[i] * c;
+        xs[i] = (x * c + z * s) * scale;
+        ys[i] = y * scale;
+        zs[i] = (z * c - x * s) * scale;
+    }
+    checksum += xs[frame] + ys[frame] + zs[frame];
+}
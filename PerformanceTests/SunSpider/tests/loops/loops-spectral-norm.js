@@ -0,0 +1,35 @@
+// The math-spectral-norm kernel with its loops written out in a single body,
+// so the hot code is only ever reached through long running loops rather than
+// through calls.
+
+var n = 300;
+var u = new Array(n), v = new Array(n), w = new Array(n);
+for (var i = 0; i < n; ++i)
+    u[i] = 1;
+
+for (var iteration = 0; iteration < 10; ++iteration) {
+    // w = A * u, v = At * w, twice over u and v.
+    for (var pass = 0; pass < 2; ++pass) {
+        var from = pass ? v : u;
+        var to = pass ? u : v;
+        for (var i = 0; i < n; ++i) {
+            var sum = 0;
+            for (var j = 0; j < n; ++j)
+                sum += from[j] / ((i + j) * (i + j + 1) / 2 + i + 1);
+            w[i] = sum;
+        }
+        for (var i = 0; i < n; ++i) {
+            var sum = 0;
+            for (var j = 0; j < n; ++j)
+                sum += w[j] / ((j + i) * (j + i + 1) / 2 + j + 1);
+            to[i] = sum;
+        }
+    }
+}
+
+var vBv = 0, vv = 0;
+for (var i = 0; i < n; ++i) {
+    vBv += u[i] * v[i];
+    vv += v[i] * v[i];
+}
+var norm = Math.sqrt(vBv / vv);
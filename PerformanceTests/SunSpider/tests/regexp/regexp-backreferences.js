@@ -0,0 +1,28 @@
+// Patterns using back references, as found in tokenizers and markup scanners.
+
+var words = ["the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog"];
+var text = "";
+for (var i = 0; i < 3000; ++i) {
+    var word = words[i % words.length];
+    text += word + " ";
+    if (i % 17 == 0)
+        text += word + " ";
+    if (i % 11 == 0)
+        text += "<b class=\"w" + i + "\">" + word + "</b> ";
+    if (i % 13 == 0)
+        text += "'" + word + "' \"" + words[(i + 3) % words.length] + "\" ";
+}
+
+var doubled = 0;
+var doubledWords = /\b(\w+)\s+\1\b/g;
+while (doubledWords.exec(text))
+    ++doubled;
+
+var quoted = text.match(/(['"])[^'"]*\1/g) || [];
+
+var tags = 0;
+var elements = /<(\w+)[^>]*>[^<]*<\/\1>/g;
+while (elements.exec(text))
+    ++tags;
+
+var collapsed = text.replace(/(\w)\1+/g, "$1");
@@ -0,0 +1,39 @@
+// The regexp-dna patterns run over a generated sequence, with the variant
+// patterns written using alternation inside capturing parentheses.
+
+var bases = "acgt";
+var seed = 42;
+function nextBase()
+{
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return bases.charAt((seed >> 16) & 3);
+}
+
+var lines = [];
+for (var i = 0; i < 2000; ++i) {
+    var line = "";
+    for (var j = 0; j < 60; ++j)
+        line += nextBase();
+    lines.push(line);
+}
+var dna = ">ONE generated\n" + lines.join("\n") + "\n";
+dna = dna.replace(/>.*\n|\n/g, "");
+
+var variants = [
+    /(agggtaaa|tttaccct)/ig,
+    /([cgt]gggtaaa|tttaccc[acg])/ig,
+    /(a[act]ggtaaa|tttacc[agt]t)/ig,
+    /(ag[act]gtaaa|tttac[agt]ct)/ig,
+    /(agg[act]taaa|ttta[agt]cct)/ig,
+    /(aggg[acg]aaa|ttt[cgt]ccct)/ig,
+    /(agggt[cgt]aa|tt[acg]accct)/ig,
+    /(agggta[cgt]a|t[acg]taccct)/ig,
+    /(agggtaa[cgt]|[acg]ttaccct)/ig
+];
+
+var counts = [];
+for (var i = 0; i < variants.length; ++i)
+    counts.push((dna.match(variants[i]) || []).length);
+
+// Runs of the same base, found with a back reference.
+var repeats = dna.match(/([acgt])\1\1\1/g) || [];
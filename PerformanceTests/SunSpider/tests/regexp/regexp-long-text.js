@@ -0,0 +1,33 @@
+// replace, split and match over a long text with selective patterns, where
+// almost every starting position can be rejected before attempting a match.
+
+var words = ["lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing",
+             "elit", "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore"];
+var parts = [];
+var seed = 49734321;
+for (var i = 0; i < 20000; ++i) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    parts.push(words[seed % words.length]);
+    if (!(i % 997))
+        parts.push("ERROR:" + i);
+    if (!(i % 1511))
+        parts.push("<id=" + i + ">");
+}
+var text = parts.join(" ");
+
+var errors = 0;
+var ids = 0;
+var pieces = 0;
+for (var i = 0; i < 10; ++i) {
+    var m = text.match(/ERROR:\d+/g);
+    errors += m ? m.length : 0;
+    text.replace(/<id=(\d+)>/g, function(all, id) { ids += id.length; return all; });
+    pieces += text.split(/\s*ERROR:/).length;
+    if (/XYZZY/i.test(text))
+        ++errors;
+    if (/[#@]\w+/.test(text))
+        ++errors;
+}
+
+if (errors != 210 || pieces != 220)
+    throw "ERROR: bad result: " + errors + " " + pieces;
@@ -0,0 +1,22 @@
+// Client side templating: placeholders are found and substituted with
+// regular expressions, the way small template libraries do it.
+
+var template = "<div class=\"{{ cls }}\"><h1>{{title}}</h1><p><%= body %></p>"
+    + "<a href=\"{{ link }}\">{{ linkText }}</a><% if (footer) { %><small>{{footer}}</small><% } %></div>\n";
+var page = "";
+for (var i = 0; i < 200; ++i)
+    page += template;
+
+var values = { cls: "entry", title: "Hello", body: "Some text", link: "/next", linkText: "Next", footer: "Bye" };
+
+var output;
+for (var i = 0; i < 20; ++i) {
+    output = page.replace(/\{\{\s*(\w+)\s*\}\}/g, function(match, name) {
+        return values[name];
+    });
+    output = output.replace(/<%=\s*([\s\S]+?)\s*%>/g, function(match, name) {
+        return values[name];
+    });
+    output = output.replace(/<%([\s\S]+?)%>/g, "");
+    output = output.replace(/(["'])(\/[^"']*)\1/g, "$1http://example.com$2$1");
+}
@@ -0,0 +1,29 @@
+// Form validation style regular expressions, each tested against a mix of
+// valid and invalid inputs.
+
+var validators = [
+    /^[a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,4}$/,
+    /^(https?):\/\/([\w-]+(\.[\w-]+)+)(:\d+)?(\/[\w.\/-]*)?(\?[\w=&%-]*)?$/,
+    /^(\d{4})-(\d{2})-(\d{2})$/,
+    /^(\d{3})[- ]?(\d{3})[- ]?(\d{4})$/,
+    /^(?:(?:25[0-5]|2[0-4]\d|1?\d?\d)\.){3}(?:25[0-5]|2[0-4]\d|1?\d?\d)$/,
+    /^#?([a-fA-F0-9]{6}|[a-fA-F0-9]{3})$/,
+    /^(\d+)(?:\.(\d+))?(?:\.(\d+))?(?:-([\w.]+))?$/
+];
+
+var inputs = [
+    "jane.doe@example.com", "not an email", "user+tag@mail.example.org",
+    "http://www.example.com/path/to/page.html?x=1&y=2", "ftp://example.com", "https://example.org:8080/",
+    "2011-05-24", "24/05/2011", "555-123-4567", "555 123 4567", "5551234",
+    "192.168.0.1", "256.1.1.1", "#a0b1c2", "#xyz", "1.2.3-beta.1", "1..2"
+];
+
+var valid = 0;
+for (var i = 0; i < 1500; ++i) {
+    for (var j = 0; j < validators.length; ++j) {
+        for (var k = 0; k < inputs.length; ++k) {
+            if (validators[j].test(inputs[k]))
+                ++valid;
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// Sorts arrays of doubles, such as distances or coordinates, with the
+// numeric comparison function.
+
+var seed = 1234567;
+function random()
+{
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed / 0x7fffffff;
+}
+
+var checksum = 0;
+for (var n = 0; n < 40; ++n) {
+    var distances = [];
+    for (var i = 0; i < 4000; ++i) {
+        var x = random() - 0.5;
+        var y = random() - 0.5;
+        distances[i] = Math.sqrt(x * x + y * y);
+    }
+    distances.sort(function(a, b) { return a - b; });
+    for (var i = 1; i < distances.length; ++i) {
+        if (distances[i - 1] > distances[i])
+            throw "ERROR: array is not sorted at " + i;
+    }
+    checksum += distances[distances.length >> 1];
+}
+
+if (checksum <= 0)
+    throw "ERROR: bad result: " + checksum;
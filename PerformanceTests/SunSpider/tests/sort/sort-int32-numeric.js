@@ -0,0 +1,25 @@
+// Sorts arrays of small integers with the numeric comparison function, which
+// the engine recognizes and sorts without calling back into script.
+
+var seed = 49734321;
+function random()
+{
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    return seed;
+}
+
+var checksum = 0;
+for (var n = 0; n < 40; ++n) {
+    var values = [];
+    for (var i = 0; i < 5000; ++i)
+        values.push(random() % 100000);
+    values.sort(function(a, b) { return a - b; });
+    for (var i = 1; i < values.length; ++i) {
+        if (values[i - 1] > values[i])
+            throw "ERROR: array is not sorted at " + i;
+    }
+    checksum += values[0] + values[values.length - 1];
+}
+
+if (checksum <= 0)
+    throw "ERROR: bad result: " + checksum;
@@ -0,0 +1,23 @@
+// Fills integer arrays element by element, then searches them with indexOf
+// and serializes them with join.
+
+var table = new Array(2000);
+for (var i = 0; i < table.length; ++i)
+    table[i] = (i * 7919) % 2000;
+
+var found = 0;
+for (var n = 0; n < 400; ++n) {
+    if (table.indexOf((n * 37) % 2000) >= 0)
+        ++found;
+}
+
+var length = 0;
+for (var n = 0; n < 60; ++n) {
+    var row = [];
+    for (var i = 0; i < 500; ++i)
+        row[i] = i * n - 1000;
+    length += row.join(",").length;
+}
+
+if (found != 400 || length <= 0)
+    throw "ERROR: bad result: " + found + " " + length;
@@ -0,0 +1,21 @@
+// Reads many large buffers but only keeps a few short fields of each. The
+// fields must not keep their buffers alive; run with jsc -g to see how many
+// buffers were released.
+
+var kept = [];
+for (var i = 0; i < 300; ++i) {
+    var parts = [];
+    for (var j = 0; j < 500; ++j)
+        parts.push("record " + i + "/" + j + " payload " + "abcdefghijklmnopqrstuvwxyz0123456789".substr(j % 20));
+    var buffer = parts.join(";");
+    var start = buffer.indexOf("payload");
+    kept.push(buffer.substr(start, 40));
+    kept.push(buffer.slice(-30));
+}
+
+var length = 0;
+for (var i = 0; i < kept.length; ++i)
+    length += kept[i].length;
+
+if (length != 300 * 70)
+    throw "ERROR: bad result: " + length;
@@ -0,0 +1,18 @@
+// Scans strings built by concatenating a few large pieces one character at a
+// time, without flattening them first.
+
+var header = "";
+for (var i = 0; i < 2000; ++i)
+    header += String.fromCharCode(65 + i % 26);
+var body = header.toLowerCase();
+
+var checksum = 0;
+for (var n = 0; n < 20; ++n) {
+    var message = header + "\r\n" + body + n;
+    for (var i = 0; i < message.length; i += 3)
+        checksum += message.charCodeAt(i);
+    checksum += message.charAt(message.length - 1).length;
+}
+
+if (checksum <= 0)
+    throw "ERROR: bad result: " + checksum;
@@ -0,0 +1,36 @@
+// Tokenizes a large log buffer by slicing it at each field, the way log
+// processing scripts do.
+
+var lines = [];
+for (var i = 0; i < 20000; ++i) {
+    lines.push("2011-06-" + (10 + i % 20) + " 12:" + (10 + i % 50) + ":07 host" + (i % 17)
+               + " GET /static/images/icon" + (i % 300) + ".png 200 " + (i * 37 % 100000)
+               + " \"Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/534.30 (KHTML, like Gecko)\"");
+}
+var buffer = lines.join("\n");
+
+var statusCount = 0;
+var bytes = 0;
+var position = 0;
+while (position < buffer.length) {
+    var end = buffer.indexOf("\n", position);
+    if (end < 0)
+        end = buffer.length;
+    var line = buffer.slice(position, end);
+    var fieldStart = 0;
+    var fields = [];
+    while (fields.length < 7) {
+        var space = line.indexOf(" ", fieldStart);
+        if (space < 0)
+            space = line.length;
+        fields.push(line.substring(fieldStart, space));
+        fieldStart = space + 1;
+    }
+    if (fields[5] == "200")
+        ++statusCount;
+    bytes += parseInt(fields[6]);
+    position = end + 1;
+}
+
+if (statusCount != 20000)
+    throw "ERROR: bad result: " + statusCount;
@@ -76,6 +76,7 @@ SOURCES += \
     heap/HandleHeap.cpp \
     heap/HandleStack.cpp \
     heap/Heap.cpp \
+    heap/LargeObjectSpace.cpp \
     heap/MachineStackMarker.cpp \
     heap/MarkStack.cpp \
     heap/MarkStackPosix.cpp \
@@ -108,17 +109,21 @@ SOURCES += \
     jit/JITPropertyAccess.cpp \
     jit/JITPropertyAccess32_64.cpp \
     jit/JITStubs.cpp \
+    jit/MegamorphicCache.cpp \
     jit/ThunkGenerators.cpp \
     parser/JSParser.cpp \
     parser/Lexer.cpp \
     parser/Nodes.cpp \
     parser/ParserArena.cpp \
     parser/Parser.cpp \
+    parser/PersistentParseCache.cpp \
     parser/SourceProviderCache.cpp \
+    profiler/ParseProfiler.cpp \
     profiler/Profile.cpp \
     profiler/ProfileGenerator.cpp \
     profiler/ProfileNode.cpp \
     profiler/Profiler.cpp \
+    profiler/SamplingProfiler.cpp \
     runtime/ArgList.cpp \
     runtime/Arguments.cpp \
     runtime/ArrayConstructor.cpp \
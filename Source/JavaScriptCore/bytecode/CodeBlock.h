@@ -283,10 +283,10 @@ namespace JSC {
         Vector<Instruction>& instructions() { return m_instructions; }
         void discardBytecode() { m_instructions.clear(); }
 
-#ifndef NDEBUG
+        // The number of instructions, which outlives them once the bytecode
+        // is discarded after JIT compilation.
         unsigned instructionCount() { return m_instructionCount; }
         void setInstructionCount(unsigned instructionCount) { m_instructionCount = instructionCount; }
-#endif
 
 #if ENABLE(JIT)
         JITCode& getJITCode() { return m_isConstructor ? ownerExecutable()->generatedJITCodeForConstruct() : ownerExecutable()->generatedJITCodeForCall(); }
@@ -493,9 +493,7 @@ namespace JSC {
         JSGlobalData* m_globalData;
 
         Vector<Instruction> m_instructions;
-#ifndef NDEBUG
         unsigned m_instructionCount;
-#endif
 
         int m_thisRegister;
         int m_argumentsRegister;
@@ -143,9 +143,9 @@ JSObject* BytecodeGenerator::generate()
 
     m_scopeNode->emitBytecode(*this);
 
-#ifndef NDEBUG
     m_codeBlock->setInstructionCount(m_codeBlock->instructions().size());
 
+#ifndef NDEBUG
     if (s_dumpsGeneratedCode)
         m_codeBlock->dump(m_scopeChain->globalObject->globalExec());
 #endif
@@ -1594,10 +1594,21 @@ RegisterID* BytecodeGenerator::emitNewRegExp(RegisterID* dst, PassRefPtr<RegExp>
     return dst;
 }
 
-RegisterID* BytecodeGenerator::emitNewFunctionExpression(RegisterID* r0, FuncExprNode* n)
+RegisterID* BytecodeGenerator::emitNewFunctionExpression(RegisterID* r0, FuncExprNode* n, bool isCallee)
 {
     FunctionBodyNode* function = n->body();
-    unsigned index = m_codeBlock->addFunctionExpr(makeFunction(m_globalData, function));
+    FunctionExecutable* executable = makeFunction(m_globalData, function);
+    unsigned index = m_codeBlock->addFunctionExpr(executable);
+    if (function->data()) {
+        // The parser kept the tree of this function (see JSParser::shouldParseFunctionEagerly).
+        // When it is called right away, outside of with and catch blocks, the function runs
+        // in the scope chain of the program so it can be compiled now. An error is reported
+        // again on the first call. A named function runs with its name in scope, in front of
+        // the program scope chain, so it has to wait for op_new_func_exp to create that scope.
+        if (isCallee && m_codeType == GlobalCode && !m_dynamicScopeDepth && function->ident().isNull())
+            executable->compileForCall(function, m_scopeChain.get());
+        function->destroyData();
+    }
     
     createActivationIfNecessary();
     emitOpcode(op_new_func_exp);
@@ -239,6 +239,18 @@ GPRReg SpeculativeJIT::fillSpeculateCell(NodeIndex nodeIndex)
     return InvalidGPRReg;
 }
 
+void SpeculativeJIT::recordArrayValueKind(MacroAssembler::RegisterID storageReg, MacroAssembler::RegisterID valueReg)
+{
+    MacroAssembler::Jump isInteger = m_jit.branchPtr(MacroAssembler::AboveOrEqual, valueReg, JITCompiler::tagTypeNumberRegister);
+    MacroAssembler::Jump notNumber = m_jit.branchTestPtr(MacroAssembler::Zero, valueReg, JITCompiler::tagTypeNumberRegister);
+    m_jit.store32(TrustedImm32(1), MacroAssembler::Address(storageReg, OBJECT_OFFSETOF(ArrayStorage, m_hasDoubles)));
+    MacroAssembler::Jump done = m_jit.jump();
+    notNumber.link(&m_jit);
+    m_jit.store32(TrustedImm32(1), MacroAssembler::Address(storageReg, OBJECT_OFFSETOF(ArrayStorage, m_hasNonNumbers)));
+    isInteger.link(&m_jit);
+    done.link(&m_jit);
+}
+
 bool SpeculativeJIT::compile(Node& node)
 {
     checkConsistency();
@@ -612,6 +624,7 @@ bool SpeculativeJIT::compile(Node& node)
 
         // Store the value to the array.
         m_jit.storePtr(valueReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
+        recordArrayValueKind(storageReg, valueReg);
 
         noResult(m_compileIndex);
         break;
@@ -633,6 +646,7 @@ bool SpeculativeJIT::compile(Node& node)
 
         // Store the value to the array.
         m_jit.storePtr(valueReg, MacroAssembler::BaseIndex(storageReg, propertyReg, MacroAssembler::ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
+        recordArrayValueKind(storageReg, valueReg);
 
         noResult(m_compileIndex);
         break;
@@ -175,6 +175,9 @@ private:
     template<bool strict>
     GPRReg fillSpeculateIntInternal(NodeIndex, DataFormat& returnFormat);
 
+    // Marks the array storage as holding doubles or non-numbers, as JSArray does for stores from C++.
+    void recordArrayValueKind(MacroAssembler::RegisterID storageReg, MacroAssembler::RegisterID valueReg);
+
     // It is possible, during speculative generation, to reach a situation in which we
     // can statically determine a speculation will fail (for example, when two nodes
     // will make conflicting speculations about the same operand). In such cases this
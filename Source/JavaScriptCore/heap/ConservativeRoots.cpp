@@ -55,4 +55,13 @@ void ConservativeRoots::add(void* begin, void* end)
         add(*it);
 }
 
+void ConservativeRoots::add(ConservativeRoots& other)
+{
+    for (size_t i = 0; i < other.m_size; ++i) {
+        if (m_size == m_capacity)
+            grow();
+        m_roots[m_size++] = other.m_roots[i];
+    }
+}
+
 } // namespace JSC
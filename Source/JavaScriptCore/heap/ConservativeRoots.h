@@ -44,6 +44,8 @@ public:
 
     void add(void*);
     void add(void* begin, void* end);
+    // Adds the roots found by another instance, they are not checked again
+    void add(ConservativeRoots&);
     
     size_t size();
     JSCell** roots();
@@ -89,6 +89,15 @@ void HandleHeap::markWeakHandles(HeapRootMarker& heapRootMarker)
     }
 }
 
+void HandleHeap::markAllWeakHandles(HeapRootMarker& heapRootMarker)
+{
+    Node* end = m_weakList.end();
+    for (Node* node = m_weakList.begin(); node != end; node = node->next()) {
+        ASSERT(isValidWeakNode(node));
+        heapRootMarker.mark(node->slot());
+    }
+}
+
 void HandleHeap::finalizeWeakHandles()
 {
     Node* end = m_weakList.end();
@@ -63,6 +63,9 @@ public:
 
     void markStrongHandles(HeapRootMarker&);
     void markWeakHandles(HeapRootMarker&);
+    // Treats weak handles as strong, for collections that can't tell which
+    // opaque roots are reachable.
+    void markAllWeakHandles(HeapRootMarker&);
     void finalizeWeakHandles();
 
     void writeBarrier(HandleSlot, const JSValue&);
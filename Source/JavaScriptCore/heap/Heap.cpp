@@ -29,8 +29,11 @@
 #include "JSGlobalObject.h"
 #include "JSLock.h"
 #include "JSONObject.h"
+#include "JSString.h"
+#include "MegamorphicCache.h"
 #include "Tracing.h"
 #include <algorithm>
+#include <wtf/CurrentTime.h>
 
 #define COLLECT_ON_EVERY_SLOW_ALLOCATION 0
 
@@ -40,6 +43,16 @@ namespace JSC {
 
 const size_t minBytesPerCycle = 512 * 1024;
 
+#if ENABLE(GGC)
+// Bytes of new blocks allocated between two minor collections, the cells
+// freed by the previous collection are reused first.
+const size_t youngGenerationBytes = 512 * 1024;
+// A full collection is done when the heap has grown by this factor since the
+// last one, or after this many minor collections.
+const size_t oldGenerationGrowthFactor = 2;
+const size_t maxMinorCollections = 32;
+#endif
+
 Heap::Heap(JSGlobalData* globalData)
     : m_operationInProgress(NoOperation)
     , m_markedSpace(globalData)
@@ -47,11 +60,25 @@ Heap::Heap(JSGlobalData* globalData)
     , m_activityCallback(DefaultGCActivityCallback::create(this))
     , m_globalData(globalData)
     , m_machineThreads(this)
+#if ENABLE(PARALLEL_GC)
+    , m_sharedData(this, globalData->jsArrayVPtr)
+    , m_markStack(globalData->jsArrayVPtr, &m_sharedData)
+#else
     , m_markStack(globalData->jsArrayVPtr)
+#endif
     , m_handleHeap(globalData)
     , m_extraCost(0)
+    , m_sweepTimeBeforeLastCollection(0)
+    , m_youngGenerationEnabled(false)
+#if ENABLE(GGC)
+    , m_hasOldGeneration(false)
+    , m_minorCollectionsSinceFullCollection(0)
+    , m_sizeAfterLastCollection(0)
+    , m_sizeAfterFullCollection(0)
+#endif
 {
     m_markedSpace.setHighWaterMark(minBytesPerCycle);
+    m_largeObjectSpace.setHighWaterMark(minBytesPerCycle);
     (*m_activityCallback)();
 }
 
@@ -84,6 +111,7 @@ void Heap::destroy()
     m_markedSpace.clearMarks();
     m_handleHeap.finalizeWeakHandles();
     m_markedSpace.destroy();
+    m_largeObjectSpace.destroy();
 
     m_globalData = 0;
 }
@@ -106,6 +134,72 @@ void Heap::reportExtraMemoryCostSlowCase(size_t cost)
     m_extraCost += cost;
 }
 
+void* Heap::allocateStorage(size_t bytes)
+{
+    void* result = tryAllocateStorage(bytes);
+    if (!result)
+        CRASH();
+    return result;
+}
+
+void* Heap::tryAllocateStorage(size_t bytes)
+{
+    if (bytes >= LargeObjectSpace::minimumAllocationSize)
+        return m_largeObjectSpace.tryAllocate(bytes);
+    void* result;
+    if (!tryFastMalloc(bytes).getValue(result))
+        return 0;
+    return result;
+}
+
+void* Heap::tryReallocateStorage(void* storage, size_t usedSize, size_t newSize)
+{
+    if (m_largeObjectSpace.contains(storage))
+        return m_largeObjectSpace.tryReallocate(storage, usedSize, newSize);
+
+    if (newSize >= LargeObjectSpace::minimumAllocationSize) {
+        void* result = m_largeObjectSpace.tryAllocate(newSize);
+        if (!result)
+            return 0;
+        memcpy(result, storage, min(usedSize, newSize));
+        fastFree(storage);
+        return result;
+    }
+
+    void* result;
+    if (!tryFastRealloc(storage, newSize).getValue(result))
+        return 0;
+    return result;
+}
+
+void Heap::shrinkStorage(void* storage, size_t usedSize)
+{
+    if (m_largeObjectSpace.contains(storage))
+        m_largeObjectSpace.shrink(storage, usedSize);
+}
+
+void Heap::freeStorage(void* storage)
+{
+    if (m_largeObjectSpace.contains(storage)) {
+        m_largeObjectSpace.deallocate(storage);
+        return;
+    }
+    fastFree(storage);
+}
+
+void Heap::collectLargeObjects()
+{
+    ASSERT(JSLock::currentThreadIsHoldingLock() || !m_globalData->isSharedInstance());
+    if (m_operationInProgress != NoOperation)
+        return;
+
+    // Large stores are freed when the cells owning them are destroyed, so
+    // this collection can't leave the sweeping for later.
+    reset(DoSweep);
+    m_markedSpace.sweep();
+    m_largeObjectSpace.setHighWaterMark(max(m_largeObjectSpace.size(), minBytesPerCycle));
+}
+
 void* Heap::allocateSlowCase(size_t bytes)
 {
     ASSERT(globalData()->identifierTable == wtfThreadData().currentIdentifierTable());
@@ -119,7 +213,10 @@ void* Heap::allocateSlowCase(size_t bytes)
     ASSERT(m_operationInProgress == NoOperation);
 #endif
 
-    reset(DoNotSweep);
+    if (m_largeObjectSpace.bytesAllocatedSinceCollection() > m_largeObjectSpace.highWaterMark())
+        collectLargeObjects();
+    else
+        reset(DoNotSweep);
 
     m_operationInProgress = Allocation;
     void* result = m_markedSpace.allocate(bytes);
@@ -190,7 +287,7 @@ inline RegisterFile& Heap::registerFile()
     return m_globalData->interpreter->registerFile();
 }
 
-void Heap::markRoots()
+void Heap::markRoots(CollectionType collectionType)
 {
 #ifndef NDEBUG
     if (m_globalData->isSharedInstance()) {
@@ -217,13 +314,36 @@ void Heap::markRoots()
     m_machineThreads.gatherConservativeRoots(machineThreadRoots, &dummy);
 
     ConservativeRoots registerFileRoots(this);
+#if ENABLE(PARALLEL_GC)
+    m_sharedData.gatherConservativeRoots(registerFileRoots, RegisterFile::gatherConservativeRoots,
+                                         registerFile().start(), registerFile().end(), sizeof(Register));
+#else
     registerFile().gatherConservativeRoots(registerFileRoots);
+#endif
 
-    m_markedSpace.clearMarks();
+#if ENABLE(GGC)
+    if (collectionType == MinorCollection)
+        m_markedSpace.clearYoungMarks();
+    else
+#endif
+        m_markedSpace.clearMarks();
 
     markStack.append(machineThreadRoots);
     markStack.drain();
 
+#if ENABLE(GGC)
+    // Old cells stay marked during a minor collection, their children are
+    // only visited if a young cell was stored in them since they became old.
+    if (collectionType == MinorCollection) {
+        HashSet<JSCell*>::iterator end = m_rememberedSet.end();
+        for (HashSet<JSCell*>::iterator it = m_rememberedSet.begin(); it != end; ++it)
+            markStack.appendChildren(*it);
+        markStack.drain();
+    }
+#else
+    UNUSED_PARAM(collectionType);
+#endif
+
     markStack.append(registerFileRoots);
     markStack.drain();
 
@@ -251,6 +371,17 @@ void Heap::markRoots()
     m_globalData->smallStrings.markChildren(heapRootMarker);
     markStack.drain();
     
+#if ENABLE(GGC)
+    // The old cells adding opaque roots are not visited by minor collections.
+    if (collectionType == MinorCollection) {
+        m_handleHeap.markAllWeakHandles(heapRootMarker);
+        markStack.drain();
+        markStack.reset();
+        m_operationInProgress = NoOperation;
+        return;
+    }
+#endif
+
     // Weak handles must be marked last, because their owners use the set of
     // opaque roots to determine reachability.
     int lastOpaqueRootCount;
@@ -271,14 +402,28 @@ size_t Heap::objectCount() const
     return m_markedSpace.objectCount();
 }
 
+Heap::PhaseTimes Heap::lastCollectionPhaseTimes() const
+{
+    PhaseTimes times = m_lastPhaseTimes;
+    times.sweep = m_markedSpace.sweepTime() - m_sweepTimeBeforeLastCollection;
+    return times;
+}
+
+Heap::PhaseTimes Heap::totalPhaseTimes() const
+{
+    PhaseTimes times = m_totalPhaseTimes;
+    times.sweep = m_markedSpace.sweepTime();
+    return times;
+}
+
 size_t Heap::size() const
 {
-    return m_markedSpace.size();
+    return m_markedSpace.size() + m_largeObjectSpace.size();
 }
 
 size_t Heap::capacity() const
 {
-    return m_markedSpace.capacity();
+    return m_markedSpace.capacity() + m_largeObjectSpace.size();
 }
 
 size_t Heap::globalObjectCount()
@@ -381,39 +526,175 @@ bool Heap::isBusy()
     return m_operationInProgress != NoOperation;
 }
 
+void Heap::setNumberOfMarkingHelperThreads(unsigned count)
+{
+    ASSERT(m_operationInProgress == NoOperation);
+#if ENABLE(PARALLEL_GC)
+    m_sharedData.setNumberOfHelperThreads(count);
+#else
+    UNUSED_PARAM(count);
+#endif
+}
+
+bool Heap::setYoungGenerationEnabled(bool enabled)
+{
+    ASSERT(m_operationInProgress == NoOperation);
+#if ENABLE(GGC)
+    if (enabled == m_youngGenerationEnabled)
+        return true;
+
+    // The old generation is built by the next full collection. Until then,
+    // and while the mode is disabled, no cell is old and the write barrier
+    // doesn't remember anything.
+    m_youngGenerationEnabled = enabled;
+    m_hasOldGeneration = false;
+    m_markedSpace.clearOldGeneration();
+    m_rememberedSet.clear();
+    return true;
+#else
+    return !enabled;
+#endif
+}
+
+#if ENABLE(GGC)
+void writeBarrierSlowCase(JSGlobalData& globalData, const JSCell* owner)
+{
+    globalData.heap.addToRememberedSet(owner);
+}
+#endif
+
 void Heap::collectAllGarbage()
 {
     reset(DoSweep);
 }
 
+bool Heap::sweepIncrementally(double timeLimit)
+{
+    ASSERT(JSLock::currentThreadIsHoldingLock() || !m_globalData->isSharedInstance());
+    ASSERT(m_operationInProgress == NoOperation);
+    return m_markedSpace.sweepIncrementally(timeLimit);
+}
+
+Heap::CollectionType Heap::collectionTypeFor(SweepToggle sweepToggle)
+{
+#if ENABLE(GGC)
+    // Explicit collections are always full, they are expected to free as
+    // much as possible.
+    if (!m_youngGenerationEnabled || !m_hasOldGeneration || sweepToggle == DoSweep)
+        return FullCollection;
+    if (m_minorCollectionsSinceFullCollection >= maxMinorCollections)
+        return FullCollection;
+    // Dead old cells are only freed by full collections.
+    if (m_sizeAfterLastCollection > oldGenerationGrowthFactor * m_sizeAfterFullCollection)
+        return FullCollection;
+    return MinorCollection;
+#else
+    UNUSED_PARAM(sweepToggle);
+    return FullCollection;
+#endif
+}
+
 void Heap::reset(SweepToggle sweepToggle)
 {
     ASSERT(globalData()->identifierTable == wtfThreadData().currentIdentifierTable());
     JAVASCRIPTCORE_GC_BEGIN();
 
-    markRoots();
+    double collectionStart = currentTime();
+    CollectionType collectionType = collectionTypeFor(sweepToggle);
+
+    // Blocks left unswept by the previous collection don't need to be swept
+    // anymore, allocation destroys the dead cells it reuses.
+    m_markedSpace.cancelSweep();
+    m_sweepTimeBeforeLastCollection = m_markedSpace.sweepTime();
+
+#if ENABLE(JIT)
+    // The cache points at cells without keeping them alive.
+    m_globalData->jitStubs->megamorphicCache().clear();
+#endif
+
+    double start = currentTime();
+    markRoots(collectionType);
     m_handleHeap.finalizeWeakHandles();
+    JSString::releaseSubstringBuffers(*m_globalData);
+#if ENABLE(GGC)
+    // Survivors become old where they are. No old cell can point to a young
+    // one after that, the remembered set starts over.
+    if (m_youngGenerationEnabled) {
+        if (collectionType == MinorCollection)
+            m_markedSpace.promoteNursery();
+        else
+            m_markedSpace.promoteAll();
+        m_hasOldGeneration = true;
+        m_rememberedSet.clear();
+    }
+#endif
+    m_lastPhaseTimes.mark = currentTime() - start;
 
     JAVASCRIPTCORE_GC_MARKED();
 
     m_markedSpace.reset();
     m_extraCost = 0;
+    m_largeObjectSpace.didCollect();
 
 #if ENABLE(JSC_ZOMBIES)
     sweepToggle = DoSweep;
 #endif
 
+    m_lastPhaseTimes.shrink = 0;
     if (sweepToggle == DoSweep) {
+#if ENABLE(JSC_ZOMBIES)
+        // Zombies are created when sweeping, they can't wait.
         m_markedSpace.sweep();
+#endif
+        start = currentTime();
         m_markedSpace.shrink();
+        m_lastPhaseTimes.shrink = currentTime() - start;
+
+#if !ENABLE(JSC_ZOMBIES)
+        // Empty blocks were destroyed by shrink(), the others are swept
+        // lazily, outside of the collection pause.
+        m_markedSpace.scheduleSweep();
+#endif
     }
 
+    m_totalPhaseTimes.mark += m_lastPhaseTimes.mark;
+    m_totalPhaseTimes.shrink += m_lastPhaseTimes.shrink;
+
     // To avoid pathological GC churn in large heaps, we set the allocation high
     // water mark to be proportional to the current size of the heap. The exact
     // proportion is a bit arbitrary. A 2X multiplier gives a 1:1 (heap size :
     // new bytes allocated) proportion, and seems to work well in benchmarks.
-    size_t proportionalBytes = 2 * m_markedSpace.size();
+    size_t size = m_markedSpace.size();
+    size_t proportionalBytes = 2 * size;
     m_markedSpace.setHighWaterMark(max(proportionalBytes, minBytesPerCycle));
+    // The stores of the cells found dead are still counted until they are
+    // swept, this errs on the side of collecting less often.
+    m_largeObjectSpace.setHighWaterMark(max(m_largeObjectSpace.size(), minBytesPerCycle));
+
+#if ENABLE(GGC)
+    if (m_youngGenerationEnabled) {
+        // Keep the nursery small so minor collections stay short, the growth
+        // of the old generation triggers the full collections.
+        m_markedSpace.setHighWaterMark(m_markedSpace.capacity() + youngGenerationBytes);
+        m_sizeAfterLastCollection = size;
+        if (collectionType == FullCollection) {
+            m_sizeAfterFullCollection = max(size, minBytesPerCycle);
+            m_minorCollectionsSinceFullCollection = 0;
+        } else
+            m_minorCollectionsSinceFullCollection++;
+    }
+#endif
+
+    double pause = currentTime() - collectionStart;
+    if (collectionType == MinorCollection) {
+        m_collectionStatistics.minorCollections++;
+        m_collectionStatistics.minorPauseTime += pause;
+        m_collectionStatistics.maxMinorPause = max(m_collectionStatistics.maxMinorPause, pause);
+    } else {
+        m_collectionStatistics.fullCollections++;
+        m_collectionStatistics.fullPauseTime += pause;
+        m_collectionStatistics.maxFullPause = max(m_collectionStatistics.maxFullPause, pause);
+    }
 
     JAVASCRIPTCORE_GC_END();
 
@@ -24,6 +24,7 @@
 
 #include "HandleHeap.h"
 #include "HandleStack.h"
+#include "LargeObjectSpace.h"
 #include "MarkStack.h"
 #include "MarkedSpace.h"
 #include <wtf/Forward.h>
@@ -54,11 +55,39 @@ namespace JSC {
     class Heap {
         WTF_MAKE_NONCOPYABLE(Heap);
     public:
+        // Time spent in each phase of garbage collection, in seconds.
+        struct PhaseTimes {
+            PhaseTimes() : mark(0), sweep(0), shrink(0) { }
+            double mark;
+            double sweep;
+            double shrink;
+        };
+
+        // Number of collections of each kind and their pause times, in
+        // seconds. Lazy sweeping isn't part of the pauses.
+        struct CollectionStatistics {
+            CollectionStatistics()
+                : minorCollections(0), fullCollections(0)
+                , minorPauseTime(0), fullPauseTime(0)
+                , maxMinorPause(0), maxFullPause(0)
+            {
+            }
+            size_t minorCollections;
+            size_t fullCollections;
+            double minorPauseTime;
+            double fullPauseTime;
+            double maxMinorPause;
+            double maxFullPause;
+        };
+
         static Heap* heap(JSValue); // 0 for immediate values
         static Heap* heap(JSCell*);
 
         static bool isMarked(const JSCell*);
         static bool testAndSetMarked(const JSCell*);
+#if ENABLE(PARALLEL_GC)
+        static bool concurrentTestAndSetMarked(const JSCell*);
+#endif
         static void setMarked(JSCell*);
         
         Heap(JSGlobalData*);
@@ -73,11 +102,45 @@ namespace JSC {
         void setActivityCallback(PassOwnPtr<GCActivityCallback>);
 
         bool isBusy(); // true if an allocation or collection is in progress
+        // Number of threads helping the collecting thread mark the heap, 0 disables parallel marking
+        void setNumberOfMarkingHelperThreads(unsigned);
         void* allocate(size_t);
         void collectAllGarbage();
+        // Sweeps the blocks left by the last full collection for up to
+        // timeLimit seconds, returns true if there is more to sweep.
+        bool sweepIncrementally(double timeLimit);
+        bool hasPendingSweep() const { return m_markedSpace.hasPendingSweep(); }
+
+        // In the young generation mode, collections triggered by allocation
+        // only mark the cells allocated since the previous collection and
+        // the old cells the write barrier remembered. Returns false if the
+        // mode isn't available, see ENABLE(GGC).
+        bool setYoungGenerationEnabled(bool);
+        bool isYoungGenerationEnabled() const { return m_youngGenerationEnabled; }
+#if ENABLE(GGC)
+        void addToRememberedSet(const JSCell*);
+#endif
 
         void reportExtraMemoryCost(size_t cost);
 
+        // Backing stores of cells. Large ones come from the large object
+        // space, the others from fastMalloc. Allocating never collects,
+        // reportStorageCost() must be called once the store is in use.
+        // allocateStorage() crashes on failure, the try versions return 0.
+        void* allocateStorage(size_t);
+        void* tryAllocateStorage(size_t);
+        // usedSize is the number of bytes to keep if the store moves.
+        void* tryReallocateStorage(void*, size_t usedSize, size_t newSize);
+        // Gives the unused end of a large store back to the OS.
+        void shrinkStorage(void*, size_t usedSize);
+        void freeStorage(void*);
+        // Large stores are accounted exactly, and collect when the large
+        // object space grew as much as it was after the last collection. The
+        // cost of smaller ones is counted as extra memory cost. The store is
+        // reported while its cell is being mutated, so this never collects,
+        // the next cell allocation needing a new block does.
+        void reportStorageCost(size_t storageSize, size_t cost);
+
         void protect(JSValue);
         bool unprotect(JSValue); // True when the protect count drops to 0.
 
@@ -86,6 +149,13 @@ namespace JSC {
         size_t size() const;
         size_t capacity() const;
         size_t objectCount() const;
+        // Bytes committed for large backing stores, part of size()
+        size_t largeObjectSize() const { return m_largeObjectSpace.size(); }
+        // Sweeping is lazy, its time is counted for the last collection
+        // until the next one starts.
+        PhaseTimes lastCollectionPhaseTimes() const;
+        PhaseTimes totalPhaseTimes() const;
+        const CollectionStatistics& collectionStatistics() const { return m_collectionStatistics; }
         size_t globalObjectCount();
         size_t protectedObjectCount();
         size_t protectedGlobalObjectCount();
@@ -112,18 +182,22 @@ namespace JSC {
 
         void* allocateSlowCase(size_t);
         void reportExtraMemoryCostSlowCase(size_t);
+        void collectLargeObjects();
 
-        void markRoots();
+        enum CollectionType { FullCollection, MinorCollection };
+        void markRoots(CollectionType);
         void markProtectedObjects(HeapRootMarker&);
         void markTempSortVectors(HeapRootMarker&);
 
         enum SweepToggle { DoNotSweep, DoSweep };
+        CollectionType collectionTypeFor(SweepToggle);
         void reset(SweepToggle);
 
         RegisterFile& registerFile();
 
         OperationInProgress m_operationInProgress;
         MarkedSpace m_markedSpace;
+        LargeObjectSpace m_largeObjectSpace;
 
         ProtectCountSet m_protectedValues;
         Vector<Vector<ValueStringPair>* > m_tempSortingVectors;
@@ -135,11 +209,28 @@ namespace JSC {
         JSGlobalData* m_globalData;
         
         MachineThreads m_machineThreads;
+#if ENABLE(PARALLEL_GC)
+        MarkStackThreadSharedData m_sharedData;
+#endif
         MarkStack m_markStack;
         HandleHeap m_handleHeap;
         HandleStack m_handleStack;
 
         size_t m_extraCost;
+
+        PhaseTimes m_lastPhaseTimes;
+        PhaseTimes m_totalPhaseTimes;
+        double m_sweepTimeBeforeLastCollection;
+        CollectionStatistics m_collectionStatistics;
+
+        bool m_youngGenerationEnabled;
+#if ENABLE(GGC)
+        bool m_hasOldGeneration;
+        size_t m_minorCollectionsSinceFullCollection;
+        size_t m_sizeAfterLastCollection;
+        size_t m_sizeAfterFullCollection;
+        HashSet<JSCell*> m_rememberedSet;
+#endif
     };
 
     inline bool Heap::isMarked(const JSCell* cell)
@@ -152,11 +243,25 @@ namespace JSC {
         return MarkedSpace::testAndSetMarked(cell);
     }
 
+#if ENABLE(PARALLEL_GC)
+    inline bool Heap::concurrentTestAndSetMarked(const JSCell* cell)
+    {
+        return MarkedSpace::concurrentTestAndSetMarked(cell);
+    }
+#endif
+
     inline void Heap::setMarked(JSCell* cell)
     {
         MarkedSpace::setMarked(cell);
     }
 
+#if ENABLE(GGC)
+    inline void Heap::addToRememberedSet(const JSCell* cell)
+    {
+        m_rememberedSet.add(const_cast<JSCell*>(cell));
+    }
+#endif
+
     inline bool Heap::contains(void* p)
     {
         return m_markedSpace.contains(p);
@@ -168,6 +273,15 @@ namespace JSC {
             reportExtraMemoryCostSlowCase(cost);
     }
 
+    inline void Heap::reportStorageCost(size_t storageSize, size_t cost)
+    {
+        if (storageSize < LargeObjectSpace::minimumAllocationSize)
+            m_extraCost += cost;
+        if (m_largeObjectSpace.bytesAllocatedSinceCollection() > m_largeObjectSpace.highWaterMark()
+            || (m_extraCost > maxExtraCost && m_extraCost > m_markedSpace.highWaterMark() / 2))
+            m_markedSpace.setHighWaterMark(0);
+    }
+
     template <typename Functor> inline void Heap::forEach(Functor& functor)
     {
         m_markedSpace.forEach(functor);
@@ -0,0 +1,135 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "LargeObjectSpace.h"
+
+#include <algorithm>
+#include <limits>
+#include <wtf/OSAllocator.h>
+#include <wtf/PageBlock.h>
+#include <wtf/StdLibExtras.h>
+
+namespace JSC {
+
+// Stores are given twice the space they ask for in address space, so that
+// arrays growing by small steps are not copied every time.
+static const size_t reservationFactor = 2;
+
+static inline size_t roundUpToPageSize(size_t bytes)
+{
+    return (bytes + pageSize() - 1) & ~(pageSize() - 1);
+}
+
+LargeObjectSpace::LargeObjectSpace()
+    : m_size(0)
+    , m_bytesAllocatedSinceCollection(0)
+    , m_highWaterMark(0)
+{
+}
+
+void LargeObjectSpace::destroy()
+{
+    // The cells owning the stores free them when they are destroyed.
+    ASSERT(m_allocations.isEmpty());
+    HashMap<void*, Allocation>::iterator end = m_allocations.end();
+    for (HashMap<void*, Allocation>::iterator it = m_allocations.begin(); it != end; ++it)
+        OSAllocator::decommitAndRelease(it->first, it->second.reservedSize, it->first, it->second.committedSize);
+    m_allocations.clear();
+    m_size = 0;
+}
+
+void* LargeObjectSpace::tryAllocate(size_t bytes)
+{
+    if (bytes > std::numeric_limits<size_t>::max() / reservationFactor - pageSize())
+        return 0;
+    size_t committedSize = roundUpToPageSize(bytes);
+    size_t reservedSize = roundUpToPageSize(bytes * reservationFactor);
+    void* base = OSAllocator::tryReserveUncommitted(reservedSize, OSAllocator::JSGCHeapPages);
+    if (!base)
+        return 0;
+    if (!OSAllocator::tryCommit(base, committedSize, true, false)) {
+        OSAllocator::releaseDecommitted(base, reservedSize);
+        return 0;
+    }
+
+    m_allocations.set(base, Allocation(reservedSize, committedSize));
+    m_size += committedSize;
+    m_bytesAllocatedSinceCollection += committedSize;
+    return base;
+}
+
+bool LargeObjectSpace::commit(void* base, Allocation& allocation, size_t bytes)
+{
+    size_t committedSize = roundUpToPageSize(bytes);
+    ASSERT(committedSize <= allocation.reservedSize);
+    char* start = static_cast<char*>(base);
+    if (committedSize > allocation.committedSize) {
+        size_t grownSize = committedSize - allocation.committedSize;
+        if (!OSAllocator::tryCommit(start + allocation.committedSize, grownSize, true, false))
+            return false;
+        m_size += grownSize;
+        m_bytesAllocatedSinceCollection += grownSize;
+    } else if (committedSize < allocation.committedSize) {
+        size_t shrunkSize = allocation.committedSize - committedSize;
+        OSAllocator::decommit(start + committedSize, shrunkSize);
+        m_size -= shrunkSize;
+    }
+    allocation.committedSize = committedSize;
+    return true;
+}
+
+void* LargeObjectSpace::tryReallocate(void* base, size_t usedSize, size_t newSize)
+{
+    HashMap<void*, Allocation>::iterator it = m_allocations.find(base);
+    ASSERT(it != m_allocations.end());
+    if (newSize <= it->second.reservedSize)
+        return commit(base, it->second, newSize) ? base : 0;
+
+    void* newBase = tryAllocate(newSize);
+    if (!newBase)
+        return 0;
+    memcpy(newBase, base, std::min(usedSize, newSize));
+    deallocate(base);
+    return newBase;
+}
+
+void LargeObjectSpace::shrink(void* base, size_t usedSize)
+{
+    HashMap<void*, Allocation>::iterator it = m_allocations.find(base);
+    ASSERT(it != m_allocations.end());
+    if (roundUpToPageSize(usedSize) < it->second.committedSize)
+        commit(base, it->second, usedSize);
+}
+
+void LargeObjectSpace::deallocate(void* base)
+{
+    Allocation allocation = m_allocations.take(base);
+    ASSERT(allocation.reservedSize);
+    OSAllocator::decommitAndRelease(base, allocation.reservedSize, base, allocation.committedSize);
+    m_size -= allocation.committedSize;
+}
+
+} // namespace JSC
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LargeObjectSpace_h
+#define LargeObjectSpace_h
+
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+
+namespace JSC {
+
+    // Backing stores too large for fastMalloc to be a good fit are allocated
+    // directly from the OS, each in its own page aligned region. The space
+    // keeps the exact number of bytes committed for them, so that the heap
+    // can collect based on the memory they really use, and gives their pages
+    // back to the OS as soon as they are deallocated or shrunk.
+    class LargeObjectSpace {
+        WTF_MAKE_NONCOPYABLE(LargeObjectSpace);
+    public:
+        // Stores smaller than this should come from fastMalloc.
+        static const size_t minimumAllocationSize = 32 * 1024;
+
+        LargeObjectSpace();
+        void destroy();
+
+        // Returns 0 when the OS is out of address space or memory.
+        void* tryAllocate(size_t);
+        // Grows or shrinks the allocation in place when its reservation
+        // allows it, otherwise moves the first usedSize bytes. Returns 0 and
+        // leaves the allocation untouched on failure.
+        void* tryReallocate(void*, size_t usedSize, size_t newSize);
+        // Decommits the pages after the first usedSize bytes.
+        void shrink(void*, size_t usedSize);
+        void deallocate(void*);
+
+        bool contains(void* p) const { return m_allocations.contains(p); }
+
+        // Committed bytes
+        size_t size() const { return m_size; }
+        size_t bytesAllocatedSinceCollection() const { return m_bytesAllocatedSinceCollection; }
+
+        size_t highWaterMark() const { return m_highWaterMark; }
+        void setHighWaterMark(size_t highWaterMark) { m_highWaterMark = highWaterMark; }
+        void didCollect() { m_bytesAllocatedSinceCollection = 0; }
+
+    private:
+        struct Allocation {
+            Allocation() : reservedSize(0), committedSize(0) { }
+            Allocation(size_t reserved, size_t committed) : reservedSize(reserved), committedSize(committed) { }
+            size_t reservedSize;
+            size_t committedSize;
+        };
+
+        bool commit(void*, Allocation&, size_t);
+
+        HashMap<void*, Allocation> m_allocations;
+        size_t m_size;
+        size_t m_bytesAllocatedSinceCollection;
+        size_t m_highWaterMark;
+    };
+
+} // namespace JSC
+
+#endif // LargeObjectSpace_h
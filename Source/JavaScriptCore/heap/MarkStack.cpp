@@ -33,9 +33,126 @@
 #include "JSObject.h"
 #include "ScopeChain.h"
 #include "Structure.h"
+#include <algorithm>
 
 namespace JSC {
 
+#if ENABLE(PARALLEL_GC)
+// A marking thread looks at donating cells to the shared pool every
+// donationInterval cells, and only if it has more than
+// minimumCellsToDonate cells waiting.
+static const unsigned donationInterval = 64;
+static const size_t minimumCellsToDonate = 128;
+
+// Conservative root scans smaller than this number of elements per thread
+// are not worth splitting.
+static const size_t minimumElementsPerRootScanSlice = 4096;
+
+MarkStackThreadSharedData::MarkStackThreadSharedData(Heap* heap, void* jsArrayVPtr)
+    : m_heap(heap)
+    , m_jsArrayVPtr(jsArrayVPtr)
+    , m_numberOfActiveMarkers(0)
+    , m_parallelMarkersShouldExit(false)
+    , m_rootScanner(0)
+    , m_rootScanResult(0)
+    , m_nextRootScanSlice(0)
+    , m_rootScanEnd(0)
+    , m_rootScanSliceSize(0)
+    , m_pendingRootScanSlices(0)
+{
+}
+
+MarkStackThreadSharedData::~MarkStackThreadSharedData()
+{
+    setNumberOfHelperThreads(0);
+}
+
+void MarkStackThreadSharedData::setNumberOfHelperThreads(unsigned count)
+{
+    if (count == m_markingThreads.size())
+        return;
+
+    if (!m_markingThreads.isEmpty()) {
+        {
+            MutexLocker locker(m_markingLock);
+            m_parallelMarkersShouldExit = true;
+            m_markingCondition.broadcast();
+        }
+        for (unsigned i = 0; i < m_markingThreads.size(); ++i)
+            waitForThreadCompletion(m_markingThreads[i], 0);
+        m_markingThreads.clear();
+        m_parallelMarkersShouldExit = false;
+    }
+
+    for (unsigned i = 0; i < count; ++i) {
+        ThreadIdentifier thread = createThread(markingThreadStartFunc, this, "JavaScriptCore::Marking");
+        if (!thread)
+            break;
+        m_markingThreads.append(thread);
+    }
+}
+
+void* MarkStackThreadSharedData::markingThreadStartFunc(void* shared)
+{
+    static_cast<MarkStackThreadSharedData*>(shared)->markingThreadMain();
+    return 0;
+}
+
+void MarkStackThreadSharedData::markingThreadMain()
+{
+    MarkStack markStack(m_jsArrayVPtr, this);
+    markStack.m_isInParallelMode = true;
+    markStack.drainFromShared(MarkStack::HelperDrain);
+}
+
+void MarkStackThreadSharedData::gatherConservativeRoots(ConservativeRoots& roots, ConservativeRootScanner scanner, void* begin, void* end, size_t elementSize)
+{
+    size_t elementCount = (static_cast<char*>(end) - static_cast<char*>(begin)) / elementSize;
+    size_t sliceCount = std::min<size_t>(m_markingThreads.size() + 1, elementCount / minimumElementsPerRootScanSlice);
+    if (sliceCount < 2) {
+        scanner(roots, begin, end);
+        return;
+    }
+
+    MutexLocker locker(m_markingLock);
+    m_rootScanner = scanner;
+    m_rootScanResult = &roots;
+    m_nextRootScanSlice = static_cast<char*>(begin);
+    m_rootScanEnd = static_cast<char*>(end);
+    m_rootScanSliceSize = (elementCount + sliceCount - 1) / sliceCount * elementSize;
+    m_pendingRootScanSlices = sliceCount;
+    m_markingCondition.broadcast();
+
+    while (hasRootScanSlice())
+        runRootScanSlice();
+    while (m_pendingRootScanSlices)
+        m_markingCondition.wait(m_markingLock);
+
+    m_rootScanner = 0;
+    m_rootScanResult = 0;
+}
+
+void MarkStackThreadSharedData::runRootScanSlice()
+{
+    // NOTE: must be called with m_markingLock held, it is released while
+    // the slice is scanned.
+    ASSERT(hasRootScanSlice());
+    char* begin = m_nextRootScanSlice;
+    char* end = std::min(begin + m_rootScanSliceSize, m_rootScanEnd);
+    m_nextRootScanSlice = end;
+    ConservativeRootScanner scanner = m_rootScanner;
+
+    ConservativeRoots sliceRoots(m_heap);
+    m_markingLock.unlock();
+    scanner(sliceRoots, begin, end);
+    m_markingLock.lock();
+
+    m_rootScanResult->add(sliceRoots);
+    if (!--m_pendingRootScanSlices)
+        m_markingCondition.broadcast();
+}
+#endif
+
 size_t MarkStack::s_pageSize = 0;
 
 void MarkStack::reset()
@@ -54,6 +171,12 @@ void MarkStack::append(ConservativeRoots& conservativeRoots)
         internalAppend(roots[i]);
 }
 
+void MarkStack::appendChildren(JSCell* cell)
+{
+    ASSERT(Heap::isMarked(cell));
+    m_values.append(cell);
+}
+
 inline void MarkStack::markChildren(JSCell* cell)
 {
     ASSERT(Heap::isMarked(cell));
@@ -84,9 +207,35 @@ inline void MarkStack::markChildren(JSCell* cell)
 
 void MarkStack::drain()
 {
+#if ENABLE(PARALLEL_GC)
+    if (m_shared && m_shared->numberOfHelperThreads()) {
+        ASSERT(!m_isInParallelMode);
+        m_isInParallelMode = true;
+        donateCells();
+        drainLocal();
+        drainFromShared(MasterDrain);
+        m_isInParallelMode = false;
+
+        // The helpers are all idle now, take the opaque roots they found.
+        MutexLocker locker(m_shared->m_opaqueRootsLock);
+        HashSet<void*>::iterator end = m_shared->m_opaqueRoots.end();
+        for (HashSet<void*>::iterator it = m_shared->m_opaqueRoots.begin(); it != end; ++it)
+            m_opaqueRoots.add(*it);
+        m_shared->m_opaqueRoots.clear();
+        return;
+    }
+#endif
+    drainLocal();
+}
+
+void MarkStack::drainLocal()
+{
 #if !ASSERT_DISABLED
     ASSERT(!m_isDraining);
     m_isDraining = true;
+#endif
+#if ENABLE(PARALLEL_GC)
+    unsigned cellsSinceDonation = 0;
 #endif
     while (!m_markSets.isEmpty() || !m_values.isEmpty()) {
         while (!m_markSets.isEmpty() && m_values.size() < 50) {
@@ -102,7 +251,7 @@ void MarkStack::drain()
             current.m_values++;
 
             JSCell* cell;
-            if (!value || !value.isCell() || Heap::testAndSetMarked(cell = value.asCell())) {
+            if (!value || !value.isCell() || testAndSetMarked(cell = value.asCell())) {
                 if (current.m_values == end) {
                     m_markSets.removeLast();
                     continue;
@@ -124,12 +273,112 @@ void MarkStack::drain()
 
             markChildren(cell);
         }
-        while (!m_values.isEmpty())
+        while (!m_values.isEmpty()) {
             markChildren(m_values.removeLast());
+#if ENABLE(PARALLEL_GC)
+            if (m_isInParallelMode && ++cellsSinceDonation == donationInterval) {
+                cellsSinceDonation = 0;
+                donateCells();
+            }
+#endif
+        }
     }
 #if !ASSERT_DISABLED
     m_isDraining = false;
 #endif
 }
 
+#if ENABLE(PARALLEL_GC)
+void MarkStack::donateCells()
+{
+    if (m_values.size() < minimumCellsToDonate)
+        return;
+
+    // Don't wait for the lock, the cells will be donated next time.
+    if (!m_shared->m_markingLock.tryLock())
+        return;
+
+    // Only feed the pool when it is running dry, so that cells don't bounce
+    // between the threads.
+    if (m_shared->m_sharedCells.size() < minimumCellsToDonate) {
+        size_t count = m_values.size() / 2;
+        while (count--)
+            m_shared->m_sharedCells.append(m_values.removeLast());
+        m_shared->m_markingCondition.broadcast();
+    }
+    m_shared->m_markingLock.unlock();
+}
+
+void MarkStack::stealCells()
+{
+    // NOTE: must be called with m_markingLock held
+    Vector<JSCell*>& sharedCells = m_shared->m_sharedCells;
+    size_t count = std::max<size_t>(1, sharedCells.size() / (m_shared->m_markingThreads.size() + 1));
+    count = std::min(count, sharedCells.size());
+    while (count--) {
+        m_values.append(sharedCells.last());
+        sharedCells.removeLast();
+    }
+}
+
+void MarkStack::mergeOpaqueRoots()
+{
+    if (m_opaqueRoots.isEmpty())
+        return;
+
+    MutexLocker locker(m_shared->m_opaqueRootsLock);
+    HashSet<void*>::iterator end = m_opaqueRoots.end();
+    for (HashSet<void*>::iterator it = m_opaqueRoots.begin(); it != end; ++it)
+        m_shared->m_opaqueRoots.add(*it);
+    m_opaqueRoots.clear();
+}
+
+void MarkStack::drainFromShared(SharedDrainMode mode)
+{
+    ASSERT(m_isInParallelMode);
+    {
+        MutexLocker locker(m_shared->m_markingLock);
+        m_shared->m_numberOfActiveMarkers++;
+    }
+    while (true) {
+        {
+            MutexLocker locker(m_shared->m_markingLock);
+            m_shared->m_numberOfActiveMarkers--;
+
+            if (mode == MasterDrain) {
+                // Wait for cells to steal, or for every thread to be done.
+                while (m_shared->m_sharedCells.isEmpty()) {
+                    if (!m_shared->m_numberOfActiveMarkers)
+                        return;
+                    m_shared->m_markingCondition.wait(m_shared->m_markingLock);
+                }
+            } else {
+                // Let the collecting thread know if marking is over.
+                if (!m_shared->m_numberOfActiveMarkers && m_shared->m_sharedCells.isEmpty())
+                    m_shared->m_markingCondition.broadcast();
+
+                while (m_shared->m_sharedCells.isEmpty()) {
+                    if (m_shared->m_parallelMarkersShouldExit)
+                        return;
+                    if (m_shared->hasRootScanSlice())
+                        m_shared->runRootScanSlice();
+                    else
+                        m_shared->m_markingCondition.wait(m_shared->m_markingLock);
+                }
+            }
+
+            stealCells();
+            m_shared->m_numberOfActiveMarkers++;
+        }
+
+        drainLocal();
+
+        // The opaque roots must be handed over before this thread becomes
+        // inactive, the collecting thread reads them once everyone is.
+        if (mode == HelperDrain)
+            mergeOpaqueRoots();
+    }
+}
+#endif
+
 } // namespace JSC
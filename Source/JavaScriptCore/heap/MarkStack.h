@@ -33,20 +33,84 @@
 #include <wtf/Vector.h>
 #include <wtf/Noncopyable.h>
 #include <wtf/OSAllocator.h>
+#if ENABLE(PARALLEL_GC)
+#include <wtf/Threading.h>
+#endif
 
 namespace JSC {
 
     class ConservativeRoots;
+    class Heap;
     class JSGlobalData;
+    class MarkStackThreadSharedData;
     class Register;
     
     enum MarkSetProperties { MayContainNullValues, NoNullValues };
-    
+
+#if ENABLE(PARALLEL_GC)
+    // Adds the roots found in [begin, end) to a ConservativeRoots.
+    typedef void (*ConservativeRootScanner)(ConservativeRoots&, void* begin, void* end);
+
+    // State shared by the collecting thread and the helper threads marking in
+    // parallel with it. Each thread drains its own MarkStack; a thread with
+    // plenty of cells left to visit donates some of them to the shared pool,
+    // and threads running out of work steal from it. Marking is over when
+    // the pool is empty and no thread is active anymore.
+    class MarkStackThreadSharedData {
+        WTF_MAKE_NONCOPYABLE(MarkStackThreadSharedData);
+    public:
+        MarkStackThreadSharedData(Heap*, void* jsArrayVPtr);
+        ~MarkStackThreadSharedData();
+
+        // Must not be called while a collection is in progress.
+        void setNumberOfHelperThreads(unsigned);
+        unsigned numberOfHelperThreads() const { return m_markingThreads.size(); }
+
+        // Splits the scan of [begin, end) between the collecting thread and
+        // the helpers. Slices are multiples of elementSize.
+        void gatherConservativeRoots(ConservativeRoots&, ConservativeRootScanner, void* begin, void* end, size_t elementSize);
+
+    private:
+        friend class MarkStack;
+
+        static void* markingThreadStartFunc(void*);
+        void markingThreadMain();
+
+        bool hasRootScanSlice() const { return m_rootScanner && m_nextRootScanSlice < m_rootScanEnd; }
+        void runRootScanSlice();
+
+        Heap* m_heap;
+        void* m_jsArrayVPtr;
+
+        Mutex m_markingLock;
+        ThreadCondition m_markingCondition;
+        Vector<JSCell*> m_sharedCells;
+        unsigned m_numberOfActiveMarkers;
+        bool m_parallelMarkersShouldExit;
+        Vector<ThreadIdentifier> m_markingThreads;
+
+        // Conservative root scan being split between the threads
+        ConservativeRootScanner m_rootScanner;
+        ConservativeRoots* m_rootScanResult;
+        char* m_nextRootScanSlice;
+        char* m_rootScanEnd;
+        size_t m_rootScanSliceSize;
+        unsigned m_pendingRootScanSlices;
+
+        // Opaque roots found by the helpers, merged into the collecting
+        // thread's MarkStack at the end of each drain.
+        Mutex m_opaqueRootsLock;
+        HashSet<void*> m_opaqueRoots;
+    };
+#endif
+
     class MarkStack {
         WTF_MAKE_NONCOPYABLE(MarkStack);
     public:
-        MarkStack(void* jsArrayVPtr)
+        MarkStack(void* jsArrayVPtr, MarkStackThreadSharedData* shared = 0)
             : m_jsArrayVPtr(jsArrayVPtr)
+            , m_shared(shared)
+            , m_isInParallelMode(false)
 #if !ASSERT_DISABLED
             , m_isCheckingForDefaultMarkViolation(false)
             , m_isDraining(false)
@@ -71,6 +135,9 @@ namespace JSC {
         }
         
         void append(ConservativeRoots&);
+        // Visits the children of a cell that is already marked, used for the
+        // old cells remembered by the write barrier.
+        void appendChildren(JSCell*);
 
         bool addOpaqueRoot(void* root) { return m_opaqueRoots.add(root).second; }
         bool containsOpaqueRoot(void* root) { return m_opaqueRoots.contains(root); }
@@ -81,10 +148,23 @@ namespace JSC {
 
     private:
         friend class HeapRootMarker; // Allowed to mark a JSValue* or JSCell** directly.
+#if ENABLE(PARALLEL_GC)
+        friend class MarkStackThreadSharedData;
+
+        enum SharedDrainMode { MasterDrain, HelperDrain };
+        void drainFromShared(SharedDrainMode);
+        void donateCells();
+        void stealCells();
+        void mergeOpaqueRoots();
+#endif
+        void drainLocal();
+
         void append(JSValue*);
         void append(JSValue*, size_t count);
         void append(JSCell**);
 
+        // Marks the cell, returning whether it already was marked.
+        bool testAndSetMarked(JSCell*);
         void internalAppend(JSCell*);
         void internalAppend(JSValue);
         void markChildren(JSCell*);
@@ -190,6 +270,8 @@ namespace JSC {
         };
 
         void* m_jsArrayVPtr;
+        MarkStackThreadSharedData* m_shared;
+        bool m_isInParallelMode;
         MarkStackArray<MarkSet> m_markSets;
         MarkStackArray<JSCell*> m_values;
         static size_t s_pageSize;
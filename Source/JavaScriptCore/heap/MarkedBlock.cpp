@@ -50,6 +50,7 @@ void MarkedBlock::destroy(MarkedBlock* block)
 
 MarkedBlock::MarkedBlock(const PageAllocationAligned& allocation, JSGlobalData* globalData, size_t cellSize)
     : m_nextAtom(firstAtom())
+    , m_needsSweep(false)
     , m_allocation(allocation)
     , m_heap(&globalData->heap)
     , m_prev(0)
@@ -66,6 +67,7 @@ MarkedBlock::MarkedBlock(const PageAllocationAligned& allocation, JSGlobalData*
 void MarkedBlock::sweep()
 {
     Structure* dummyMarkableCellStructure = m_heap->globalData()->dummyMarkableCellStructure.get();
+    m_needsSweep = false;
 
     for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
         if (m_marks.get(i))
@@ -57,6 +57,11 @@ namespace JSC {
         void* allocate();
         void reset();
         void sweep();
+
+        // Set when the block has been marked but its dead cells were not
+        // destroyed yet, see MarkedSpace::scheduleSweep().
+        bool needsSweep() const;
+        void setNeedsSweep(bool);
         
         bool isEmpty();
 
@@ -72,7 +77,22 @@ namespace JSC {
         size_t atomNumber(const void*);
         bool isMarked(const void*);
         bool testAndSetMarked(const void*);
+#if ENABLE(PARALLEL_GC)
+        bool concurrentTestAndSetMarked(const void*);
+#endif
         void setMarked(const void*);
+
+#if ENABLE(GGC)
+        // The old generation is the set of cells that were marked at the end
+        // of the last collection, the other cells were allocated since.
+        bool isOld(const void*);
+        // Unmarks the young cells before a minor collection, old cells stay
+        // marked whether they are still reachable or not.
+        void clearYoungMarks();
+        // Promotes the cells that survived the collection in place.
+        void promoteMarkedCells();
+        void clearOldGeneration();
+#endif
         
         template <typename Functor> void forEach(Functor&);
 
@@ -92,7 +112,11 @@ namespace JSC {
         size_t m_nextAtom;
         size_t m_endAtom; // This is a fuzzy end. Always test for < m_endAtom.
         size_t m_atomsPerCell;
+        bool m_needsSweep;
         WTF::Bitmap<blockSize / atomSize> m_marks;
+#if ENABLE(GGC)
+        WTF::Bitmap<blockSize / atomSize> m_oldMarks;
+#endif
         PageAllocationAligned m_allocation;
         Heap* m_heap;
         MarkedBlock* m_prev;
@@ -149,6 +173,16 @@ namespace JSC {
         m_nextAtom = firstAtom();
     }
 
+    inline bool MarkedBlock::needsSweep() const
+    {
+        return m_needsSweep;
+    }
+
+    inline void MarkedBlock::setNeedsSweep(bool needsSweep)
+    {
+        m_needsSweep = needsSweep;
+    }
+
     inline bool MarkedBlock::isEmpty()
     {
         return m_marks.isEmpty();
@@ -205,11 +239,41 @@ namespace JSC {
         return m_marks.testAndSet(atomNumber(p));
     }
 
+#if ENABLE(PARALLEL_GC)
+    inline bool MarkedBlock::concurrentTestAndSetMarked(const void* p)
+    {
+        // Several marking threads may be setting bits of the same word.
+        return m_marks.concurrentTestAndSet(atomNumber(p));
+    }
+#endif
+
     inline void MarkedBlock::setMarked(const void* p)
     {
         m_marks.set(atomNumber(p));
     }
 
+#if ENABLE(GGC)
+    inline bool MarkedBlock::isOld(const void* p)
+    {
+        return m_oldMarks.get(atomNumber(p));
+    }
+
+    inline void MarkedBlock::clearYoungMarks()
+    {
+        m_marks = m_oldMarks;
+    }
+
+    inline void MarkedBlock::promoteMarkedCells()
+    {
+        m_oldMarks = m_marks;
+    }
+
+    inline void MarkedBlock::clearOldGeneration()
+    {
+        m_oldMarks.clearAll();
+    }
+#endif
+
     template <typename Functor> inline void MarkedBlock::forEach(Functor& functor)
     {
         for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
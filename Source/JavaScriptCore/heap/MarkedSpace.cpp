@@ -26,13 +26,16 @@
 #include "JSLock.h"
 #include "JSObject.h"
 #include "ScopeChain.h"
+#include <wtf/CurrentTime.h>
 
 namespace JSC {
 
 class Structure;
 
 MarkedSpace::MarkedSpace(JSGlobalData* globalData)
-    : m_waterMark(0)
+    : m_nextBlockToSweep(0)
+    , m_sweepTime(0)
+    , m_waterMark(0)
     , m_highWaterMark(0)
     , m_globalData(globalData)
 {
@@ -75,6 +78,19 @@ void MarkedSpace::freeBlocks(DoublyLinkedList<MarkedBlock>& blocks)
 void* MarkedSpace::allocateFromSizeClass(SizeClass& sizeClass)
 {
     for (MarkedBlock*& block = sizeClass.nextBlock ; block; block = block->next()) {
+        // Sweeping the block we are about to allocate from brings it in
+        // the cache for the allocations that follow.
+        if (block->needsSweep()) {
+            sweepBlock(block);
+#if !USE(CF)
+            // Without the CF idle timer nothing else sweeps the blocks
+            // allocation doesn't get to. Sweeping one of them each time a
+            // block is swept here destroys their dead cells before the next
+            // collection.
+            sweepNextPendingBlock();
+#endif
+        }
+
         if (void* result = block->allocate())
             return result;
 
@@ -105,6 +121,17 @@ void MarkedSpace::shrink()
     
     freeBlocks(empties);
     ASSERT(empties.isEmpty());
+
+    // Forget about the blocks that were freed.
+    if (hasPendingSweep()) {
+        Vector<MarkedBlock*> blocksToSweep;
+        for (size_t i = m_nextBlockToSweep; i < m_blocksToSweep.size(); ++i) {
+            if (m_blocks.contains(m_blocksToSweep[i]))
+                blocksToSweep.append(m_blocksToSweep[i]);
+        }
+        m_blocksToSweep.swap(blocksToSweep);
+        m_nextBlockToSweep = 0;
+    }
 }
 
 void MarkedSpace::clearMarks()
@@ -116,10 +143,121 @@ void MarkedSpace::clearMarks()
 
 void MarkedSpace::sweep()
 {
+    cancelSweep();
+
+    double start = currentTime();
     BlockIterator end = m_blocks.end();
     for (BlockIterator it = m_blocks.begin(); it != end; ++it)
         (*it)->sweep();
+    m_sweepTime += currentTime() - start;
+}
+
+void MarkedSpace::sweepBlock(MarkedBlock* block)
+{
+    double start = currentTime();
+    block->sweep();
+    m_sweepTime += currentTime() - start;
+}
+
+void MarkedSpace::scheduleSweep()
+{
+    cancelSweep();
+
+    m_blocksToSweep.reserveCapacity(m_blocks.size());
+    BlockIterator end = m_blocks.end();
+    for (BlockIterator it = m_blocks.begin(); it != end; ++it) {
+        (*it)->setNeedsSweep(true);
+        m_blocksToSweep.append(*it);
+    }
+}
+
+void MarkedSpace::cancelSweep()
+{
+    for (size_t i = m_nextBlockToSweep; i < m_blocksToSweep.size(); ++i)
+        m_blocksToSweep[i]->setNeedsSweep(false);
+    m_blocksToSweep.clear();
+    m_nextBlockToSweep = 0;
+}
+
+void MarkedSpace::sweepNextPendingBlock()
+{
+    while (hasPendingSweep()) {
+        MarkedBlock* block = m_blocksToSweep[m_nextBlockToSweep++];
+        if (block->needsSweep()) {
+            sweepBlock(block);
+            return;
+        }
+    }
+}
+
+bool MarkedSpace::sweepIncrementally(double timeLimit)
+{
+    double start = currentTime();
+    double deadline = start + timeLimit;
+    while (hasPendingSweep()) {
+        MarkedBlock* block = m_blocksToSweep[m_nextBlockToSweep++];
+        // Blocks allocation got to first are already swept.
+        if (!block->needsSweep())
+            continue;
+        block->sweep();
+        if (currentTime() >= deadline)
+            break;
+    }
+    m_sweepTime += currentTime() - start;
+
+    if (!hasPendingSweep()) {
+        m_blocksToSweep.clear();
+        m_nextBlockToSweep = 0;
+        return false;
+    }
+    return true;
+}
+
+#if ENABLE(GGC)
+void MarkedSpace::gatherNurseryBlocks(Vector<MarkedBlock*>& blocks)
+{
+    // Allocation goes through the blocks of a size class in order, starting
+    // from the head of the list after each collection.
+    for (size_t i = 0; i < preciseCount + impreciseCount; ++i) {
+        SizeClass& sizeClass = i < preciseCount ? m_preciseSizeClasses[i] : m_impreciseSizeClasses[i - preciseCount];
+        for (MarkedBlock* block = sizeClass.blockList.head(); block; block = block->next()) {
+            blocks.append(block);
+            if (block == sizeClass.nextBlock)
+                break;
+        }
+    }
+}
+
+void MarkedSpace::clearYoungMarks()
+{
+    Vector<MarkedBlock*> nursery;
+    gatherNurseryBlocks(nursery);
+    for (size_t i = 0; i < nursery.size(); ++i)
+        nursery[i]->clearYoungMarks();
+}
+
+void MarkedSpace::promoteNursery()
+{
+    Vector<MarkedBlock*> nursery;
+    gatherNurseryBlocks(nursery);
+    for (size_t i = 0; i < nursery.size(); ++i)
+        nursery[i]->promoteMarkedCells();
+}
+
+void MarkedSpace::promoteAll()
+{
+    BlockIterator end = m_blocks.end();
+    for (BlockIterator it = m_blocks.begin(); it != end; ++it)
+        (*it)->promoteMarkedCells();
+}
+
+void MarkedSpace::clearOldGeneration()
+{
+    BlockIterator end = m_blocks.end();
+    for (BlockIterator it = m_blocks.begin(); it != end; ++it)
+        (*it)->clearOldGeneration();
 }
+#endif
 
 size_t MarkedSpace::objectCount() const
 {
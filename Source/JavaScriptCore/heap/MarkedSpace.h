@@ -53,6 +53,9 @@ namespace JSC {
 
         static bool isMarked(const JSCell*);
         static bool testAndSetMarked(const JSCell*);
+#if ENABLE(PARALLEL_GC)
+        static bool concurrentTestAndSetMarked(const JSCell*);
+#endif
         static void setMarked(const JSCell*);
 
         MarkedSpace(JSGlobalData*);
@@ -71,6 +74,31 @@ namespace JSC {
         void sweep();
         void shrink();
 
+        // Lazy sweeping: once scheduled, a block is swept when allocation
+        // gets to it, or by sweepIncrementally() during idle time on CF.
+        // Other ports sweep one more pending block each time allocation
+        // sweeps one, see allocateFromSizeClass(). Pending
+        // sweeps are dropped by cancelSweep(), MarkedBlock::allocate()
+        // destroys the dead cells it reuses anyway.
+        void scheduleSweep();
+        void cancelSweep();
+        // Sweeps pending blocks for up to timeLimit seconds, returns true if
+        // some are left.
+        bool sweepIncrementally(double timeLimit);
+        bool hasPendingSweep() const { return m_nextBlockToSweep < m_blocksToSweep.size(); }
+
+        // Total time spent sweeping, in seconds
+        double sweepTime() const { return m_sweepTime; }
+
+#if ENABLE(GGC)
+        // The nursery is made of the blocks allocation went through since
+        // the last collection, the only ones that can hold young cells.
+        void clearYoungMarks();
+        void promoteNursery();
+        void promoteAll();
+        void clearOldGeneration();
+#endif
+
         size_t size() const;
         size_t capacity() const;
         size_t objectCount() const;
@@ -108,10 +136,18 @@ namespace JSC {
         void* allocateFromSizeClass(SizeClass&);
 
         void clearMarks(MarkedBlock*);
+        void sweepBlock(MarkedBlock*);
+        void sweepNextPendingBlock();
+#if ENABLE(GGC)
+        void gatherNurseryBlocks(Vector<MarkedBlock*>&);
+#endif
 
         SizeClass m_preciseSizeClasses[preciseCount];
         SizeClass m_impreciseSizeClasses[impreciseCount];
         HashSet<MarkedBlock*> m_blocks;
+        Vector<MarkedBlock*> m_blocksToSweep;
+        size_t m_nextBlockToSweep;
+        double m_sweepTime;
         size_t m_waterMark;
         size_t m_highWaterMark;
         JSGlobalData* m_globalData;
@@ -132,6 +168,13 @@ namespace JSC {
         return MarkedBlock::blockFor(cell)->testAndSetMarked(cell);
     }
 
+#if ENABLE(PARALLEL_GC)
+    inline bool MarkedSpace::concurrentTestAndSetMarked(const JSCell* cell)
+    {
+        return MarkedBlock::blockFor(cell)->concurrentTestAndSetMarked(cell);
+    }
+#endif
+
     inline void MarkedSpace::setMarked(const JSCell* cell)
     {
         MarkedBlock::blockFor(cell)->setMarked(cell);
@@ -58,6 +58,7 @@
 #include "RegExpObject.h"
 #include "RegExpPrototype.h"
 #include "Register.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include "StrictEvalActivation.h"
 #include "UStringConcatenate.h"
@@ -1467,6 +1468,10 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #define CHECK_FOR_TIMEOUT() \
     if (!--tickCount) { \
+        if (SamplingProfiler* profiler = globalData->samplingProfiler.get()) { \
+            if (profiler->sampleRequested()) \
+                profiler->takeSample(callFrame, vPC - codeBlock->instructions().begin()); \
+        } \
         if (globalData->terminator.shouldTerminate() || globalData->timeoutChecker.didTimeOut(callFrame)) { \
             exceptionValue = jsNull(); \
             goto vm_throw; \
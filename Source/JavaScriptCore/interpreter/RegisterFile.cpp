@@ -54,7 +54,12 @@ RegisterFile::~RegisterFile()
 
 void RegisterFile::gatherConservativeRoots(ConservativeRoots& conservativeRoots)
 {
-    for (Register* it = start(); it != end(); ++it) {
+    gatherConservativeRoots(conservativeRoots, start(), end());
+}
+
+void RegisterFile::gatherConservativeRoots(ConservativeRoots& conservativeRoots, void* begin, void* end)
+{
+    for (Register* it = static_cast<Register*>(begin); it != static_cast<Register*>(end); ++it) {
         JSValue v = it->jsValue();
         if (!v.isCell())
             continue;
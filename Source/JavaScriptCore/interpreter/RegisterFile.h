@@ -115,6 +115,8 @@ namespace JSC {
         ~RegisterFile();
         
         void gatherConservativeRoots(ConservativeRoots&);
+        // Scans the registers in [begin, end), begin and end must be Register aligned
+        static void gatherConservativeRoots(ConservativeRoots&, void* begin, void* end);
 
         Register* start() const { return m_start; }
         Register* end() const { return m_end; }
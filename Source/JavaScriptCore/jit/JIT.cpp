@@ -486,6 +486,16 @@ JITCode JIT::privateCompile(CodePtr* functionEntryArityCheck)
 
     Label functionBody = label();
 
+    // Functions compiled while the sampling profiler runs check for sample
+    // requests on entry too, so that code without loops gets sampled.
+    if (m_codeBlock->codeType() == FunctionCode && m_globalData->samplingProfiler) {
+        m_bytecodeOffset = 0;
+        emitTimeoutCheck();
+#ifndef NDEBUG
+        m_bytecodeOffset = (unsigned)-1;
+#endif
+    }
+
     privateCompileMainPass();
     privateCompileLinkPass();
     privateCompileSlowCases();
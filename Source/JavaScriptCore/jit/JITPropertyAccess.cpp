@@ -206,7 +206,16 @@ void JIT::emit_op_put_by_val(Instruction* currentInstruction)
     Label storeResult(this);
     emitGetVirtualRegister(value, regT0);
     storePtr(regT0, BaseIndex(regT2, regT1, ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
-    Jump end = jump();
+
+    // Record what kind of value the array now holds (see ArrayStorage::m_hasDoubles).
+    JumpList end;
+    end.append(emitJumpIfImmediateInteger(regT0));
+    Jump notNumber = branchTestPtr(Zero, regT0, tagTypeNumberRegister);
+    store32(TrustedImm32(1), Address(regT2, OBJECT_OFFSETOF(ArrayStorage, m_hasDoubles)));
+    end.append(jump());
+    notNumber.link(this);
+    store32(TrustedImm32(1), Address(regT2, OBJECT_OFFSETOF(ArrayStorage, m_hasNonNumbers)));
+    end.append(jump());
     
     empty.link(this);
     add32(TrustedImm32(1), Address(regT2, OBJECT_OFFSETOF(ArrayStorage, m_numValuesInVector)));
@@ -394,6 +403,11 @@ void JIT::emit_op_get_by_id(Instruction* currentInstruction)
     unsigned baseVReg = currentInstruction[2].u.operand;
     Identifier* ident = &(m_codeBlock->identifier(currentInstruction[3].u.operand));
 
+#if ENABLE(SAMPLING_COUNTERS)
+    static SamplingCounter counter("get_by_id executions");
+    emitCount(counter);
+#endif
+
     emitGetVirtualRegister(baseVReg, regT0);
     compileGetByIdHotPath(resultVReg, baseVReg, ident, m_propertyAccessInstructionIndex++);
     emitPutVirtualRegister(resultVReg);
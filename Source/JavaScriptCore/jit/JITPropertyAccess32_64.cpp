@@ -372,7 +372,16 @@ void JIT::emit_op_put_by_val(Instruction* currentInstruction)
     emitLoad(value, regT1, regT0);
     store32(regT0, BaseIndex(regT3, regT2, TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.payload))); // payload
     store32(regT1, BaseIndex(regT3, regT2, TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.tag))); // tag
-    Jump end = jump();
+
+    // Record what kind of value the array now holds (see ArrayStorage::m_hasDoubles).
+    JumpList end;
+    end.append(branch32(Equal, regT1, TrustedImm32(JSValue::Int32Tag)));
+    Jump notNumber = branch32(AboveOrEqual, regT1, TrustedImm32(JSValue::LowestTag));
+    store32(TrustedImm32(1), Address(regT3, OBJECT_OFFSETOF(ArrayStorage, m_hasDoubles)));
+    end.append(jump());
+    notNumber.link(this);
+    store32(TrustedImm32(1), Address(regT3, OBJECT_OFFSETOF(ArrayStorage, m_hasNonNumbers)));
+    end.append(jump());
     
     empty.link(this);
     add32(TrustedImm32(1), Address(regT3, OBJECT_OFFSETOF(ArrayStorage, m_numValuesInVector)));
@@ -408,6 +417,11 @@ void JIT::emit_op_get_by_id(Instruction* currentInstruction)
     int dst = currentInstruction[1].u.operand;
     int base = currentInstruction[2].u.operand;
     
+#if ENABLE(SAMPLING_COUNTERS)
+    static SamplingCounter counter("get_by_id executions");
+    emitCount(counter);
+#endif
+
     emitLoad(base, regT1, regT0);
     emitJumpSlowCaseIfNotJSCell(base, regT1);
     compileGetByIdHotPath();
@@ -51,6 +51,7 @@
 #include "JSPropertyNameIterator.h"
 #include "JSStaticScopeObject.h"
 #include "JSString.h"
+#include "MegamorphicCache.h"
 #include "ObjectPrototype.h"
 #include "Operations.h"
 #include "Parser.h"
@@ -58,6 +59,7 @@
 #include "RegExpObject.h"
 #include "RegExpPrototype.h"
 #include "Register.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include <wtf/StdLibExtras.h>
 #include <stdarg.h>
@@ -67,6 +69,14 @@ using namespace std;
 
 namespace JSC {
 
+// Property access inline cache statistics, printed on exit along with the
+// other sampling counters.
+#if ENABLE(SAMPLING_COUNTERS)
+#define COUNT_PROPERTY_ACCESS(name) do { static SamplingCounter counter(name); counter.count(); } while (false)
+#else
+#define COUNT_PROPERTY_ACCESS(name) do { } while (false)
+#endif
+
 #if OS(DARWIN) || (OS(WINDOWS) && CPU(X86))
 #define SYMBOL_STRING(name) "_" #name
 #else
@@ -753,6 +763,7 @@ __asm void ctiOpThrowNotCaught()
 
 JITThunks::JITThunks(JSGlobalData* globalData)
     : m_hostFunctionStubMap(new HostFunctionStubMap)
+    , m_megamorphicCache(new MegamorphicCache)
 {
     if (!globalData->executableAllocator.isValid())
         return;
@@ -839,6 +850,8 @@ NEVER_INLINE void JITThunks::tryCachePutByID(CallFrame* callFrame, CodeBlock* co
             return;
         }
 
+        COUNT_PROPERTY_ACCESS("put_by_id transitions cached");
+
         // put_by_id_transition checks the prototype chain for setters.
         normalizePrototypeChain(callFrame, baseCell);
 
@@ -1346,6 +1359,13 @@ DEFINE_STUB_FUNCTION(int, timeout_check)
     JSGlobalData* globalData = stackFrame.globalData;
     TimeoutChecker& timeoutChecker = globalData->timeoutChecker;
 
+    if (SamplingProfiler* profiler = globalData->samplingProfiler.get()) {
+        if (profiler->sampleRequested()) {
+            CallFrame* callFrame = stackFrame.callFrame;
+            profiler->takeSample(callFrame, callFrame->codeBlock()->bytecodeOffset(STUB_RETURN_ADDRESS));
+        }
+    }
+
     if (globalData->terminator.shouldTerminate()) {
         globalData->exception = createTerminatedExecutionException(globalData);
         VM_THROW_EXCEPTION_AT_END();
@@ -1412,16 +1432,30 @@ DEFINE_STUB_FUNCTION(void, op_put_by_id_direct_generic)
     CHECK_FOR_EXCEPTION_AT_END();
 }
 
+// Used by the get_by_id sites that gave up on inline caching, looks the
+// property up in the megamorphic cache before doing the full lookup.
+static inline JSValue getByIdMegamorphic(CallFrame* callFrame, JSValue baseValue, const Identifier& ident)
+{
+    MegamorphicCache& cache = callFrame->globalData().jitStubs->megamorphicCache();
+    JSValue result;
+    if (cache.get(baseValue, ident, result)) {
+        COUNT_PROPERTY_ACCESS("get_by_id megamorphic cache hits");
+        return result;
+    }
+    COUNT_PROPERTY_ACCESS("get_by_id megamorphic cache misses");
+
+    PropertySlot slot(baseValue);
+    result = baseValue.get(callFrame, ident, slot);
+    if (!callFrame->hadException())
+        cache.add(callFrame, baseValue, ident, slot);
+    return result;
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_generic)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
 
-    CallFrame* callFrame = stackFrame.callFrame;
-    Identifier& ident = stackFrame.args[1].identifier();
-
-    JSValue baseValue = stackFrame.args[0].jsValue();
-    PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(callFrame, ident, slot);
+    JSValue result = getByIdMegamorphic(stackFrame.callFrame, stackFrame.args[0].jsValue(), stackFrame.args[1].identifier());
 
     CHECK_FOR_EXCEPTION_AT_END();
     return JSValue::encode(result);
@@ -1587,6 +1621,8 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id)
     CallFrame* callFrame = stackFrame.callFrame;
     Identifier& ident = stackFrame.args[1].identifier();
 
+    COUNT_PROPERTY_ACCESS("get_by_id inline cache misses");
+
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
     JSValue result = baseValue.get(callFrame, ident, slot);
@@ -1609,6 +1645,8 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_self_fail)
     CallFrame* callFrame = stackFrame.callFrame;
     Identifier& ident = stackFrame.args[1].identifier();
 
+    COUNT_PROPERTY_ACCESS("get_by_id polymorphic cache misses");
+
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
     JSValue result = baseValue.get(callFrame, ident, slot);
@@ -1638,13 +1676,18 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_self_fail)
         }
         if (listIndex < POLYMORPHIC_LIST_CACHE_SIZE) {
             stubInfo->u.getByIdSelfList.listSize++;
+            COUNT_PROPERTY_ACCESS("get_by_id polymorphic stubs compiled");
             JIT::compileGetByIdSelfList(callFrame->scopeChain()->globalData, codeBlock, stubInfo, polymorphicStructureList, listIndex, baseValue.asCell()->structure(), ident, slot, slot.cachedOffset());
 
-            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1))
+            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1)) {
+                COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
                 ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_generic));
+            }
         }
-    } else
+    } else {
+        COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
         ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_generic));
+    }
     return JSValue::encode(result);
 }
 
@@ -1716,6 +1759,8 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
     CallFrame* callFrame = stackFrame.callFrame;
     const Identifier& propertyName = stackFrame.args[1].identifier();
 
+    COUNT_PROPERTY_ACCESS("get_by_id polymorphic cache misses");
+
     JSValue baseValue = stackFrame.args[0].jsValue();
     PropertySlot slot(baseValue);
     JSValue result = baseValue.get(callFrame, propertyName, slot);
@@ -1723,6 +1768,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
     CHECK_FOR_EXCEPTION();
 
     if (!baseValue.isCell() || !slot.isCacheable() || baseValue.asCell()->structure()->isDictionary()) {
+        COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
         ctiPatchCallByReturnAddress(callFrame->codeBlock(), STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_fail));
         return JSValue::encode(result);
     }
@@ -1736,9 +1782,10 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
     
     size_t offset = slot.cachedOffset();
 
-    if (slot.slotBase() == baseValue)
+    if (slot.slotBase() == baseValue) {
+        COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
         ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_fail));
-    else if (slot.slotBase() == baseValue.asCell()->structure()->prototypeForLookup(callFrame)) {
+    } else if (slot.slotBase() == baseValue.asCell()->structure()->prototypeForLookup(callFrame)) {
         ASSERT(!baseValue.asCell()->structure()->isDictionary());
         // Since we're accessing a prototype in a loop, it's a good bet that it
         // should not be treated as a dictionary.
@@ -1750,10 +1797,13 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
         int listIndex;
         PolymorphicAccessStructureList* prototypeStructureList = getPolymorphicAccessStructureListSlot(callFrame->globalData(), codeBlock->ownerExecutable(), stubInfo, listIndex);
         if (listIndex < POLYMORPHIC_LIST_CACHE_SIZE) {
+            COUNT_PROPERTY_ACCESS("get_by_id polymorphic stubs compiled");
             JIT::compileGetByIdProtoList(callFrame->scopeChain()->globalData, callFrame, codeBlock, stubInfo, prototypeStructureList, listIndex, structure, slotBaseObject->structure(), propertyName, slot, offset);
 
-            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1))
+            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1)) {
+                COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
                 ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_list_full));
+            }
         }
     } else if (size_t count = normalizePrototypeChain(callFrame, baseValue, slot.slotBase(), propertyName, offset)) {
         ASSERT(!baseValue.asCell()->structure()->isDictionary());
@@ -1761,14 +1811,19 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list)
         PolymorphicAccessStructureList* prototypeStructureList = getPolymorphicAccessStructureListSlot(callFrame->globalData(), codeBlock->ownerExecutable(), stubInfo, listIndex);
         
         if (listIndex < POLYMORPHIC_LIST_CACHE_SIZE) {
+            COUNT_PROPERTY_ACCESS("get_by_id polymorphic stubs compiled");
             StructureChain* protoChain = structure->prototypeChain(callFrame);
             JIT::compileGetByIdChainList(callFrame->scopeChain()->globalData, callFrame, codeBlock, stubInfo, prototypeStructureList, listIndex, structure, protoChain, count, propertyName, slot, offset);
 
-            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1))
+            if (listIndex == (POLYMORPHIC_LIST_CACHE_SIZE - 1)) {
+                COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
                 ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_list_full));
+            }
         }
-    } else
+    } else {
+        COUNT_PROPERTY_ACCESS("get_by_id sites gone megamorphic");
         ctiPatchCallByReturnAddress(codeBlock, STUB_RETURN_ADDRESS, FunctionPtr(cti_op_get_by_id_proto_fail));
+    }
 
     return JSValue::encode(result);
 }
@@ -1777,9 +1832,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_list_full)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
 
-    JSValue baseValue = stackFrame.args[0].jsValue();
-    PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(stackFrame.callFrame, stackFrame.args[1].identifier(), slot);
+    JSValue result = getByIdMegamorphic(stackFrame.callFrame, stackFrame.args[0].jsValue(), stackFrame.args[1].identifier());
 
     CHECK_FOR_EXCEPTION_AT_END();
     return JSValue::encode(result);
@@ -1789,9 +1842,7 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_id_proto_fail)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
 
-    JSValue baseValue = stackFrame.args[0].jsValue();
-    PropertySlot slot(baseValue);
-    JSValue result = baseValue.get(stackFrame.callFrame, stackFrame.args[1].identifier(), slot);
+    JSValue result = getByIdMegamorphic(stackFrame.callFrame, stackFrame.args[0].jsValue(), stackFrame.args[1].identifier());
 
     CHECK_FOR_EXCEPTION_AT_END();
     return JSValue::encode(result);
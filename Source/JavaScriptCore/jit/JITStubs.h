@@ -275,6 +275,7 @@ namespace JSC {
     extern "C" void ctiOpThrowNotCaught();
     extern "C" EncodedJSValue ctiTrampoline(void* code, RegisterFile*, CallFrame*, void* /*unused1*/, Profiler**, JSGlobalData*);
 
+    class MegamorphicCache;
     template <typename T> class Strong;
 
     class JITThunks {
@@ -301,12 +302,15 @@ namespace JSC {
 
         void clearHostFunctionStubs();
 
+        MegamorphicCache& megamorphicCache() { return *m_megamorphicCache; }
+
     private:
         typedef HashMap<ThunkGenerator, MacroAssemblerCodePtr> CTIStubMap;
         CTIStubMap m_ctiStubMap;
         typedef HashMap<NativeFunction, Strong<NativeExecutable> > HostFunctionStubMap;
         OwnPtr<HostFunctionStubMap> m_hostFunctionStubMap;
         RefPtr<ExecutablePool> m_executablePool;
+        OwnPtr<MegamorphicCache> m_megamorphicCache;
 
         TrampolineStructure m_trampolineStructure;
     };
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "MegamorphicCache.h"
+
+#if ENABLE(JIT)
+
+#include "CallFrame.h"
+
+namespace JSC {
+
+void MegamorphicCache::add(CallFrame* callFrame, JSValue baseValue, const Identifier& propertyName, const PropertySlot& slot)
+{
+    if (!baseValue.isObject() || !slot.isCacheableValue())
+        return;
+
+    // Dictionaries can change their layout without changing their Structure.
+    Structure* structure = baseValue.asCell()->structure();
+    if (structure->isDictionary())
+        return;
+
+    Entry& entry = lookup(structure, propertyName.impl());
+    if (slot.slotBase() == baseValue) {
+        entry.prototype = 0;
+        entry.prototypeStructure = 0;
+    } else {
+        // An object resolving some names itself might shadow the prototype
+        // without its Structure telling.
+        if (structure->typeInfo().overridesGetOwnPropertySlot())
+            return;
+        if (slot.slotBase() != structure->prototypeForLookup(callFrame))
+            return;
+        JSObject* prototype = asObject(slot.slotBase());
+        if (prototype->structure()->isDictionary())
+            return;
+        entry.prototype = prototype;
+        entry.prototypeStructure = prototype->structure();
+    }
+    entry.structure = structure;
+    entry.propertyName = propertyName.impl();
+    entry.offset = slot.cachedOffset();
+}
+
+void MegamorphicCache::clear()
+{
+    memset(m_entries.data(), 0, sizeof(Entry) * cacheSize);
+}
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
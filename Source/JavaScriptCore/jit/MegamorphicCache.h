@@ -0,0 +1,99 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MegamorphicCache_h
+#define MegamorphicCache_h
+
+#if ENABLE(JIT)
+
+#include "JSObject.h"
+#include <wtf/FixedArray.h>
+#include <wtf/HashFunctions.h>
+
+namespace JSC {
+
+    // Backs the get_by_id sites whose inline cache gave up, either because
+    // the polymorphic list is full or because the access could not be
+    // compiled into a stub. Entries are keyed by the (Structure, Identifier)
+    // pair and remember where the value lives: at an offset in the base
+    // object itself, or in its prototype as long as the prototype keeps its
+    // Structure.
+    //
+    // Entries hold raw pointers to cells, the heap clears the cache at each
+    // collection so that they never outlive what they point to.
+    class MegamorphicCache {
+        WTF_MAKE_NONCOPYABLE(MegamorphicCache); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        MegamorphicCache() { clear(); }
+
+        bool get(JSValue baseValue, const Identifier& propertyName, JSValue& result)
+        {
+            if (!baseValue.isCell())
+                return false;
+            JSCell* baseCell = baseValue.asCell();
+            Structure* structure = baseCell->structure();
+            Entry& entry = lookup(structure, propertyName.impl());
+            if (entry.structure != structure || entry.propertyName != propertyName.impl())
+                return false;
+
+            JSObject* holder;
+            if (entry.prototype) {
+                if (entry.prototype->structure() != entry.prototypeStructure)
+                    return false;
+                holder = entry.prototype;
+            } else
+                holder = asObject(baseCell);
+            result = holder->getDirectOffset(entry.offset);
+            return true;
+        }
+
+        void add(CallFrame*, JSValue baseValue, const Identifier& propertyName, const PropertySlot&);
+        void clear();
+
+    private:
+        static const size_t cacheSize = 512;
+
+        struct Entry {
+            Structure* structure;
+            StringImpl* propertyName;
+            JSObject* prototype;
+            Structure* prototypeStructure;
+            size_t offset;
+        };
+
+        Entry& lookup(Structure* structure, StringImpl* propertyName)
+        {
+            unsigned hash = WTF::PtrHash<Structure*>::hash(structure) ^ propertyName->existingHash();
+            return m_entries[hash & (cacheSize - 1)];
+        }
+
+        FixedArray<Entry, cacheSize> m_entries;
+    };
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
+
+#endif // MegamorphicCache_h
@@ -64,7 +64,28 @@ namespace JSC {
             m_failures.append(branchPtr(NotEqual, Address(dst, 0), TrustedImmPtr(m_globalData->jsStringVPtr)));
             m_failures.append(branchTest32(NonZero, Address(dst, OBJECT_OFFSETOF(JSString, m_fiberCount))));
         }
-        
+
+        void loadJSArrayArgument(int argument, RegisterID dst)
+        {
+            loadCellArgument(argument, dst);
+            m_failures.append(branchPtr(NotEqual, Address(dst, 0), TrustedImmPtr(m_globalData->jsArrayVPtr)));
+        }
+
+#if USE(JSVALUE64)
+        void loadJSValueArgument(int argument, RegisterID dst)
+        {
+            unsigned src = argumentToVirtualRegister(argument);
+            loadPtr(addressFor(src), dst);
+        }
+#else
+        void loadJSValueArgument(int argument, RegisterID tag, RegisterID payload)
+        {
+            unsigned src = argumentToVirtualRegister(argument);
+            loadPtr(tagFor(src), tag);
+            loadPtr(payloadFor(src), payload);
+        }
+#endif
+
         void loadInt32Argument(int argument, RegisterID dst, Jump& failTarget)
         {
             unsigned src = argumentToVirtualRegister(argument);
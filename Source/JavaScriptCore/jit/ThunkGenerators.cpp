@@ -27,6 +27,7 @@
 #include "ThunkGenerators.h"
 
 #include "CodeBlock.h"
+#include "JSArray.h"
 #include <wtf/text/StringImpl.h>
 #include "SpecializedThunkJIT.h"
 
@@ -157,6 +158,167 @@ MacroAssemblerCodePtr powThunkGenerator(JSGlobalData* globalData, ExecutablePool
     return jit.finalize(globalData->jitStubs->ctiNativeCall());
 }
 
+
+static const double zeroConstant = 0.0;
+
+MacroAssemblerCodePtr floorThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    SpecializedThunkJIT jit(1, globalData, pool);
+    if (!jit.supportsFloatingPointTruncate())
+        return globalData->jitStubs->ctiNativeCall();
+
+    MacroAssembler::Jump nonIntJump;
+    jit.loadInt32Argument(0, SpecializedThunkJIT::regT0, nonIntJump);
+    jit.returnInt32(SpecializedThunkJIT::regT0);
+
+    // Truncation only rounds the same way as floor for positive values; zero, negative
+    // values, NaN and anything that does not fit in an int32 go to the native function.
+    nonIntJump.link(&jit);
+    jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
+    jit.loadDouble(&zeroConstant, SpecializedThunkJIT::fpRegT1);
+    jit.appendFailure(jit.branchDouble(MacroAssembler::DoubleLessThanOrEqualOrUnordered, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1));
+    jit.appendFailure(jit.branchTruncateDoubleToInt32(SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0));
+    jit.returnInt32(SpecializedThunkJIT::regT0);
+    return jit.finalize(globalData->jitStubs->ctiNativeCall());
+}
+
+MacroAssemblerCodePtr absThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    SpecializedThunkJIT jit(1, globalData, pool);
+    if (!jit.supportsFloatingPoint())
+        return globalData->jitStubs->ctiNativeCall();
+
+    MacroAssembler::Jump nonIntJump;
+    jit.loadInt32Argument(0, SpecializedThunkJIT::regT0, nonIntJump);
+    MacroAssembler::Jump isPositive = jit.branch32(MacroAssembler::GreaterThanOrEqual, SpecializedThunkJIT::regT0, MacroAssembler::TrustedImm32(0));
+    jit.neg32(SpecializedThunkJIT::regT0);
+    // Only INT_MIN is still negative after negation.
+    jit.appendFailure(jit.branch32(MacroAssembler::LessThan, SpecializedThunkJIT::regT0, MacroAssembler::TrustedImm32(0)));
+    isPositive.link(&jit);
+    jit.returnInt32(SpecializedThunkJIT::regT0);
+
+    // 0 - x gives the right answer for -0 and NaN as well as for negative values.
+    nonIntJump.link(&jit);
+    jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
+    jit.loadDouble(&zeroConstant, SpecializedThunkJIT::fpRegT1);
+    MacroAssembler::Jump isNotPositive = jit.branchDouble(MacroAssembler::DoubleLessThanOrEqualOrUnordered, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1);
+    jit.returnDouble(SpecializedThunkJIT::fpRegT0);
+    isNotPositive.link(&jit);
+    jit.subDouble(SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1);
+    jit.returnDouble(SpecializedThunkJIT::fpRegT1);
+    return jit.finalize(globalData->jitStubs->ctiNativeCall());
+}
+
+enum MinMaxKind { Min, Max };
+
+static MacroAssemblerCodePtr minMaxThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool, MinMaxKind kind)
+{
+    SpecializedThunkJIT jit(2, globalData, pool);
+    if (!jit.supportsFloatingPoint())
+        return globalData->jitStubs->ctiNativeCall();
+
+    MacroAssembler::Jump nonIntFirst;
+    MacroAssembler::Jump nonIntSecond;
+    jit.loadInt32Argument(0, SpecializedThunkJIT::regT0, nonIntFirst);
+    jit.loadInt32Argument(1, SpecializedThunkJIT::regT1, nonIntSecond);
+    MacroAssembler::Jump keepFirst = jit.branch32(kind == Max ? MacroAssembler::GreaterThanOrEqual : MacroAssembler::LessThanOrEqual, SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT1);
+    jit.move(SpecializedThunkJIT::regT1, SpecializedThunkJIT::regT0);
+    keepFirst.link(&jit);
+    jit.returnInt32(SpecializedThunkJIT::regT0);
+
+    // Equal operands may be zeros of different sign, and unordered ones mean a NaN;
+    // leave both to the native function.
+    nonIntFirst.link(&jit);
+    nonIntSecond.link(&jit);
+    jit.loadDoubleArgument(0, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::regT0);
+    jit.loadDoubleArgument(1, SpecializedThunkJIT::fpRegT1, SpecializedThunkJIT::regT0);
+    jit.appendFailure(jit.branchDouble(MacroAssembler::DoubleEqualOrUnordered, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1));
+    MacroAssembler::Jump secondWins = jit.branchDouble(kind == Max ? MacroAssembler::DoubleLessThan : MacroAssembler::DoubleGreaterThan, SpecializedThunkJIT::fpRegT0, SpecializedThunkJIT::fpRegT1);
+    jit.returnDouble(SpecializedThunkJIT::fpRegT0);
+    secondWins.link(&jit);
+    jit.returnDouble(SpecializedThunkJIT::fpRegT1);
+    return jit.finalize(globalData->jitStubs->ctiNativeCall());
+}
+
+MacroAssemblerCodePtr minThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    return minMaxThunkGenerator(globalData, pool, Min);
+}
+
+MacroAssemblerCodePtr maxThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    return minMaxThunkGenerator(globalData, pool, Max);
+}
+
+MacroAssemblerCodePtr stringIndexOfThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    SpecializedThunkJIT jit(1, globalData, pool);
+
+    // Only single character search strings are handled here.
+    jit.loadJSStringArgument(0, SpecializedThunkJIT::regT0);
+    jit.appendFailure(jit.branch32(MacroAssembler::NotEqual, MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::jsStringLengthOffset()), MacroAssembler::TrustedImm32(1)));
+    jit.loadPtr(MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::jsStringValueOffset()), SpecializedThunkJIT::regT0);
+    jit.loadPtr(MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::stringImplDataOffset()), SpecializedThunkJIT::regT0);
+    jit.load16(MacroAssembler::Address(SpecializedThunkJIT::regT0), SpecializedThunkJIT::regT3);
+
+    jit.loadJSStringArgument(SpecializedThunkJIT::ThisArgument, SpecializedThunkJIT::regT0);
+    jit.load32(MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::jsStringLengthOffset()), SpecializedThunkJIT::regT2);
+    jit.loadPtr(MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::jsStringValueOffset()), SpecializedThunkJIT::regT0);
+    jit.loadPtr(MacroAssembler::Address(SpecializedThunkJIT::regT0, ThunkHelpers::stringImplDataOffset()), SpecializedThunkJIT::regT0);
+
+    jit.move(MacroAssembler::TrustedImm32(0), SpecializedThunkJIT::regT1);
+    MacroAssembler::Label loop(jit.label());
+    MacroAssembler::Jump notFound = jit.branch32(MacroAssembler::AboveOrEqual, SpecializedThunkJIT::regT1, SpecializedThunkJIT::regT2);
+    MacroAssembler::Jump found = jit.branch16(MacroAssembler::Equal, MacroAssembler::BaseIndex(SpecializedThunkJIT::regT0, SpecializedThunkJIT::regT1, MacroAssembler::TimesTwo, 0), SpecializedThunkJIT::regT3);
+    jit.add32(MacroAssembler::TrustedImm32(1), SpecializedThunkJIT::regT1);
+    jit.jump().linkTo(loop, &jit);
+
+    found.link(&jit);
+    jit.returnInt32(SpecializedThunkJIT::regT1);
+    notFound.link(&jit);
+    jit.move(MacroAssembler::TrustedImm32(-1), SpecializedThunkJIT::regT0);
+    jit.returnInt32(SpecializedThunkJIT::regT0);
+    return jit.finalize(globalData->jitStubs->ctiNativeCall());
+}
+
+MacroAssemblerCodePtr arrayPushThunkGenerator(JSGlobalData* globalData, ExecutablePool* pool)
+{
+    SpecializedThunkJIT jit(1, globalData, pool);
+
+    // Only pushes that fit in the existing vector are handled here, mirroring the
+    // first case of JSArray::push.
+    jit.loadJSArrayArgument(SpecializedThunkJIT::ThisArgument, SpecializedThunkJIT::regT0);
+    jit.loadPtr(MacroAssembler::Address(SpecializedThunkJIT::regT0, JSArray::storageOffset()), SpecializedThunkJIT::regT2);
+    jit.load32(MacroAssembler::Address(SpecializedThunkJIT::regT2, OBJECT_OFFSETOF(ArrayStorage, m_length)), SpecializedThunkJIT::regT1);
+    jit.appendFailure(jit.branch32(MacroAssembler::AboveOrEqual, SpecializedThunkJIT::regT1, MacroAssembler::Address(SpecializedThunkJIT::regT0, JSArray::vectorLengthOffset())));
+
+    // Store the value and record what kind of value the array now holds (see ArrayStorage::m_hasDoubles).
+    MacroAssembler::JumpList recorded;
+#if USE(JSVALUE64)
+    jit.loadJSValueArgument(0, SpecializedThunkJIT::regT0);
+    jit.storePtr(SpecializedThunkJIT::regT0, MacroAssembler::BaseIndex(SpecializedThunkJIT::regT2, SpecializedThunkJIT::regT1, MacroAssembler::ScalePtr, OBJECT_OFFSETOF(ArrayStorage, m_vector[0])));
+    recorded.append(jit.branchPtr(MacroAssembler::AboveOrEqual, SpecializedThunkJIT::regT0, SpecializedThunkJIT::tagTypeNumberRegister));
+    MacroAssembler::Jump notNumber = jit.branchTestPtr(MacroAssembler::Zero, SpecializedThunkJIT::regT0, SpecializedThunkJIT::tagTypeNumberRegister);
+#else
+    jit.loadJSValueArgument(0, SpecializedThunkJIT::regT3, SpecializedThunkJIT::regT0);
+    jit.store32(SpecializedThunkJIT::regT0, MacroAssembler::BaseIndex(SpecializedThunkJIT::regT2, SpecializedThunkJIT::regT1, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.payload)));
+    jit.store32(SpecializedThunkJIT::regT3, MacroAssembler::BaseIndex(SpecializedThunkJIT::regT2, SpecializedThunkJIT::regT1, MacroAssembler::TimesEight, OBJECT_OFFSETOF(ArrayStorage, m_vector[0]) + OBJECT_OFFSETOF(JSValue, u.asBits.tag)));
+    recorded.append(jit.branch32(MacroAssembler::Equal, SpecializedThunkJIT::regT3, MacroAssembler::TrustedImm32(JSValue::Int32Tag)));
+    MacroAssembler::Jump notNumber = jit.branch32(MacroAssembler::AboveOrEqual, SpecializedThunkJIT::regT3, MacroAssembler::TrustedImm32(JSValue::LowestTag));
+#endif
+    jit.store32(MacroAssembler::TrustedImm32(1), MacroAssembler::Address(SpecializedThunkJIT::regT2, OBJECT_OFFSETOF(ArrayStorage, m_hasDoubles)));
+    recorded.append(jit.jump());
+    notNumber.link(&jit);
+    jit.store32(MacroAssembler::TrustedImm32(1), MacroAssembler::Address(SpecializedThunkJIT::regT2, OBJECT_OFFSETOF(ArrayStorage, m_hasNonNumbers)));
+    recorded.link(&jit);
+
+    jit.add32(MacroAssembler::TrustedImm32(1), MacroAssembler::Address(SpecializedThunkJIT::regT2, OBJECT_OFFSETOF(ArrayStorage, m_numValuesInVector)));
+    jit.add32(MacroAssembler::TrustedImm32(1), SpecializedThunkJIT::regT1);
+    jit.store32(SpecializedThunkJIT::regT1, MacroAssembler::Address(SpecializedThunkJIT::regT2, OBJECT_OFFSETOF(ArrayStorage, m_length)));
+    jit.returnInt32(SpecializedThunkJIT::regT1);
+    return jit.finalize(globalData->jitStubs->ctiNativeCall());
+}
+
 }
 
 #endif // ENABLE(JIT)
@@ -39,6 +39,12 @@ namespace JSC {
     MacroAssemblerCodePtr fromCharCodeThunkGenerator(JSGlobalData*, ExecutablePool*);
     MacroAssemblerCodePtr sqrtThunkGenerator(JSGlobalData*, ExecutablePool*);
     MacroAssemblerCodePtr powThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr floorThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr absThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr minThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr maxThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr stringIndexOfThunkGenerator(JSGlobalData*, ExecutablePool*);
+    MacroAssemblerCodePtr arrayPushThunkGenerator(JSGlobalData*, ExecutablePool*);
 }
 #endif
 
@@ -31,6 +31,9 @@
 #include "JSFunction.h"
 #include "JSLock.h"
 #include "JSString.h"
+#include "ParseProfiler.h"
+#include "PersistentParseCache.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include <math.h>
 #include <stdio.h>
@@ -101,11 +104,25 @@ struct Options {
     Options()
         : interactive(false)
         , dump(false)
+        , markingHelperThreads(0)
+        , youngGeneration(false)
+        , dumpGCStatistics(false)
+        , parseCachePath(0)
+        , lazyFunctionParsing(false)
+        , dumpParseStatistics(false)
+        , profilePath(0)
     {
     }
 
     bool interactive;
     bool dump;
+    unsigned markingHelperThreads;
+    bool youngGeneration;
+    bool dumpGCStatistics;
+    const char* parseCachePath;
+    bool lazyFunctionParsing;
+    bool dumpParseStatistics;
+    const char* profilePath;
     Vector<Script> scripts;
     Vector<UString> arguments;
 };
@@ -467,14 +484,21 @@ static void runInteractive(GlobalObject* globalObject)
 static NO_RETURN void printUsageStatement(JSGlobalData* globalData, bool help = false)
 {
     fprintf(stderr, "Usage: jsc [options] [files] [-- arguments]\n");
+    fprintf(stderr, "  -c file    Reuses the function boundaries saved in file, and saves new ones on exit\n");
     fprintf(stderr, "  -d         Dumps bytecode (debug builds only)\n");
     fprintf(stderr, "  -e         Evaluate argument as script code\n");
     fprintf(stderr, "  -f         Specifies a source file (deprecated)\n");
+    fprintf(stderr, "  -g         Prints garbage collection statistics on exit\n");
     fprintf(stderr, "  -h|--help  Prints this help message\n");
     fprintf(stderr, "  -i         Enables interactive mode (default if no files are specified)\n");
+    fprintf(stderr, "  -l         Parses all function bodies lazily, including the parenthesized function expressions of program code\n");
+    fprintf(stderr, "  -m count   Number of helper threads marking the heap in parallel during GC (default 0)\n");
+    fprintf(stderr, "  -p         Prints parser statistics on exit\n");
+    fprintf(stderr, "  -P file    Samples the stacks of the scripts every millisecond, and writes them to file in the folded format of flame graphs\n");
 #if HAVE(SIGNAL_H)
     fprintf(stderr, "  -s         Installs signal handlers that exit on a crash (Unix platforms only)\n");
 #endif
+    fprintf(stderr, "  -y         Collects the young generation separately (if available)\n");
 
     cleanupGlobalData(globalData);
     exit(help ? EXIT_SUCCESS : EXIT_FAILURE);
@@ -497,6 +521,12 @@ static void parseArguments(int argc, char** argv, Options& options, JSGlobalData
             options.scripts.append(Script(false, argv[i]));
             continue;
         }
+        if (!strcmp(arg, "-c")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.parseCachePath = argv[i];
+            continue;
+        }
         if (!strcmp(arg, "-i")) {
             options.interactive = true;
             continue;
@@ -505,6 +535,34 @@ static void parseArguments(int argc, char** argv, Options& options, JSGlobalData
             options.dump = true;
             continue;
         }
+        if (!strcmp(arg, "-m")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.markingHelperThreads = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(arg, "-l")) {
+            options.lazyFunctionParsing = true;
+            continue;
+        }
+        if (!strcmp(arg, "-p")) {
+            options.dumpParseStatistics = true;
+            continue;
+        }
+        if (!strcmp(arg, "-P")) {
+            if (++i == argc)
+                printUsageStatement(globalData);
+            options.profilePath = argv[i];
+            continue;
+        }
+        if (!strcmp(arg, "-y")) {
+            options.youngGeneration = true;
+            continue;
+        }
+        if (!strcmp(arg, "-g")) {
+            options.dumpGCStatistics = true;
+            continue;
+        }
         if (!strcmp(arg, "-s")) {
 #if HAVE(SIGNAL_H)
             signal(SIGILL, _exit);
@@ -530,18 +588,101 @@ static void parseArguments(int argc, char** argv, Options& options, JSGlobalData
         options.arguments.append(argv[i]);
 }
 
+static void dumpGCStatistics(JSGlobalData& globalData)
+{
+    Heap& heap = globalData.heap;
+    const Heap::CollectionStatistics& statistics = heap.collectionStatistics();
+    Heap::PhaseTimes times = heap.totalPhaseTimes();
+    if (statistics.minorCollections) {
+        fprintf(stderr, "minor collections: %lu, average pause %.3fms, max pause %.3fms\n",
+                static_cast<unsigned long>(statistics.minorCollections),
+                statistics.minorPauseTime * 1000 / statistics.minorCollections, statistics.maxMinorPause * 1000);
+    }
+    if (statistics.fullCollections) {
+        fprintf(stderr, "full collections: %lu, average pause %.3fms, max pause %.3fms\n",
+                static_cast<unsigned long>(statistics.fullCollections),
+                statistics.fullPauseTime * 1000 / statistics.fullCollections, statistics.maxFullPause * 1000);
+    }
+    fprintf(stderr, "mark %.3fms, sweep %.3fms, shrink %.3fms\n", times.mark * 1000, times.sweep * 1000, times.shrink * 1000);
+    fprintf(stderr, "heap size %luKB, large objects %luKB\n",
+            static_cast<unsigned long>(heap.size() / 1024), static_cast<unsigned long>(heap.largeObjectSize() / 1024));
+    const JSGlobalData::SubstringStatistics& substrings = globalData.substringStatistics;
+    fprintf(stderr, "substrings: %lu copied, %lu sharing large buffers, %lu buffers released (%luKB)\n",
+            static_cast<unsigned long>(substrings.copiedSubstrings), static_cast<unsigned long>(substrings.trackedSubstrings),
+            static_cast<unsigned long>(substrings.releasedBuffers), static_cast<unsigned long>(substrings.releasedBufferBytes / 1024));
+}
+
+static void dumpParseStatistics(const UString& url, const ParseStatistics& statistics)
+{
+    fprintf(stderr, "%s: %u program parses in %.3fms, %u functions compiled in %.3fms (%luKB reparsed)\n",
+            url.utf8().data(), statistics.programParses, statistics.programParseTime * 1000,
+            statistics.compiledFunctions, statistics.functionParseTime * 1000, static_cast<unsigned long>(statistics.reparsedBytes / 1024));
+    fprintf(stderr, "    %u functions preparsed (%luKB), %u skipped using the cache, %u parsed eagerly\n",
+            statistics.preparsedFunctions, static_cast<unsigned long>(statistics.preparsedBytes / 1024),
+            statistics.skippedFunctions, statistics.eagerFunctions);
+}
+
+static void writeProfile(SamplingProfiler& profiler, const char* path)
+{
+    profiler.stop();
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Could not open file: %s\n", path);
+        return;
+    }
+    profiler.dumpFoldedStacks(file);
+    fclose(file);
+    fprintf(stderr, "%u samples written to %s, %u dropped\n", profiler.sampleCount(), path, profiler.droppedSampleCount());
+}
+
 int jscmain(int argc, char** argv, JSGlobalData* globalData)
 {
     JSLock lock(SilenceAssertionsOnly);
 
     Options options;
     parseArguments(argc, argv, options, globalData);
+    globalData->heap.setNumberOfMarkingHelperThreads(options.markingHelperThreads);
+    if (options.youngGeneration && !globalData->heap.setYoungGenerationEnabled(true))
+        fprintf(stderr, "The young generation is not available in this build\n");
+
+    globalData->parseFunctionsEagerly = !options.lazyFunctionParsing;
+    ParseProfiler::setEnabled(options.dumpParseStatistics);
+    if (options.parseCachePath)
+        globalData->persistentParseCache = PersistentParseCache::create(options.parseCachePath);
+
+    if (options.profilePath) {
+        globalData->samplingProfiler = adoptPtr(new SamplingProfiler(*globalData));
+        globalData->samplingProfiler->start();
+    }
 
     GlobalObject* globalObject = new (globalData) GlobalObject(*globalData, options.arguments);
+    double startTime = currentTime();
     bool success = runWithScripts(globalObject, options.scripts, options.dump);
+    if (SamplingProfiler* profiler = globalData->samplingProfiler.get())
+        writeProfile(*profiler, options.profilePath);
+    if (PersistentParseCache* cache = globalData->persistentParseCache.get()) {
+        fprintf(stderr, "scripts ran in %.3fms, parse cache: %u hits, %u misses, %u functions loaded, %u saved\n",
+                (currentTime() - startTime) * 1000, cache->hitCount(), cache->missCount(),
+                cache->loadedItemCount(), cache->savedItemCount());
+    }
     if (options.interactive && success)
         runInteractive(globalObject);
 
+    if (options.dumpGCStatistics)
+        dumpGCStatistics(*globalData);
+
+    if (ParseProfiler* profiler = ParseProfiler::profiler()) {
+        const Vector<ParseProfiler::Record>& records = profiler->records();
+        for (size_t i = 0; i < records.size(); ++i)
+            dumpParseStatistics(records[i].url, records[i].statistics);
+        if (records.size() > 1)
+            dumpParseStatistics("total", profiler->totalStatistics());
+        ParseProfiler::setEnabled(false);
+    }
+
+    if (globalData->persistentParseCache && !globalData->persistentParseCache->save())
+        fprintf(stderr, "Could not save the parse cache to %s\n", options.parseCachePath);
+
     return success ? 0 : 3;
 }
 
@@ -109,6 +109,7 @@ public:
     static const bool CreatesAST = true;
     static const bool NeedsFreeVariableInfo = true;
     static const bool CanUseFunctionCache = true;
+    static const bool CanParseFunctionsEagerly = true;
 
     ExpressionNode* makeBinaryNode(int token, std::pair<ExpressionNode*, BinaryOpInfo>, std::pair<ExpressionNode*, BinaryOpInfo>);
     ExpressionNode* makeFunctionCallNode(ExpressionNode* func, ArgumentsNode* args, int start, int divot, int end);
@@ -264,6 +265,14 @@ public:
         usesClosures();
         return FunctionBodyNode::create(m_globalData, inStrictContext);
     }
+
+    void setFunctionBodyData(FunctionBodyNode* body, JSC::SourceElements* statements, ASTBuilder& bodyBuilder, IdentifierSet& capturedVariables, CodeFeatures features)
+    {
+        ParserArenaData<DeclarationStacks::VarStack>* varDeclarations = bodyBuilder.varDeclarations();
+        ParserArenaData<DeclarationStacks::FunctionStack>* funcDeclarations = bodyBuilder.funcDeclarations();
+        body->setData(statements, varDeclarations ? &varDeclarations->data : 0, funcDeclarations ? &funcDeclarations->data : 0,
+                      capturedVariables, bodyBuilder.features() | features, bodyBuilder.numConstants());
+    }
     
     template <bool> PropertyNode* createGetterOrSetterProperty(PropertyNode::Type type, const Identifier* name, ParameterNode* params, FunctionBodyNode* body, int openBracePos, int closeBracePos, int bodyStartLine, int bodyEndLine)
     {
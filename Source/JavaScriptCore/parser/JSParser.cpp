@@ -32,6 +32,8 @@ using namespace JSC;
 #include "CodeBlock.h"
 #include "JSGlobalData.h"
 #include "NodeInfo.h"
+#include "ParseProfiler.h"
+#include "PersistentParseCache.h"
 #include "ASTBuilder.h"
 #include "SourceProvider.h"
 #include "SourceProviderCacheItem.h"
@@ -70,7 +72,7 @@ COMPILE_ASSERT(LastUntaggedToken < 64, LessThan64UntaggedTokens);
 
 class JSParser {
 public:
-    JSParser(Lexer*, JSGlobalData*, FunctionParameters*, bool isStrictContext, bool isFunction, SourceProvider*);
+    JSParser(Lexer*, JSGlobalData*, FunctionParameters*, bool isStrictContext, bool isFunction, SourceProvider*, ParseStatistics&);
     const char* parseProgram();
 private:
     struct AllowInOverride {
@@ -217,11 +219,12 @@ private:
     template <class TreeBuilder> ALWAYS_INLINE TreeArguments parseArguments(TreeBuilder&);
     template <bool strict, class TreeBuilder> ALWAYS_INLINE TreeProperty parseProperty(TreeBuilder&);
     template <class TreeBuilder> ALWAYS_INLINE TreeFunctionBody parseFunctionBody(TreeBuilder&);
+    template <class TreeBuilder> TreeFunctionBody parseEagerFunctionBody(TreeBuilder&, TreeBuilder& bodyBuilder, TreeSourceElements&);
     template <class TreeBuilder> ALWAYS_INLINE TreeFormalParameterList parseFormalParameters(TreeBuilder&);
     template <class TreeBuilder> ALWAYS_INLINE TreeExpression parseVarDeclarationList(TreeBuilder&, int& declarations, const Identifier*& lastIdent, TreeExpression& lastInitializer, int& identStart, int& initStart, int& initEnd);
     template <class TreeBuilder> ALWAYS_INLINE TreeConstDeclList parseConstDeclarationList(TreeBuilder& context);
     enum FunctionRequirements { FunctionNoRequirements, FunctionNeedsName };
-    template <FunctionRequirements, bool nameIsInContainingScope, class TreeBuilder> bool parseFunctionInfo(TreeBuilder&, const Identifier*&, TreeFormalParameterList&, TreeFunctionBody&, int& openBrace, int& closeBrace, int& bodyStartLine);
+    template <FunctionRequirements, bool nameIsInContainingScope, class TreeBuilder> bool parseFunctionInfo(TreeBuilder&, const Identifier*&, TreeFormalParameterList&, TreeFunctionBody&, int& openBrace, int& closeBrace, int& bodyStartLine, bool parseEagerly = false);
     ALWAYS_INLINE int isBinaryOperator(JSTokenType token);
     bool allowAutomaticSemicolon();
 
@@ -234,6 +237,15 @@ private:
         return allowAutomaticSemicolon();
     }
 
+    // Parenthesized function expressions, as in (function() { ... })(), are
+    // usually called as soon as they are created. In program code, they are
+    // parsed along with the program and compiled by the bytecode generator
+    // instead of being parsed again on their first call.
+    bool shouldParseFunctionEagerly()
+    {
+        return m_globalData->parseFunctionsEagerly && !m_lexer->isReparsing() && m_scopeStack.size() == 1;
+    }
+
     bool canRecurse()
     {
         return m_stack.recursionCheck();
@@ -260,6 +272,9 @@ private:
     int m_statementDepth;
     int m_nonTrivialExpressionCount;
     const Identifier* m_lastIdentifier;
+    // Set when the expression after an open parenthesis starts with a function
+    bool m_parenthesizedFunction;
+    ParseStatistics& m_statistics;
 
     struct DepthManager {
         DepthManager(int* depth)
@@ -431,7 +446,9 @@ private:
         void getCapturedVariables(IdentifierSet& capturedVariables)
         {
             if (m_needsFullActivation || m_usesEval) {
-                capturedVariables.swap(m_declaredVariables);
+                // Copied, the declared variables are still needed when the
+                // scope of a function is popped
+                capturedVariables = m_declaredVariables;
                 return;
             }
             for (IdentifierSet::iterator ptr = m_closedVariables.begin(); ptr != m_closedVariables.end(); ++ptr) {
@@ -610,13 +627,13 @@ private:
     SourceProviderCache* m_functionCache;
 };
 
-const char* jsParse(JSGlobalData* globalData, FunctionParameters* parameters, JSParserStrictness strictness, JSParserMode parserMode, const SourceCode* source)
+const char* jsParse(JSGlobalData* globalData, FunctionParameters* parameters, JSParserStrictness strictness, JSParserMode parserMode, const SourceCode* source, ParseStatistics& statistics)
 {
-    JSParser parser(globalData->lexer, globalData, parameters, strictness == JSParseStrict, parserMode == JSParseFunctionCode, source->provider());
+    JSParser parser(globalData->lexer, globalData, parameters, strictness == JSParseStrict, parserMode == JSParseFunctionCode, source->provider(), statistics);
     return parser.parseProgram();
 }
 
-JSParser::JSParser(Lexer* lexer, JSGlobalData* globalData, FunctionParameters* parameters, bool inStrictContext, bool isFunction, SourceProvider* provider)
+JSParser::JSParser(Lexer* lexer, JSGlobalData* globalData, FunctionParameters* parameters, bool inStrictContext, bool isFunction, SourceProvider* provider, ParseStatistics& statistics)
     : m_lexer(lexer)
     , m_stack(globalData->stack())
     , m_error(false)
@@ -631,6 +648,8 @@ JSParser::JSParser(Lexer* lexer, JSGlobalData* globalData, FunctionParameters* p
     , m_statementDepth(0)
     , m_nonTrivialExpressionCount(0)
     , m_lastIdentifier(0)
+    , m_parenthesizedFunction(false)
+    , m_statistics(statistics)
     , m_functionCache(m_lexer->sourceProvider()->cache())
 {
     ScopeRef scope = pushScope();
@@ -648,6 +667,8 @@ JSParser::JSParser(Lexer* lexer, JSGlobalData* globalData, FunctionParameters* p
 
 const char* JSParser::parseProgram()
 {
+    if (m_functionCache && m_globalData->persistentParseCache)
+        m_globalData->persistentParseCache->load(m_globalData, m_lexer->sourceProvider());
     unsigned oldFunctionCacheSize = m_functionCache ? m_functionCache->byteSize() : 0;
     ASTBuilder context(m_globalData, m_lexer);
     if (m_lexer->isReparsing())
@@ -665,8 +686,11 @@ const char* JSParser::parseProgram()
         features |= ShadowsArgumentsFeature;
     
     unsigned functionCacheSize = m_functionCache ? m_functionCache->byteSize() : 0;
-    if (functionCacheSize != oldFunctionCacheSize)
+    if (functionCacheSize != oldFunctionCacheSize) {
         m_lexer->sourceProvider()->notifyCacheSizeChanged(functionCacheSize - oldFunctionCacheSize);
+        if (m_globalData->persistentParseCache)
+            m_globalData->persistentParseCache->update(m_lexer->sourceProvider());
+    }
 
     m_globalData->parser->didFinishParsing(sourceElements, context.varDeclarations(), context.funcDeclarations(), features,
                                            m_lastLine, context.numConstants(), capturedVariables);
@@ -1288,7 +1312,16 @@ template <class TreeBuilder> TreeFunctionBody JSParser::parseFunctionBody(TreeBu
     return context.createFunctionBody(strictMode());
 }
 
-template <JSParser::FunctionRequirements requirements, bool nameIsInContainingScope, class TreeBuilder> bool JSParser::parseFunctionInfo(TreeBuilder& context, const Identifier*& name, TreeFormalParameterList& parameters, TreeFunctionBody& body, int& openBracePos, int& closeBracePos, int& bodyStartLine)
+template <class TreeBuilder> TreeFunctionBody JSParser::parseEagerFunctionBody(TreeBuilder& context, TreeBuilder& bodyBuilder, TreeSourceElements& sourceElements)
+{
+    DepthManager statementDepth(&m_statementDepth);
+    m_statementDepth = 0;
+    sourceElements = parseSourceElements<CheckForStrictMode>(bodyBuilder);
+    failIfFalse(sourceElements);
+    return context.createFunctionBody(strictMode());
+}
+
+template <JSParser::FunctionRequirements requirements, bool nameIsInContainingScope, class TreeBuilder> bool JSParser::parseFunctionInfo(TreeBuilder& context, const Identifier*& name, TreeFormalParameterList& parameters, TreeFunctionBody& body, int& openBracePos, int& closeBracePos, int& bodyStartLine, bool parseEagerly)
 {
     AutoPopScopeRef functionScope(this, pushScope());
     functionScope->setIsFunction();
@@ -1323,13 +1356,20 @@ template <JSParser::FunctionRequirements requirements, bool nameIsInContainingSc
         m_lexer->setOffset(m_token.m_info.endOffset);
         m_lexer->setLineNumber(m_token.m_info.line);
 
+        m_statistics.skippedFunctions++;
         next();
         return true;
     }
 
     next();
 
-    body = parseFunctionBody(context);
+    OwnPtr<TreeBuilder> eagerBodyBuilder;
+    TreeSourceElements eagerSourceElements = 0;
+    if (parseEagerly && !match(CLOSEBRACE)) {
+        eagerBodyBuilder = adoptPtr(new TreeBuilder(m_globalData, m_lexer));
+        body = parseEagerFunctionBody(context, *eagerBodyBuilder, eagerSourceElements);
+    } else
+        body = parseFunctionBody(context);
     failIfFalse(body);
     if (functionScope->strictMode() && name) {
         failIfTrue(m_globalData->propertyNames->arguments == *name);
@@ -1346,6 +1386,27 @@ template <JSParser::FunctionRequirements requirements, bool nameIsInContainingSc
         newInfo = adoptPtr(new SourceProviderCacheItem(m_token.m_info.line, closeBracePos));
         functionScope->saveFunctionInfo(newInfo.get());
     }
+
+    // Only small bodies are compiled with the program, a large one would make
+    // the program wait for its compilation before running anything.
+    static const int maximumEagerFunctionLength = 8192;
+    if (eagerBodyBuilder && functionLength > maximumEagerFunctionLength)
+        eagerBodyBuilder.clear();
+
+    if (eagerBodyBuilder) {
+        IdentifierSet capturedVariables;
+        functionScope->getCapturedVariables(capturedVariables);
+        CodeFeatures features = NoFeatures;
+        if (functionScope->strictMode())
+            features |= StrictModeFeature;
+        if (functionScope->shadowsArguments())
+            features |= ShadowsArgumentsFeature;
+        context.setFunctionBodyData(body, eagerSourceElements, *eagerBodyBuilder, capturedVariables, features);
+        m_statistics.eagerFunctions++;
+    } else {
+        m_statistics.preparsedFunctions++;
+        m_statistics.preparsedBytes += functionLength;
+    }
     
     failIfFalse(popScope(functionScope, TreeBuilder::NeedsFreeVariableInfo));
     matchOrFail(CLOSEBRACE);
@@ -1881,6 +1942,7 @@ template <class TreeBuilder> TreeExpression JSParser::parsePrimaryExpression(Tre
         return parseArrayLiteral(context);
     case OPENPAREN: {
         next();
+        m_parenthesizedFunction = match(FUNCTION);
         int oldNonLHSCount = m_nonLHSCount;
         TreeExpression result = parseExpression(context);
         m_nonLHSCount = oldNonLHSCount;
@@ -1987,8 +2049,14 @@ template <class TreeBuilder> TreeExpression JSParser::parseMemberExpression(Tree
         int openBracePos = 0;
         int closeBracePos = 0;
         int bodyStartLine = 0;
+        bool parseEagerly = TreeBuilder::CanParseFunctionsEagerly && m_parenthesizedFunction && shouldParseFunctionEagerly();
+        m_parenthesizedFunction = false;
         next();
-        failIfFalse((parseFunctionInfo<FunctionNoRequirements, false>(context, name, parameters, body, openBracePos, closeBracePos, bodyStartLine)));
+        // Named function expressions aren't compiled eagerly (see
+        // BytecodeGenerator::emitNewFunctionExpression), the tree would be thrown away.
+        if (match(IDENT))
+            parseEagerly = false;
+        failIfFalse((parseFunctionInfo<FunctionNoRequirements, false>(context, name, parameters, body, openBracePos, closeBracePos, bodyStartLine, parseEagerly)));
         base = context.createFunctionExpr(name, body, parameters, openBracePos, closeBracePos, bodyStartLine, m_lastLine);
     } else
         base = parsePrimaryExpression(context);
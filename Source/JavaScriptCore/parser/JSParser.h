@@ -33,6 +33,7 @@ class FunctionParameters;
 class Identifier;
 class JSGlobalData;
 class SourceCode;
+struct ParseStatistics;
 
 enum {
     UnaryOpTokenFlag = 64,
@@ -159,6 +160,6 @@ struct JSToken {
 enum JSParserStrictness { JSParseNormal, JSParseStrict };
 enum JSParserMode { JSParseProgramCode, JSParseFunctionCode };
 
-const char* jsParse(JSGlobalData*, FunctionParameters*, JSParserStrictness, JSParserMode, const SourceCode*);
+const char* jsParse(JSGlobalData*, FunctionParameters*, JSParserStrictness, JSParserMode, const SourceCode*, ParseStatistics&);
 }
 #endif // JSParser_h
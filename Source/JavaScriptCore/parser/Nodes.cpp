@@ -105,6 +105,13 @@ ScopeNode::ScopeNode(JSGlobalData* globalData, const SourceCode& source, SourceE
 {
 }
 
+void ScopeNode::setData(SourceElements* children, VarStack* varStack, FunctionStack* funcStack, IdentifierSet& capturedVariables, CodeFeatures features, int numConstants)
+{
+    ParserArena emptyArena;
+    m_data = adoptPtr(new ScopeNodeData(emptyArena, children, varStack, funcStack, capturedVariables, numConstants));
+    m_features |= features;
+}
+
 StatementNode* ScopeNode::singleStatement() const
 {
     return m_data->m_statements ? m_data->m_statements->singleStatement() : 0;
@@ -1403,6 +1403,9 @@ namespace JSC {
         using ParserArenaRefCounted::operator new;
 
         ScopeNodeData* data() const { return m_data.get(); }
+        // Used for the functions parsed along with the enclosing code, the
+        // nodes stay in the arena of that code
+        void setData(SourceElements*, VarStack*, FunctionStack*, IdentifierSet&, CodeFeatures, int numConstants);
         void destroyData() { m_data.clear(); }
 
         const SourceCode& source() const { return m_source; }
@@ -26,6 +26,8 @@
 #include "Debugger.h"
 #include "JSParser.h"
 #include "Lexer.h"
+#include "ParseProfiler.h"
+#include <wtf/CurrentTime.h>
 
 namespace JSC {
 
@@ -48,7 +50,20 @@ void Parser::parse(JSGlobalData* globalData, FunctionParameters* parameters, JSP
     Lexer& lexer = *globalData->lexer;
     lexer.setCode(*m_source, m_arena);
 
-    const char* parseError = jsParse(globalData, parameters, strictness, mode, m_source);
+    ParseStatistics statistics;
+    double startTime = currentTime();
+    const char* parseError = jsParse(globalData, parameters, strictness, mode, m_source, statistics);
+    double parseTime = currentTime() - startTime;
+    if (mode == JSParseFunctionCode) {
+        statistics.compiledFunctions++;
+        statistics.reparsedBytes += m_source->length();
+        statistics.functionParseTime += parseTime;
+    } else {
+        statistics.programParses++;
+        statistics.programParseTime += parseTime;
+    }
+    m_source->provider()->didParse(statistics);
+
     int lineNumber = lexer.lineNumber();
     bool lexError = lexer.sawError();
     lexer.clear();
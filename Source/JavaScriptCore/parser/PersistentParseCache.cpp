@@ -0,0 +1,405 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "PersistentParseCache.h"
+
+#include "Identifier.h"
+#include "JSGlobalData.h"
+#include "SourceProvider.h"
+#include "SourceProviderCacheItem.h"
+#include "UStringConcatenate.h"
+#include <stdio.h>
+#include <wtf/StringHasher.h>
+#include <wtf/text/CString.h>
+
+namespace JSC {
+
+static const unsigned cacheFileMagic = 0x4350534a; // 'JSPC'
+static const unsigned cacheFileVersion = 1;
+
+// Entries are no longer recorded once the file would grow past this size
+static const size_t maximumCacheSize = 8 * 1024 * 1024;
+
+struct CacheFileHeader {
+    unsigned magic;
+    unsigned version;
+    unsigned entryCount;
+    unsigned payloadSize;
+    unsigned checksum;
+};
+
+struct CacheEntryHeader {
+    unsigned hash;
+    unsigned length;
+    unsigned checkHash;
+    unsigned itemCount;
+    unsigned itemsSize;
+};
+
+struct CacheItemHeader {
+    int openBracePos;
+    int closeBracePos;
+    int closeBraceLine;
+    unsigned usesEval;
+    unsigned usedVariableCount;
+    unsigned writtenVariableCount;
+};
+
+// FNV-1a, used as a second hash of the source so that a collision of the
+// StringHasher hash alone does not hand the items of a script to another
+static unsigned checkHash(const void* data, size_t size, unsigned hash = 2166136261u)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static SourceProviderCache::SourceKey computeSourceKey(SourceProvider* provider)
+{
+    SourceProviderCache::SourceKey key;
+    key.length = provider->length();
+    // The lines of the items depend on where the source starts
+    unsigned startLine = provider->startPosition().m_line.oneBasedInt();
+    key.hash = StringHasher::computeHash<UChar>(provider->data(), key.length) ^ startLine;
+    key.checkHash = checkHash(&startLine, sizeof(startLine), checkHash(provider->data(), key.length * sizeof(UChar)));
+    return key;
+}
+
+class CacheReader {
+public:
+    CacheReader(const char* data, size_t size)
+        : m_data(data)
+        , m_end(data + size)
+    {
+    }
+
+    template<typename T> bool read(T& value)
+    {
+        if (static_cast<size_t>(m_end - m_data) < sizeof(T))
+            return false;
+        memcpy(&value, m_data, sizeof(T));
+        m_data += sizeof(T);
+        return true;
+    }
+
+    const char* skip(size_t size)
+    {
+        if (static_cast<size_t>(m_end - m_data) < size)
+            return 0;
+        const char* data = m_data;
+        m_data += size;
+        return data;
+    }
+
+    bool atEnd() const { return m_data == m_end; }
+    size_t remaining() const { return m_end - m_data; }
+
+private:
+    const char* m_data;
+    const char* m_end;
+};
+
+template<typename T> static void append(Vector<char>& buffer, const T& value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void appendVariables(Vector<char>& buffer, const Vector<RefPtr<StringImpl> >& variables)
+{
+    for (size_t i = 0; i < variables.size(); ++i) {
+        unsigned length = variables[i]->length();
+        append(buffer, length);
+        buffer.append(reinterpret_cast<const char*>(variables[i]->characters()), length * sizeof(UChar));
+    }
+}
+
+static bool readVariables(JSGlobalData* globalData, CacheReader& reader, unsigned count, Vector<RefPtr<StringImpl> >& variables)
+{
+    // Each variable takes at least its length.
+    if (count > reader.remaining() / sizeof(unsigned))
+        return false;
+    variables.reserveInitialCapacity(count);
+    for (unsigned i = 0; i < count; ++i) {
+        unsigned length;
+        if (!reader.read(length) || length > maximumCacheSize)
+            return false;
+        const char* characters = reader.skip(length * sizeof(UChar));
+        if (!characters)
+            return false;
+        Vector<UChar, 32> buffer(length);
+        memcpy(buffer.data(), characters, length * sizeof(UChar));
+        variables.uncheckedAppend(Identifier(globalData, buffer.data(), length).impl());
+    }
+    return true;
+}
+
+PassOwnPtr<PersistentParseCache> PersistentParseCache::create(const UString& path)
+{
+    OwnPtr<PersistentParseCache> cache = adoptPtr(new PersistentParseCache(path));
+    cache->readFile();
+    return cache.release();
+}
+
+PersistentParseCache::PersistentParseCache(const UString& path)
+    : m_path(path)
+    , m_size(sizeof(CacheFileHeader))
+    , m_isDirty(false)
+    , m_hitCount(0)
+    , m_missCount(0)
+    , m_loadedItemCount(0)
+    , m_savedItemCount(0)
+{
+}
+
+PersistentParseCache::~PersistentParseCache()
+{
+    deleteAllValues(m_entries);
+}
+
+void PersistentParseCache::readFile()
+{
+    FILE* file = fopen(m_path.utf8().data(), "rb");
+    if (!file)
+        return;
+
+    Vector<char> data;
+    char buffer[4096];
+    while (size_t count = fread(buffer, 1, sizeof(buffer), file)) {
+        data.append(buffer, count);
+        if (data.size() > maximumCacheSize)
+            break;
+    }
+    fclose(file);
+
+    if (!read(data.data(), data.size())) {
+        // A truncated or stale file is dropped, it is written again by save()
+        deleteAllValues(m_entries);
+        m_entries.clear();
+        m_size = sizeof(CacheFileHeader);
+    }
+}
+
+bool PersistentParseCache::read(const char* data, size_t size)
+{
+    CacheReader reader(data, size);
+    CacheFileHeader header;
+    if (!reader.read(header) || header.magic != cacheFileMagic || header.version != cacheFileVersion)
+        return false;
+    const char* payload = reader.skip(header.payloadSize);
+    if (!payload || !reader.atEnd() || checkHash(payload, header.payloadSize) != header.checksum)
+        return false;
+
+    CacheReader entries(payload, header.payloadSize);
+    for (unsigned i = 0; i < header.entryCount; ++i) {
+        CacheEntryHeader entryHeader;
+        if (!entries.read(entryHeader))
+            return false;
+        const char* items = entries.skip(entryHeader.itemsSize);
+        if (!items)
+            return false;
+
+        SourceProviderCache::SourceKey key;
+        key.length = entryHeader.length;
+        key.hash = entryHeader.hash;
+        key.checkHash = entryHeader.checkHash;
+        Entry* entry = new Entry(key);
+        entry->itemCount = entryHeader.itemCount;
+        entry->items.append(items, entryHeader.itemsSize);
+        if (Entry* previous = m_entries.take(key.hash)) {
+            m_size -= sizeof(CacheEntryHeader) + previous->items.size();
+            delete previous;
+        }
+        m_entries.set(key.hash, entry);
+        m_size += sizeof(CacheEntryHeader) + entry->items.size();
+    }
+    return entries.atEnd();
+}
+
+void PersistentParseCache::load(JSGlobalData* globalData, SourceProvider* provider)
+{
+    SourceProviderCache* cache = provider->cache();
+    if (!cache || cache->hasSourceKey())
+        return;
+    SourceProviderCache::SourceKey key = computeSourceKey(provider);
+    cache->setSourceKey(key);
+
+    Entry* entry = m_entries.get(key.hash);
+    if (!entry || entry->length != key.length || entry->checkHash != key.checkHash) {
+        m_missCount++;
+        return;
+    }
+    m_hitCount++;
+
+    // The items are checked against the source before being used, the parser
+    // trusts the positions it finds in the cache
+    const UChar* source = provider->data();
+    int length = provider->length();
+    CacheReader reader(entry->items.data(), entry->items.size());
+    for (unsigned i = 0; i < entry->itemCount; ++i) {
+        CacheItemHeader itemHeader;
+        if (!reader.read(itemHeader))
+            break;
+        OwnPtr<SourceProviderCacheItem> item = adoptPtr(new SourceProviderCacheItem(itemHeader.closeBraceLine, itemHeader.closeBracePos));
+        item->usesEval = itemHeader.usesEval;
+        if (!readVariables(globalData, reader, itemHeader.usedVariableCount, item->usedVariables)
+            || !readVariables(globalData, reader, itemHeader.writtenVariableCount, item->writtenVariables))
+            break;
+        if (itemHeader.openBracePos < 0 || itemHeader.openBracePos >= itemHeader.closeBracePos
+            || itemHeader.closeBracePos >= length || itemHeader.closeBraceLine < 0
+            || source[itemHeader.openBracePos] != '{' || source[itemHeader.closeBracePos] != '}'
+            || cache->get(itemHeader.openBracePos))
+            continue;
+        unsigned approximateByteSize = item->approximateByteSize();
+        cache->add(itemHeader.openBracePos, item.release(), approximateByteSize);
+        provider->notifyCacheSizeChanged(approximateByteSize);
+        m_loadedItemCount++;
+    }
+}
+
+void PersistentParseCache::update(SourceProvider* provider)
+{
+    SourceProviderCache* cache = provider->cache();
+    if (!cache || !cache->hasSourceKey())
+        return;
+    const SourceProviderCache::SourceKey& key = cache->sourceKey();
+
+    Entry* entry = m_entries.get(key.hash);
+    if (entry && (entry->length != key.length || entry->checkHash != key.checkHash)) {
+        // Another source with the same hash, the most recent one is kept
+        m_size -= sizeof(CacheEntryHeader) + entry->items.size();
+        m_entries.remove(key.hash);
+        delete entry;
+        entry = 0;
+    }
+    if (!entry) {
+        if (m_size + sizeof(CacheEntryHeader) > maximumCacheSize)
+            return;
+        entry = new Entry(key);
+        m_entries.set(key.hash, entry);
+        m_size += sizeof(CacheEntryHeader);
+    }
+
+    if (entry->positions.isEmpty() && entry->itemCount) {
+        CacheReader reader(entry->items.data(), entry->items.size());
+        for (unsigned i = 0; i < entry->itemCount; ++i) {
+            CacheItemHeader itemHeader;
+            if (!reader.read(itemHeader))
+                break;
+            entry->positions.add(itemHeader.openBracePos);
+            unsigned variableCount = itemHeader.usedVariableCount + itemHeader.writtenVariableCount;
+            for (unsigned j = 0; j < variableCount; ++j) {
+                unsigned length;
+                if (!reader.read(length) || !reader.skip(length * sizeof(UChar)))
+                    break;
+            }
+        }
+    }
+
+    SourceProviderCache::const_iterator end = cache->end();
+    for (SourceProviderCache::const_iterator it = cache->begin(); it != end; ++it) {
+        // Position 0 is the empty value of the set, no function body starts
+        // there anyway
+        if (!it->first || entry->positions.contains(it->first))
+            continue;
+        const SourceProviderCacheItem* item = it->second;
+        size_t oldSize = entry->items.size();
+
+        CacheItemHeader itemHeader;
+        itemHeader.openBracePos = it->first;
+        itemHeader.closeBracePos = item->closeBracePos;
+        itemHeader.closeBraceLine = item->closeBraceLine;
+        itemHeader.usesEval = item->usesEval;
+        itemHeader.usedVariableCount = item->usedVariables.size();
+        itemHeader.writtenVariableCount = item->writtenVariables.size();
+        append(entry->items, itemHeader);
+        appendVariables(entry->items, item->usedVariables);
+        appendVariables(entry->items, item->writtenVariables);
+
+        if (m_size + entry->items.size() - oldSize > maximumCacheSize) {
+            entry->items.shrink(oldSize);
+            break;
+        }
+        m_size += entry->items.size() - oldSize;
+        entry->positions.add(it->first);
+        entry->itemCount++;
+        m_savedItemCount++;
+        m_isDirty = true;
+    }
+}
+
+bool PersistentParseCache::save()
+{
+    if (!m_isDirty)
+        return true;
+
+    Vector<char> payload;
+    payload.reserveInitialCapacity(m_size);
+    HashMap<unsigned, Entry*>::iterator end = m_entries.end();
+    unsigned entryCount = 0;
+    for (HashMap<unsigned, Entry*>::iterator it = m_entries.begin(); it != end; ++it) {
+        Entry* entry = it->second;
+        if (!entry->itemCount)
+            continue;
+        CacheEntryHeader entryHeader;
+        entryHeader.hash = it->first;
+        entryHeader.length = entry->length;
+        entryHeader.checkHash = entry->checkHash;
+        entryHeader.itemCount = entry->itemCount;
+        entryHeader.itemsSize = entry->items.size();
+        append(payload, entryHeader);
+        payload.append(entry->items.data(), entry->items.size());
+        entryCount++;
+    }
+
+    CacheFileHeader header;
+    header.magic = cacheFileMagic;
+    header.version = cacheFileVersion;
+    header.entryCount = entryCount;
+    header.payloadSize = payload.size();
+    header.checksum = checkHash(payload.data(), payload.size());
+
+    // Written next to the cache and renamed over it, so that a process
+    // reading the cache never sees a partial file
+    CString path = m_path.utf8();
+    CString temporaryPath = makeUString(m_path, ".tmp").utf8();
+    FILE* file = fopen(temporaryPath.data(), "wb");
+    if (!file)
+        return false;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && (payload.isEmpty() || fwrite(payload.data(), payload.size(), 1, file) == 1);
+    written = !fclose(file) && written;
+    if (!written || rename(temporaryPath.data(), path.data())) {
+        remove(temporaryPath.data());
+        return false;
+    }
+    m_isDirty = false;
+    return true;
+}
+
+} // namespace JSC
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PersistentParseCache_h
+#define PersistentParseCache_h
+
+#include "SourceProviderCache.h"
+#include "UString.h"
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+    class JSGlobalData;
+    class SourceProvider;
+
+    // Keeps the function boundaries found by the parser (the items of the
+    // SourceProviderCache) in a file, so that the next runs loading a script
+    // with the same text skip the bodies of its functions the way a reparse
+    // does. Entries are keyed by a hash of the source text, the file and the
+    // items are validated when they are loaded.
+    class PersistentParseCache {
+        WTF_MAKE_NONCOPYABLE(PersistentParseCache); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        // Reads the entries saved in the file at path, if any. The file is
+        // only written by save().
+        static PassOwnPtr<PersistentParseCache> create(const UString& path);
+        ~PersistentParseCache();
+
+        // Adds the items saved for the text of provider to its cache, once
+        // per SourceProviderCache.
+        void load(JSGlobalData*, SourceProvider*);
+        // Records the items of the cache of provider that are not saved yet.
+        void update(SourceProvider*);
+        bool save();
+
+        unsigned hitCount() const { return m_hitCount; }
+        unsigned missCount() const { return m_missCount; }
+        unsigned loadedItemCount() const { return m_loadedItemCount; }
+        unsigned savedItemCount() const { return m_savedItemCount; }
+
+    private:
+        struct Entry {
+            Entry(const SourceProviderCache::SourceKey& key)
+                : length(key.length)
+                , checkHash(key.checkHash)
+                , itemCount(0)
+            {
+            }
+            unsigned length;
+            unsigned checkHash;
+            unsigned itemCount;
+            Vector<char> items;
+            // Positions of the items, filled when the entry is first updated
+            HashSet<int> positions;
+        };
+
+        PersistentParseCache(const UString& path);
+
+        bool read(const char* data, size_t size);
+        void readFile();
+
+        UString m_path;
+        HashMap<unsigned, Entry*> m_entries;
+        size_t m_size;
+        bool m_isDirty;
+
+        unsigned m_hitCount;
+        unsigned m_missCount;
+        unsigned m_loadedItemCount;
+        unsigned m_savedItemCount;
+    };
+
+} // namespace JSC
+
+#endif // PersistentParseCache_h
@@ -29,6 +29,7 @@
 #ifndef SourceProvider_h
 #define SourceProvider_h
 
+#include "ParseProfiler.h"
 #include "SourceProviderCache.h"
 #include "UString.h"
 #include <wtf/PassOwnPtr.h>
@@ -66,6 +67,14 @@ namespace JSC {
 
         SourceProviderCache* cache() const { return m_cache; }
         void notifyCacheSizeChanged(int delta) { if (!m_cacheOwned) cacheSizeChanged(delta); }
+
+        const ParseStatistics& parseStatistics() const { return m_parseStatistics; }
+        void didParse(const ParseStatistics& statistics)
+        {
+            m_parseStatistics.add(statistics);
+            if (ParseProfiler* profiler = ParseProfiler::profiler())
+                profiler->didParse(m_url, statistics);
+        }
         
     private:
         virtual void cacheSizeChanged(int delta) { UNUSED_PARAM(delta); }
@@ -74,6 +83,7 @@ namespace JSC {
         bool m_validated;
         SourceProviderCache* m_cache;
         bool m_cacheOwned;
+        ParseStatistics m_parseStatistics;
     };
 
     class UStringSourceProvider : public SourceProvider {
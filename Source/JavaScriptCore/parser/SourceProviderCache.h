@@ -23,6 +23,9 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#ifndef SourceProviderCache_h
+#define SourceProviderCache_h
+
 #include <wtf/HashMap.h>
 #include <wtf/PassOwnPtr.h>
 
@@ -32,7 +35,17 @@ class SourceProviderCacheItem;
 
 class SourceProviderCache {
 public:
-    SourceProviderCache() : m_contentByteSize(0) {}
+    typedef HashMap<int, SourceProviderCacheItem*>::const_iterator const_iterator;
+
+    // Identifies the source text across runs, see PersistentParseCache.
+    struct SourceKey {
+        SourceKey() : length(0), hash(0), checkHash(0) { }
+        unsigned length;
+        unsigned hash;
+        unsigned checkHash;
+    };
+
+    SourceProviderCache() : m_contentByteSize(0), m_hasSourceKey(false) {}
     ~SourceProviderCache();
 
     void clear();
@@ -40,9 +53,20 @@ public:
     void add(int sourcePosition, PassOwnPtr<SourceProviderCacheItem>, unsigned size);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    const_iterator begin() const { return m_map.begin(); }
+    const_iterator end() const { return m_map.end(); }
+
+    bool hasSourceKey() const { return m_hasSourceKey; }
+    const SourceKey& sourceKey() const { return m_sourceKey; }
+    void setSourceKey(const SourceKey& sourceKey) { m_sourceKey = sourceKey; m_hasSourceKey = true; }
+
 private:
     HashMap<int, SourceProviderCacheItem*> m_map;
     unsigned m_contentByteSize;
+    SourceKey m_sourceKey;
+    bool m_hasSourceKey;
 };
 
 }
+
+#endif // SourceProviderCache_h
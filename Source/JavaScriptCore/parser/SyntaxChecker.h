@@ -113,6 +113,7 @@ public:
     static const bool CreatesAST = false;
     static const bool NeedsFreeVariableInfo = false;
     static const bool CanUseFunctionCache = true;
+    static const bool CanParseFunctionsEagerly = false;
 
     int createSourceElements() { return 1; }
     ExpressionType makeFunctionCallNode(int, int, int, int, int) { return CallExpr; }
@@ -147,6 +148,7 @@ public:
     ExpressionType createAssignResolve(const Identifier&, ExpressionType, bool, int, int, int) { return AssignmentExpr; }
     ExpressionType createFunctionExpr(const Identifier*, int, int, int, int, int, int) { return FunctionExpr; }
     int createFunctionBody(bool) { return 1; }
+    void setFunctionBodyData(int, int, SyntaxChecker&, IdentifierSet&, CodeFeatures) { }
     int createArguments() { return 1; }
     int createArguments(int) { return 1; }
     int createArgumentsList(int) { return 1; }
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ParseProfiler.h"
+
+namespace JSC {
+
+void ParseStatistics::add(const ParseStatistics& other)
+{
+    programParses += other.programParses;
+    preparsedFunctions += other.preparsedFunctions;
+    skippedFunctions += other.skippedFunctions;
+    eagerFunctions += other.eagerFunctions;
+    compiledFunctions += other.compiledFunctions;
+    preparsedBytes += other.preparsedBytes;
+    reparsedBytes += other.reparsedBytes;
+    programParseTime += other.programParseTime;
+    functionParseTime += other.functionParseTime;
+}
+
+ParseProfiler* ParseProfiler::s_sharedProfiler = 0;
+
+void ParseProfiler::setEnabled(bool enabled)
+{
+    if (enabled == !!s_sharedProfiler)
+        return;
+    if (enabled)
+        s_sharedProfiler = new ParseProfiler;
+    else {
+        delete s_sharedProfiler;
+        s_sharedProfiler = 0;
+    }
+}
+
+void ParseProfiler::didParse(const UString& url, const ParseStatistics& statistics)
+{
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        if (m_records[i].url == url) {
+            m_records[i].statistics.add(statistics);
+            return;
+        }
+    }
+    Record record;
+    record.url = url;
+    record.statistics = statistics;
+    m_records.append(record);
+}
+
+ParseStatistics ParseProfiler::totalStatistics() const
+{
+    ParseStatistics total;
+    for (size_t i = 0; i < m_records.size(); ++i)
+        total.add(m_records[i].statistics);
+    return total;
+}
+
+} // namespace JSC
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ParseProfiler_h
+#define ParseProfiler_h
+
+#include "UString.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+    // Counters kept for each SourceProvider. Function bodies are syntax
+    // checked while the code containing them is parsed (preparsed), and
+    // parsed again when the function is first compiled.
+    struct ParseStatistics {
+        ParseStatistics()
+            : programParses(0)
+            , preparsedFunctions(0)
+            , skippedFunctions(0)
+            , eagerFunctions(0)
+            , compiledFunctions(0)
+            , preparsedBytes(0)
+            , reparsedBytes(0)
+            , programParseTime(0)
+            , functionParseTime(0)
+        {
+        }
+
+        void add(const ParseStatistics&);
+
+        // Parses of program and eval code
+        unsigned programParses;
+        // Function bodies only syntax checked, they are parsed again on their
+        // first call
+        unsigned preparsedFunctions;
+        // Function bodies skipped with the boundaries kept in the
+        // SourceProviderCache
+        unsigned skippedFunctions;
+        // Function bodies parsed along with the program and compiled right
+        // away, see JSGlobalData::parseFunctionsEagerly
+        unsigned eagerFunctions;
+        // Function bodies parsed again to be compiled
+        unsigned compiledFunctions;
+        size_t preparsedBytes;
+        size_t reparsedBytes;
+        // In seconds
+        double programParseTime;
+        double functionParseTime;
+    };
+
+    // Gathers the statistics of the parses of all the sources by URL while it
+    // is enabled.
+    class ParseProfiler {
+        WTF_MAKE_NONCOPYABLE(ParseProfiler); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        struct Record {
+            UString url;
+            ParseStatistics statistics;
+        };
+
+        // Returns 0 when the profiler is not enabled
+        static ParseProfiler* profiler() { return s_sharedProfiler; }
+        static void setEnabled(bool);
+
+        void didParse(const UString& url, const ParseStatistics&);
+
+        const Vector<Record>& records() const { return m_records; }
+        ParseStatistics totalStatistics() const;
+
+    private:
+        ParseProfiler() { }
+
+        // There are few sources, a linear search is good enough
+        Vector<Record> m_records;
+
+        static ParseProfiler* s_sharedProfiler;
+    };
+
+} // namespace JSC
+
+#endif // ParseProfiler_h
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#include "CallFrame.h"
+#include "CodeBlock.h"
+#include "Executable.h"
+#include "JSGlobalData.h"
+#include "Profiler.h"
+#include "UStringConcatenate.h"
+#include <wtf/CurrentTime.h>
+
+using namespace std;
+
+namespace JSC {
+
+// Marks a frame entered from native code, whose caller's bytecode offset is
+// not known.
+static const unsigned unknownBytecodeOffset = UINT_MAX;
+
+SamplingProfiler::SamplingProfiler(JSGlobalData& globalData, unsigned interval)
+    : m_globalData(globalData)
+    , m_interval(interval)
+    , m_savedCheckInterval(0)
+    , m_sampleRequested(false)
+    , m_running(false)
+    , m_timerThread(0)
+    , m_sampleCount(0)
+    , m_droppedSampleCount(0)
+    , m_writeIndex(0)
+    , m_readIndex(0)
+{
+    StackNode root = { 0, 0, 0 };
+    m_stackNodes.append(root);
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    if (m_running)
+        stop();
+}
+
+void SamplingProfiler::start()
+{
+    ASSERT(!m_running);
+
+    // Have the script check for sample requests about as often as they are made.
+    TimeoutChecker& timeoutChecker = m_globalData.timeoutChecker;
+    m_savedCheckInterval = timeoutChecker.checkInterval();
+    timeoutChecker.setCheckInterval(max(1u, m_interval / 1000));
+    timeoutChecker.reset();
+
+    m_running = true;
+    m_timerThread = createThread(threadStartFunc, this, "JavaScriptCore::SamplingProfiler");
+}
+
+void SamplingProfiler::stop()
+{
+    ASSERT(m_running);
+    {
+        MutexLocker locker(m_timerLock);
+        m_running = false;
+        m_timerCondition.signal();
+    }
+    waitForThreadCompletion(m_timerThread, 0);
+
+    m_sampleRequested = false;
+    m_globalData.timeoutChecker.setCheckInterval(m_savedCheckInterval);
+    consumeSamples();
+}
+
+void* SamplingProfiler::threadStartFunc(void* profiler)
+{
+    static_cast<SamplingProfiler*>(profiler)->timerThreadMain();
+    return 0;
+}
+
+void SamplingProfiler::timerThreadMain()
+{
+    MutexLocker locker(m_timerLock);
+    while (m_running) {
+        m_timerCondition.timedWait(m_timerLock, currentTime() + m_interval / 1000000.0);
+        if (!m_running)
+            break;
+        m_sampleRequested = true;
+        consumeSamples();
+    }
+}
+
+// Returns the offset of the call a frame returns to in its caller, modeled
+// on Interpreter::retrieveLastCaller.
+static unsigned callerBytecodeOffset(CallFrame* callFrame, CodeBlock* callerCodeBlock)
+{
+    unsigned bytecodeOffset = 0;
+#if ENABLE(INTERPRETER)
+    if (!callFrame->globalData().canUseJIT())
+        bytecodeOffset = callerCodeBlock->bytecodeOffset(callFrame->returnVPC());
+#if ENABLE(JIT)
+    else
+        bytecodeOffset = callerCodeBlock->bytecodeOffset(callFrame->returnPC());
+#endif
+#else
+    bytecodeOffset = callerCodeBlock->bytecodeOffset(callFrame->returnPC());
+#endif
+    return bytecodeOffset ? bytecodeOffset - 1 : 0;
+}
+
+void SamplingProfiler::takeSample(ExecState* exec, unsigned bytecodeOffset)
+{
+    m_sampleRequested = false;
+
+    Vector<unsigned, maximumStackDepth> frames;
+    for (CallFrame* callFrame = exec; callFrame && frames.size() < maximumStackDepth; ) {
+        frames.append(frameID(callFrame, callFrame->codeBlock(), bytecodeOffset));
+
+        CallFrame* callerFrame = callFrame->callerFrame();
+        if (callerFrame->hasHostCallFrameFlag()) {
+            // Called from native code, the caller is a host function or a
+            // frame that is running a native helper, like a getter call.
+            callerFrame = callerFrame->removeHostCallFrameFlag();
+            bytecodeOffset = unknownBytecodeOffset;
+        } else if (CodeBlock* callerCodeBlock = callerFrame->codeBlock())
+            bytecodeOffset = callerBytecodeOffset(callFrame, callerCodeBlock);
+        callFrame = callerFrame;
+    }
+
+    ++m_sampleCount;
+    writeSample(frames);
+}
+
+unsigned SamplingProfiler::frameID(ExecState* callFrame, CodeBlock* codeBlock, unsigned bytecodeOffset)
+{
+    CallIdentifier identifier;
+    if (!codeBlock)
+        identifier = Profiler::createCallIdentifier(callFrame, callFrame->callee(), "", 0);
+    else {
+        ScriptExecutable* executable = codeBlock->ownerExecutable();
+        int lineNumber = bytecodeOffset < codeBlock->instructionCount() ? codeBlock->lineNumberForBytecodeOffset(bytecodeOffset) : executable->lineNo();
+        if (codeBlock->codeType() == EvalCode)
+            identifier = CallIdentifier("(eval)", executable->sourceURL(), lineNumber);
+        else {
+            JSValue function = codeBlock->codeType() == FunctionCode ? JSValue(callFrame->callee()) : JSValue();
+            identifier = Profiler::createCallIdentifier(callFrame, function, executable->sourceURL(), lineNumber);
+            // Functions are otherwise identified by the line they start on.
+            identifier.m_lineNumber = lineNumber;
+        }
+    }
+    // CallIdentifier::Hash needs both strings.
+    if (identifier.m_name.isNull())
+        identifier.m_name = "(unknown)";
+
+    pair<HashMap<CallIdentifier, unsigned>::iterator, bool> result = m_frameIDs.add(identifier, m_frames.size() + 1);
+    if (result.second)
+        m_frames.append(identifier);
+    return result.first->second;
+}
+
+void SamplingProfiler::writeSample(const Vector<unsigned, maximumStackDepth>& frames)
+{
+    unsigned writeIndex = m_writeIndex;
+    if (bufferSize - (writeIndex - m_readIndex) < frames.size() + 1) {
+        ++m_droppedSampleCount;
+        return;
+    }
+
+    m_buffer[writeIndex++ & bufferMask] = frames.size();
+    for (size_t i = 0; i < frames.size(); ++i)
+        m_buffer[writeIndex++ & bufferMask] = frames[i];
+
+    // The timer thread may read the sample as soon as it sees the new index.
+    memoryBarrier();
+    m_writeIndex = writeIndex;
+}
+
+void SamplingProfiler::consumeSamples()
+{
+    unsigned readIndex = m_readIndex;
+    unsigned writeIndex = m_writeIndex;
+    memoryBarrier();
+
+    while (readIndex != writeIndex) {
+        unsigned frameCount = m_buffer[readIndex++ & bufferMask];
+        unsigned end = readIndex + frameCount;
+
+        // The frames are stored innermost first, the tree is rooted at the outermost.
+        unsigned node = 0;
+        for (unsigned i = end; i != readIndex; ) {
+            unsigned frame = m_buffer[--i & bufferMask];
+            pair<HashMap<pair<unsigned, unsigned>, unsigned>::iterator, bool> result = m_childNodes.add(make_pair(node, frame), m_stackNodes.size());
+            if (result.second) {
+                StackNode child = { node, frame, 0 };
+                m_stackNodes.append(child);
+            }
+            node = result.first->second;
+        }
+        ++m_stackNodes[node].samples;
+        readIndex = end;
+    }
+
+    // The script may overwrite the entries as soon as it sees the new index.
+    memoryBarrier();
+    m_readIndex = readIndex;
+}
+
+void SamplingProfiler::dumpFoldedStacks(FILE* file) const
+{
+    ASSERT(!m_running);
+
+    Vector<CString> names(m_frames.size());
+    for (size_t i = 0; i < m_frames.size(); ++i) {
+        const CallIdentifier& frame = m_frames[i];
+        CString name = frame.m_url.isEmpty() ? frame.m_name.utf8() : makeUString(frame.m_name, " ", frame.m_url, ":", UString::number(frame.m_lineNumber)).utf8();
+        // Semicolons separate the frames, and lines the stacks.
+        for (char* c = name.mutableData(); *c; ++c) {
+            if (*c == ';' || *c == '\n')
+                *c = ' ';
+        }
+        names[i] = name;
+    }
+
+    Vector<unsigned, 32> stack;
+    for (size_t i = 1; i < m_stackNodes.size(); ++i) {
+        if (!m_stackNodes[i].samples)
+            continue;
+        stack.shrink(0);
+        for (unsigned node = i; node; node = m_stackNodes[node].parent)
+            stack.append(m_stackNodes[node].frame);
+        for (size_t j = stack.size(); j--; )
+            fprintf(file, j + 1 == stack.size() ? "%s" : ";%s", names[stack[j] - 1].data());
+        fprintf(file, " %u\n", m_stackNodes[i].samples);
+    }
+}
+
+} // namespace JSC
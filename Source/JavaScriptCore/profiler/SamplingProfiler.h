@@ -0,0 +1,133 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#include "CallIdentifier.h"
+#include <stdio.h>
+#include <wtf/Atomics.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+    class CodeBlock;
+    class ExecState;
+    class JSGlobalData;
+
+    // Samples the stacks of the script running on a JSGlobalData at a fixed
+    // interval, and attributes each frame to the line of the bytecode it was
+    // executing. Unlike the SamplingTool it can be enabled at run time.
+    //
+    // Frames can only be walked safely by the thread running the script, so
+    // the timer thread just requests a sample, which is taken at the next
+    // timeout check (a loop back edge, or the entry of a function compiled
+    // while the profiler was enabled). The samples are passed back through a
+    // ring buffer, which the timer thread drains into a tree of stacks.
+    class SamplingProfiler {
+        WTF_MAKE_NONCOPYABLE(SamplingProfiler); WTF_MAKE_FAST_ALLOCATED;
+    public:
+        static const unsigned defaultInterval = 1000; // In microseconds
+
+        SamplingProfiler(JSGlobalData&, unsigned interval = defaultInterval);
+        ~SamplingProfiler();
+
+        void start();
+        void stop();
+
+        bool sampleRequested() const { return m_sampleRequested; }
+        // Called on the thread running the script, with the bytecode offset
+        // the top frame is executing.
+        void takeSample(ExecState*, unsigned bytecodeOffset);
+
+        unsigned sampleCount() const { return m_sampleCount; }
+        unsigned droppedSampleCount() const { return m_droppedSampleCount; }
+
+        // Writes one line per distinct stack, the frames from the outermost
+        // separated by semicolons and followed by the number of samples, the
+        // input format of flame graph tools. Only valid once stopped.
+        void dumpFoldedStacks(FILE*) const;
+
+    private:
+        static const unsigned maximumStackDepth = 256;
+        static const unsigned bufferSize = 1 << 16; // Must be a power of two
+        static const unsigned bufferMask = bufferSize - 1;
+
+        unsigned frameID(ExecState*, CodeBlock*, unsigned bytecodeOffset);
+        void writeSample(const Vector<unsigned, maximumStackDepth>& frames);
+
+        static void* threadStartFunc(void*);
+        void timerThreadMain();
+        void consumeSamples();
+#if !HAVE(MEMORY_BARRIER)
+        // Taking and releasing a lock orders the memory accesses around it.
+        void memoryBarrier() { MutexLocker locker(m_bufferLock); }
+#endif
+
+        JSGlobalData& m_globalData;
+        unsigned m_interval;
+        unsigned m_savedCheckInterval;
+
+        // Written by the timer thread, read by the thread running the script.
+        volatile bool m_sampleRequested;
+        volatile bool m_running;
+        ThreadIdentifier m_timerThread;
+        Mutex m_timerLock;
+        ThreadCondition m_timerCondition;
+
+        // Frames are identified by 1-based indices into m_frames, which only
+        // the thread running the script adds to.
+        HashMap<CallIdentifier, unsigned> m_frameIDs;
+        Vector<CallIdentifier> m_frames;
+        unsigned m_sampleCount;
+        unsigned m_droppedSampleCount;
+
+        // Each sample is its frame count followed by the frame IDs, innermost
+        // first. The thread running the script only advances m_writeIndex,
+        // the timer thread only advances m_readIndex; both wrap around.
+        unsigned m_buffer[bufferSize];
+        volatile unsigned m_writeIndex;
+        volatile unsigned m_readIndex;
+#if !HAVE(MEMORY_BARRIER)
+        Mutex m_bufferLock;
+#endif
+
+        // The stacks read back so far, as a tree rooted at node 0. Children
+        // are found by (parent node, frame ID).
+        struct StackNode {
+            unsigned parent;
+            unsigned frame;
+            unsigned samples;
+        };
+        Vector<StackNode> m_stackNodes;
+        HashMap<std::pair<unsigned, unsigned>, unsigned> m_childNodes;
+    };
+
+} // namespace JSC
+
+#endif // SamplingProfiler_h
@@ -265,6 +265,28 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncToLocaleString(ExecState* exec)
     return JSValue::encode(strBuffer.build(exec));
 }
 
+// Formats int32 elements straight into the builder, rather than through a temporary UString.
+static inline void appendJoinElement(ExecState* exec, JSStringBuilder& builder, JSValue element)
+{
+    if (element.isInt32()) {
+        int32_t value = element.asInt32();
+        UChar buffer[1 + sizeof(value) * 3];
+        UChar* end = buffer + WTF_ARRAY_LENGTH(buffer);
+        UChar* p = end;
+        unsigned magnitude = value < 0 ? -static_cast<unsigned>(value) : static_cast<unsigned>(value);
+        do {
+            *--p = static_cast<UChar>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0)
+            *--p = '-';
+        builder.append(p, end - p);
+        return;
+    }
+    if (!element.isUndefinedOrNull())
+        builder.append(element.toString(exec));
+}
+
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
 {
     JSObject* thisObj = exec->hostThisValue().toThisObject(exec);
@@ -289,9 +311,7 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
         if (length) {
             if (!array->canGetIndex(k)) 
                 goto skipFirstLoop;
-            JSValue element = array->getIndex(k);
-            if (!element.isUndefinedOrNull())
-                strBuffer.append(element.toString(exec));
+            appendJoinElement(exec, strBuffer, array->getIndex(k));
             k++;
         }
 
@@ -300,18 +320,14 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncJoin(ExecState* exec)
                 if (!array->canGetIndex(k))
                     break;
                 strBuffer.append(',');
-                JSValue element = array->getIndex(k);
-                if (!element.isUndefinedOrNull())
-                    strBuffer.append(element.toString(exec));
+                appendJoinElement(exec, strBuffer, array->getIndex(k));
             }
         } else {
             for (; k < length; k++) {
                 if (!array->canGetIndex(k))
                     break;
                 strBuffer.append(separator);
-                JSValue element = array->getIndex(k);
-                if (!element.isUndefinedOrNull())
-                    strBuffer.append(element.toString(exec));
+                appendJoinElement(exec, strBuffer, array->getIndex(k));
             }
         }
     }
@@ -1091,6 +1107,19 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 
     unsigned index = argumentClampedIndexFromStartOrEnd(exec, 1, length);
     JSValue searchElement = exec->argument(0);
+
+    // An int32 array can be scanned comparing raw integers, up to the first hole.
+    if (searchElement.isInt32() && isJSArray(&exec->globalData(), thisObj)) {
+        JSArray* array = asArray(thisObj);
+        if (array->hasOnlyInt32Values()) {
+            int32_t search = searchElement.asInt32();
+            for (; index < length && array->canGetIndex(index); ++index) {
+                if (array->getIndex(index).asInt32() == search)
+                    return JSValue::encode(jsNumber(index));
+            }
+        }
+    }
+
     for (; index < length; ++index) {
         JSValue e = getProperty(exec, thisObj, index);
         if (!e)
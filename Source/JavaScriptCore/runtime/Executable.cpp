@@ -237,6 +237,13 @@ JSObject* FunctionExecutable::compileForCallInternal(ExecState* exec, ScopeChain
         ASSERT(exception);
         return exception;
     }
+    return compileForCallInternal(body.get(), scopeChainNode);
+}
+
+JSObject* FunctionExecutable::compileForCallInternal(FunctionBodyNode* body, ScopeChainNode* scopeChainNode)
+{
+    JSObject* exception = 0;
+    JSGlobalData* globalData = scopeChainNode->globalData;
     if (m_forceUsesArguments)
         body->setUsesArguments();
     body->finishParsing(m_parameters, m_name);
@@ -246,7 +253,7 @@ JSObject* FunctionExecutable::compileForCallInternal(ExecState* exec, ScopeChain
 
     ASSERT(!m_codeBlockForCall);
     m_codeBlockForCall = adoptPtr(new FunctionCodeBlock(this, FunctionCode, globalObject, source().provider(), source().startOffset(), false));
-    OwnPtr<BytecodeGenerator> generator(adoptPtr(new BytecodeGenerator(body.get(), scopeChainNode, m_codeBlockForCall->symbolTable(), m_codeBlockForCall.get())));
+    OwnPtr<BytecodeGenerator> generator(adoptPtr(new BytecodeGenerator(body, scopeChainNode, m_codeBlockForCall->symbolTable(), m_codeBlockForCall.get())));
     if ((exception = generator->generate())) {
         m_codeBlockForCall.clear();
         body->destroyData();
@@ -261,8 +268,8 @@ JSObject* FunctionExecutable::compileForCallInternal(ExecState* exec, ScopeChain
     body->destroyData();
 
 #if ENABLE(JIT)
-    if (exec->globalData().canUseJIT()) {
-        bool dfgCompiled = tryDFGCompile(&exec->globalData(), m_codeBlockForCall.get(), m_jitCodeForCall, m_jitCodeForCallWithArityCheck);
+    if (globalData->canUseJIT()) {
+        bool dfgCompiled = tryDFGCompile(globalData, m_codeBlockForCall.get(), m_jitCodeForCall, m_jitCodeForCallWithArityCheck);
         if (!dfgCompiled)
             m_jitCodeForCall = JIT::compile(scopeChainNode->globalData, m_codeBlockForCall.get(), &m_jitCodeForCallWithArityCheck);
 
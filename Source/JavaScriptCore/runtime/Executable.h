@@ -331,6 +331,17 @@ namespace JSC {
             return error;
         }
 
+        // Used for the bodies parsed along with the enclosing program, see
+        // BytecodeGenerator::emitNewFunctionExpression
+        JSObject* compileForCall(FunctionBodyNode* body, ScopeChainNode* scopeChainNode)
+        {
+            JSObject* error = 0;
+            if (!m_codeBlockForCall)
+                error = compileForCallInternal(body, scopeChainNode);
+            ASSERT(!error == !!m_codeBlockForCall);
+            return error;
+        }
+
         bool isGeneratedForCall() const
         {
             return m_codeBlockForCall;
@@ -379,6 +390,7 @@ namespace JSC {
         FunctionExecutable(ExecState*, const Identifier& name, const SourceCode&, bool forceUsesArguments, FunctionParameters*, bool, int firstLine, int lastLine);
 
         JSObject* compileForCallInternal(ExecState*, ScopeChainNode*);
+        JSObject* compileForCallInternal(FunctionBodyNode*, ScopeChainNode*);
         JSObject* compileForConstructInternal(ExecState*, ScopeChainNode*);
         
         static const unsigned StructureFlags = OverridesMarkChildren | ScriptExecutable::StructureFlags;
@@ -159,7 +159,7 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, unsigned initia
     else
         initialCapacity = min(BASE_VECTOR_LEN, MIN_SPARSE_ARRAY_INDEX);
     
-    m_storage = static_cast<ArrayStorage*>(fastMalloc(storageSize(initialCapacity)));
+    m_storage = static_cast<ArrayStorage*>(Heap::heap(this)->allocateStorage(storageSize(initialCapacity)));
     m_storage->m_allocBase = m_storage;
     m_storage->m_length = initialLength;
     m_indexBias = 0;
@@ -167,6 +167,8 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, unsigned initia
     m_storage->m_sparseValueMap = 0;
     m_storage->subclassData = 0;
     m_storage->reportedMapCapacity = 0;
+    m_storage->m_hasDoubles = false;
+    m_storage->m_hasNonNumbers = false;
 
     if (creationMode == CreateCompact) {
 #if CHECK_ARRAY_CONSISTENCY
@@ -187,7 +189,7 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, unsigned initia
 
     checkConsistency();
     
-    Heap::heap(this)->reportExtraMemoryCost(storageSize(initialCapacity));
+    Heap::heap(this)->reportStorageCost(storageSize(initialCapacity), storageSize(initialCapacity));
 }
 
 JSArray::JSArray(JSGlobalData& globalData, Structure* structure, const ArgList& list)
@@ -205,7 +207,7 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, const ArgList&
     else
         initialStorage = initialCapacity;
     
-    m_storage = static_cast<ArrayStorage*>(fastMalloc(storageSize(initialStorage)));
+    m_storage = static_cast<ArrayStorage*>(Heap::heap(this)->allocateStorage(storageSize(initialStorage)));
     m_storage->m_allocBase = m_storage;
     m_indexBias = 0;
     m_storage->m_length = initialCapacity;
@@ -214,6 +216,8 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, const ArgList&
     m_storage->m_sparseValueMap = 0;
     m_storage->subclassData = 0;
     m_storage->reportedMapCapacity = 0;
+    m_storage->m_hasDoubles = false;
+    m_storage->m_hasNonNumbers = false;
 #if CHECK_ARRAY_CONSISTENCY
     m_storage->m_inCompactInitialization = false;
 #endif
@@ -221,14 +225,16 @@ JSArray::JSArray(JSGlobalData& globalData, Structure* structure, const ArgList&
     size_t i = 0;
     WriteBarrier<Unknown>* vector = m_storage->m_vector;
     ArgList::const_iterator end = list.end();
-    for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i)
+    for (ArgList::const_iterator it = list.begin(); it != end; ++it, ++i) {
         vector[i].set(globalData, this, *it);
+        recordValueKind(m_storage, *it);
+    }
     for (; i < initialStorage; i++)
         vector[i].clear();
 
     checkConsistency();
 
-    Heap::heap(this)->reportExtraMemoryCost(storageSize(initialStorage));
+    Heap::heap(this)->reportStorageCost(storageSize(initialStorage), storageSize(initialStorage));
 }
 
 JSArray::~JSArray()
@@ -237,7 +243,7 @@ JSArray::~JSArray()
     checkConsistency(DestructorConsistencyCheck);
 
     delete m_storage->m_sparseValueMap;
-    fastFree(m_storage->m_allocBase);
+    Heap::heap(this)->freeStorage(m_storage->m_allocBase);
 }
 
 bool JSArray::getOwnPropertySlot(ExecState* exec, unsigned i, PropertySlot& slot)
@@ -353,6 +359,7 @@ void JSArray::put(ExecState* exec, unsigned i, JSValue value)
     }
 
     if (i < m_vectorLength) {
+        recordValueKind(storage, value);
         WriteBarrier<Unknown>& valueSlot = storage->m_vector[i];
         if (valueSlot) {
             valueSlot.set(exec->globalData(), this, value);
@@ -374,6 +381,10 @@ NEVER_INLINE void JSArray::putSlowCase(ExecState* exec, unsigned i, JSValue valu
     
     SparseArrayValueMap* map = storage->m_sparseValueMap;
 
+    // Recorded up front, since the storage header is carried over when the vector is reallocated.
+    // An index above MAX_ARRAY_INDEX goes to the property map instead, which is merely conservative.
+    recordValueKind(storage, value);
+
     if (i >= MIN_SPARSE_ARRAY_INDEX) {
         if (i > MAX_ARRAY_INDEX) {
             PutPropertySlot slot;
@@ -439,9 +450,8 @@ NEVER_INLINE void JSArray::putSlowCase(ExecState* exec, unsigned i, JSValue valu
         }
     }
 
-    void* baseStorage = storage->m_allocBase;
-    
-    if (!tryFastRealloc(baseStorage, storageSize(newVectorLength + m_indexBias)).getValue(baseStorage)) {
+    void* baseStorage = Heap::heap(this)->tryReallocateStorage(storage->m_allocBase, storageSize(m_vectorLength + m_indexBias), storageSize(newVectorLength + m_indexBias));
+    if (!baseStorage) {
         throwOutOfMemoryError(exec);
         return;
     }
@@ -475,7 +485,7 @@ NEVER_INLINE void JSArray::putSlowCase(ExecState* exec, unsigned i, JSValue valu
 
     checkConsistency();
 
-    Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+    Heap::heap(this)->reportStorageCost(storageSize(newVectorLength + m_indexBias), storageSize(newVectorLength) - storageSize(vectorLength));
 }
 
 bool JSArray::deleteProperty(ExecState* exec, const Identifier& propertyName)
@@ -592,9 +602,8 @@ bool JSArray::increaseVectorLength(unsigned newLength)
     ASSERT(newLength > vectorLength);
     ASSERT(newLength <= MAX_STORAGE_VECTOR_INDEX);
     unsigned newVectorLength = getNewVectorLength(newLength);
-    void* baseStorage = storage->m_allocBase;
-
-    if (!tryFastRealloc(baseStorage, storageSize(newVectorLength + m_indexBias)).getValue(baseStorage))
+    void* baseStorage = Heap::heap(this)->tryReallocateStorage(storage->m_allocBase, storageSize(vectorLength + m_indexBias), storageSize(newVectorLength + m_indexBias));
+    if (!baseStorage)
         return false;
 
     storage = m_storage = reinterpret_cast_ptr<ArrayStorage*>(static_cast<char*>(baseStorage) + m_indexBias * sizeof(JSValue));
@@ -606,7 +615,7 @@ bool JSArray::increaseVectorLength(unsigned newLength)
 
     m_vectorLength = newVectorLength;
     
-    Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+    Heap::heap(this)->reportStorageCost(storageSize(newVectorLength + m_indexBias), storageSize(newVectorLength) - storageSize(vectorLength));
 
     return true;
 }
@@ -623,7 +632,7 @@ bool JSArray::increaseVectorPrefixLength(unsigned newLength)
     ASSERT(newLength <= MAX_STORAGE_VECTOR_INDEX);
     unsigned newVectorLength = getNewVectorLength(newLength);
 
-    void* newBaseStorage = fastMalloc(storageSize(newVectorLength + m_indexBias));
+    void* newBaseStorage = Heap::heap(this)->tryAllocateStorage(storageSize(newVectorLength + m_indexBias));
     if (!newBaseStorage)
         return false;
     
@@ -637,9 +646,9 @@ bool JSArray::increaseVectorPrefixLength(unsigned newLength)
     m_storage->m_allocBase = newBaseStorage;
     m_vectorLength = newLength;
     
-    fastFree(storage->m_allocBase);
+    Heap::heap(this)->freeStorage(storage->m_allocBase);
 
-    Heap::heap(this)->reportExtraMemoryCost(storageSize(newVectorLength) - storageSize(vectorLength));
+    Heap::heap(this)->reportStorageCost(storageSize(m_vectorLength + m_indexBias), storageSize(newVectorLength) - storageSize(vectorLength));
     
     return true;
 }
@@ -679,10 +688,22 @@ void JSArray::setLength(unsigned newLength)
                 storage->m_sparseValueMap = 0;
             }
         }
+
+        // Give the pages of the end of a large vector back to the OS.
+        if (newLength < m_vectorLength / 2 && storageSize(m_vectorLength + m_indexBias) >= LargeObjectSpace::minimumAllocationSize) {
+            m_vectorLength = newLength;
+            Heap::heap(this)->shrinkStorage(storage->m_allocBase, storageSize(m_vectorLength + m_indexBias));
+        }
     }
 
     storage->m_length = newLength;
 
+    // An emptied array, such as one reused as a buffer, starts over as an int32 array.
+    if (!newLength && !storage->m_numValuesInVector && !storage->m_sparseValueMap) {
+        storage->m_hasDoubles = false;
+        storage->m_hasNonNumbers = false;
+    }
+
     checkConsistency();
 }
 
@@ -738,6 +759,7 @@ void JSArray::push(ExecState* exec, JSValue value)
 
     if (storage->m_length < m_vectorLength) {
         storage->m_vector[storage->m_length].set(exec->globalData(), this, value);
+        recordValueKind(storage, value);
         ++storage->m_numValuesInVector;
         ++storage->m_length;
         checkConsistency();
@@ -750,6 +772,7 @@ void JSArray::push(ExecState* exec, JSValue value)
             if (increaseVectorLength(storage->m_length + 1)) {
                 storage = m_storage;
                 storage->m_vector[storage->m_length].set(exec->globalData(), this, value);
+                recordValueKind(storage, value);
                 ++storage->m_numValuesInVector;
                 ++storage->m_length;
                 checkConsistency();
@@ -869,6 +892,39 @@ static int compareNumbersForQSort(const void* a, const void* b)
     return (da > db) - (da < db);
 }
 
+// Sorts values the array knows to be int32s or numbers as unboxed ints or doubles, comparing
+// them directly rather than through a callback that unboxes both operands on every call.
+static bool sortInt32Values(WriteBarrier<Unknown>* vector, size_t size)
+{
+    Vector<int32_t> values(size);
+    if (!values.begin())
+        return false;
+    for (size_t i = 0; i < size; ++i)
+        values[i] = vector[i].get().asInt32();
+    std::sort(values.begin(), values.end());
+    for (size_t i = 0; i < size; ++i)
+        vector[i].setWithoutWriteBarrier(jsNumber(values[i]));
+    return true;
+}
+
+static bool sortNumberValues(WriteBarrier<Unknown>* vector, size_t size)
+{
+    Vector<double> values(size);
+    if (!values.begin())
+        return false;
+    for (size_t i = 0; i < size; ++i) {
+        double value = vector[i].get().uncheckedGetNumber();
+        // NaN is unordered, which std::sort cannot cope with.
+        if (isnan(value))
+            return false;
+        values[i] = value;
+    }
+    std::sort(values.begin(), values.end());
+    for (size_t i = 0; i < size; ++i)
+        vector[i].setWithoutWriteBarrier(jsNumber(values[i]));
+    return true;
+}
+
 static int compareByStringPairForQSort(const void* a, const void* b)
 {
     const ValueStringPair* va = static_cast<const ValueStringPair*>(a);
@@ -889,17 +945,25 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
     if (!lengthNotIncludingUndefined)
         return;
         
-    bool allValuesAreNumbers = true;
     size_t size = storage->m_numValuesInVector;
-    for (size_t i = 0; i < size; ++i) {
-        if (!storage->m_vector[i].isNumber()) {
-            allValuesAreNumbers = false;
-            break;
+    if (!hasOnlyNumberValues()) {
+        bool allValuesAreNumbers = true;
+        for (size_t i = 0; i < size; ++i) {
+            if (!storage->m_vector[i].isNumber()) {
+                allValuesAreNumbers = false;
+                break;
+            }
         }
+
+        if (!allValuesAreNumbers)
+            return sort(exec, compareFunction, callType, callData);
     }
 
-    if (!allValuesAreNumbers)
-        return sort(exec, compareFunction, callType, callData);
+    // Having been compacted, the vector holds no holes, so the unboxed kernels can read every value directly.
+    if (hasOnlyInt32Values() ? sortInt32Values(storage->m_vector, size) : sortNumberValues(storage->m_vector, size)) {
+        checkConsistency(SortConsistencyCheck);
+        return;
+    }
 
     // For numeric comparison, which is fast, qsort is faster than mergesort. We
     // also don't require mergesort's stability, since there's no user visible
@@ -41,6 +41,10 @@ namespace JSC {
         void* subclassData; // A JSArray subclass can use this to fill the vector lazily.
         void* m_allocBase; // Pointer to base address returned by malloc().  Keeping this pointer does eliminate false positives from the leak detector.
         size_t reportedMapCapacity;
+        // Set once a double, or a value that is not a number, has been stored in the vector or the sparse map.
+        // Neither is cleared while the array holds values, so the JIT can record a store with a plain store32.
+        unsigned m_hasDoubles;
+        unsigned m_hasNonNumbers;
 #if CHECK_ARRAY_CONSISTENCY
         bool m_inCompactInitialization;
 #endif
@@ -108,6 +112,7 @@ namespace JSC {
                     storage->m_length = i + 1;
             }
             x.set(globalData, this, v);
+            recordValueKind(m_storage, v);
         }
         
         void uncheckedSetIndex(JSGlobalData& globalData, unsigned i, JSValue v)
@@ -118,8 +123,14 @@ namespace JSC {
             ASSERT(storage->m_inCompactInitialization);
 #endif
             storage->m_vector[i].set(globalData, this, v);
+            recordValueKind(storage, v);
         }
 
+        // Every value in the array is an int32 (or a number), so it can be read without type checks.
+        // Holes are not values, and still have to be checked for.
+        bool hasOnlyInt32Values() const { return !m_storage->m_hasDoubles && !m_storage->m_hasNonNumbers; }
+        bool hasOnlyNumberValues() const { return !m_storage->m_hasNonNumbers; }
+
         void fillArgList(ExecState*, MarkedArgumentBuffer&);
         void copyToRegisters(ExecState*, Register*, uint32_t);
 
@@ -161,6 +172,16 @@ namespace JSC {
         
         unsigned compactForSorting();
 
+        static void recordValueKind(ArrayStorage* storage, JSValue value)
+        {
+            if (value.isInt32())
+                return;
+            if (value.isDouble())
+                storage->m_hasDoubles = true;
+            else
+                storage->m_hasNonNumbers = true;
+        }
+
         enum ConsistencyCheckType { NormalConsistencyCheck, DestructorConsistencyCheck, SortConsistencyCheck };
         void checkConsistency(ConsistencyCheckType = NormalConsistencyCheck);
 
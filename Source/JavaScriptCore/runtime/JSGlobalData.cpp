@@ -50,7 +50,9 @@
 #include "Lookup.h"
 #include "Nodes.h"
 #include "Parser.h"
+#include "PersistentParseCache.h"
 #include "RegExpCache.h"
+#include "SamplingProfiler.h"
 #include "StrictEvalActivation.h"
 #include <wtf/WTFThreadData.h>
 #if ENABLE(REGEXP_TRACING)
@@ -160,6 +162,7 @@ JSGlobalData::JSGlobalData(GlobalDataType globalDataType, ThreadStackType thread
     , emptyList(new MarkedArgumentBuffer)
     , lexer(new Lexer(this))
     , parser(new Parser)
+    , parseFunctionsEagerly(true)
     , interpreter(0)
     , heap(this)
     , globalObjectCount(0)
@@ -269,6 +272,9 @@ JSGlobalData::~JSGlobalData()
 {
     // By the time this is destroyed, heap.destroy() must already have been called.
 
+    // The profiler holds strings that may be identifiers, which have to go before the identifier table.
+    samplingProfiler.clear();
+
     delete interpreter;
 #ifndef NDEBUG
     // Zeroing out to make the behavior more predictable when someone attempts to use a deleted instance.
@@ -429,6 +435,7 @@ void JSGlobalData::dumpRegExpTrace()
             (*iter)->printTraceData();
 
         printf("%d Regular Expressions\n", reCount);
+        printf("%u compiled by the JIT, %u fell back to the interpreter\n", m_regExpCache->jitCompiledCount(), m_regExpCache->interpreterFallbackCount());
     }
     
     m_rtTraceList->clear();
@@ -66,7 +66,9 @@ namespace JSC {
     class Lexer;
     class NativeExecutable;
     class Parser;
+    class PersistentParseCache;
     class RegExpCache;
+    class SamplingProfiler;
     class Stringifier;
     class Structure;
     class UString;
@@ -181,6 +183,23 @@ namespace JSC {
         const MarkedArgumentBuffer* emptyList; // Lists are supposed to be allocated on the stack to have their elements properly marked, which is not the case here - but this list has nothing to mark.
         SmallStrings smallStrings;
         NumericStrings numericStrings;
+
+        // Substrings sharing the buffer of a large string, see JSString::releaseSubstringBuffers().
+        Vector<JSString*> sharedSubstrings;
+        struct SubstringStatistics {
+            SubstringStatistics()
+                : copiedSubstrings(0)
+                , trackedSubstrings(0)
+                , releasedBuffers(0)
+                , releasedBufferBytes(0)
+            {
+            }
+            size_t copiedSubstrings;
+            size_t trackedSubstrings;
+            size_t releasedBuffers;
+            size_t releasedBufferBytes;
+        };
+        SubstringStatistics substringStatistics;
         DateInstanceCache dateInstanceCache;
         
 #if ENABLE(ASSEMBLER)
@@ -205,6 +224,11 @@ namespace JSC {
 
         Lexer* lexer;
         Parser* parser;
+        // Function boundaries kept across runs, set by the embedder
+        OwnPtr<PersistentParseCache> persistentParseCache;
+        // Parenthesized function expressions of program code are parsed and
+        // compiled along with the program, see JSParser::shouldParseFunctionEagerly
+        bool parseFunctionsEagerly;
         Interpreter* interpreter;
 #if ENABLE(JIT)
         OwnPtr<JITThunks> jitStubs;
@@ -217,6 +241,9 @@ namespace JSC {
         NativeExecutable* getHostFunction(NativeFunction);
 
         TimeoutChecker timeoutChecker;
+        // Samples the stacks of the running script while it is started, set
+        // by the embedder
+        OwnPtr<SamplingProfiler> samplingProfiler;
         Terminator terminator;
         Heap heap;
 
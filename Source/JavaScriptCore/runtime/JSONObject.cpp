@@ -36,6 +36,7 @@
 #include "LocalScope.h"
 #include "Lookup.h"
 #include "PropertyNameArray.h"
+#include "Strong.h"
 #include "UStringBuilder.h"
 #include "UStringConcatenate.h"
 #include <wtf/MathExtras.h>
@@ -92,6 +93,8 @@ private:
 
     private:
         Local<JSObject> m_object;
+        // Set while the property at index i of m_propertyNames can be read from offset i.
+        Local<Structure> m_structure;
         const bool m_isArray;
         bool m_isJSArray;
         unsigned m_index;
@@ -101,6 +104,14 @@ private:
 
     friend class Holder;
 
+    struct CachedPropertyNames {
+        Strong<Structure> structure;
+        RefPtr<PropertyNameArrayData> propertyNames;
+    };
+    static const unsigned propertyNamesCacheSize = 4;
+
+    PropertyNameArrayData* propertyNamesInStorageOrder(JSObject*);
+
     static void appendQuotedString(UStringBuilder&, const UString&);
 
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
@@ -124,6 +135,9 @@ private:
     Vector<Holder, 16> m_holderStack;
     UString m_repeatedGap;
     UString m_indent;
+
+    CachedPropertyNames m_propertyNamesCache[propertyNamesCacheSize];
+    unsigned m_nextPropertyNamesCacheEntry;
 };
 
 // ------------------------------ helper functions --------------------------------
@@ -204,6 +218,7 @@ Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const
     , m_arrayReplacerPropertyNames(exec)
     , m_replacerCallType(CallTypeNone)
     , m_gap(gap(exec, space.get()))
+    , m_nextPropertyNamesCacheEntry(0)
 {
     if (!m_replacer.isObject())
         return;
@@ -466,8 +481,37 @@ inline void Stringifier::startNewLine(UStringBuilder& builder) const
     builder.append(m_indent);
 }
 
+// Plain objects whose properties are all enumerable data properties added by
+// transitions store the property enumerated at index i at offset i, which is what
+// lets for-in cache its enumeration per Structure as well (see JSPropertyNameIterator).
+// Their property names can be shared between all objects with the same Structure.
+PropertyNameArrayData* Stringifier::propertyNamesInStorageOrder(JSObject* object)
+{
+    Structure* structure = object->structure();
+    if (object->classInfo() != &JSObject::s_info || structure->isDictionary() || structure->hasNonEnumerableProperties()
+        || structure->hasAnonymousSlots() || structure->hasGetterSetterProperties() || structure->typeInfo().overridesGetPropertyNames())
+        return 0;
+
+    for (unsigned i = 0; i < propertyNamesCacheSize; ++i) {
+        if (m_propertyNamesCache[i].structure.get() == structure)
+            return m_propertyNamesCache[i].propertyNames.get();
+    }
+
+    PropertyNameArray propertyNames(m_exec);
+    object->getOwnPropertyNames(m_exec, propertyNames);
+    if (propertyNames.size() != structure->propertyStorageSize())
+        return 0;
+
+    CachedPropertyNames& entry = m_propertyNamesCache[m_nextPropertyNamesCacheEntry];
+    m_nextPropertyNamesCacheEntry = (m_nextPropertyNamesCacheEntry + 1) % propertyNamesCacheSize;
+    entry.structure.set(m_exec->globalData(), structure);
+    entry.propertyNames = propertyNames.releaseData();
+    return entry.propertyNames.get();
+}
+
 inline Stringifier::Holder::Holder(JSGlobalData& globalData, JSObject* object)
     : m_object(globalData, object)
+    , m_structure(globalData)
     , m_isArray(object->inherits(&JSArray::s_info))
     , m_index(0)
 {
@@ -488,7 +532,10 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
-            else {
+            else if (PropertyNameArrayData* propertyNames = stringifier.propertyNamesInStorageOrder(m_object.get())) {
+                m_propertyNames = propertyNames;
+                m_structure = m_object->structure();
+            } else {
                 PropertyNameArray objectPropertyNames(exec);
                 m_object->getOwnPropertyNames(exec, objectPropertyNames);
                 m_propertyNames = objectPropertyNames.releaseData();
@@ -534,14 +581,20 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         // Append the stringified value.
         stringifyResult = stringifier.appendStringifiedValue(builder, value, m_object.get(), index);
     } else {
-        // Get the value.
-        PropertySlot slot(m_object.get());
+        // Get the value, directly from its offset if the object still has the Structure
+        // the property names came from; a toJSON function may have changed it since.
         Identifier& propertyName = m_propertyNames->propertyNameVector()[index];
-        if (!m_object->getOwnPropertySlot(exec, propertyName, slot))
-            return true;
-        JSValue value = slot.getValue(exec, propertyName);
-        if (exec->hadException())
-            return false;
+        JSValue value;
+        if (m_structure && m_structure.get() == m_object->structure())
+            value = m_object->getDirectOffset(index);
+        else {
+            PropertySlot slot(m_object.get());
+            if (!m_object->getOwnPropertySlot(exec, propertyName, slot))
+                return true;
+            value = slot.getValue(exec, propertyName);
+            if (exec->hadException())
+                return false;
+        }
 
         rollBackPoint = builder.length();
 
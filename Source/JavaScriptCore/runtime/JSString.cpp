@@ -33,6 +33,8 @@
 namespace JSC {
     
 static const unsigned substringFromRopeCutoff = 4;
+static const unsigned characterFromRopeCutoff = 32;
+static const unsigned releasedSubstringBufferRatio = 4;
 
 // Overview: this methods converts a JSString from holding a string in rope form
 // down to a simple UString representation.  It does so by building up the string
@@ -214,6 +216,112 @@ JSValue JSString::replaceCharacter(ExecState* exec, UChar character, const UStri
     return JSValue(new (globalData) JSString(globalData, builder.release()));
 }
 
+// Finds the fiber holding character i by descending through the rope, so reading a
+// character of a rope made of a few large strings doesn't copy them all. Ropes that
+// need more steps than characterFromRopeCutoff, such as those built by appending in
+// a loop, are left to be resolved instead.
+bool JSString::getCharacterFromRope(unsigned i, UChar& character) const
+{
+    ASSERT(isRope());
+    ASSERT(i < m_length);
+
+    const RopeImpl::Fiber* fibers = m_other.m_fibers.data();
+    unsigned fiberCount = m_fiberCount;
+    unsigned steps = 0;
+    while (true) {
+        RopeImpl::Fiber fiber = 0;
+        for (unsigned j = 0; j < fiberCount; ++j) {
+            if (++steps > characterFromRopeCutoff)
+                return false;
+            unsigned length = fibers[j]->length();
+            if (i < length) {
+                fiber = fibers[j];
+                break;
+            }
+            i -= length;
+        }
+        ASSERT(fiber);
+        if (!RopeImpl::isRope(fiber)) {
+            character = static_cast<StringImpl*>(fiber)->characters()[i];
+            return true;
+        }
+        RopeImpl* rope = static_cast<RopeImpl*>(fiber);
+        fibers = rope->fibers();
+        fiberCount = rope->fiberCount();
+    }
+}
+
+namespace {
+
+struct BufferUse {
+    BufferUse() : substringCount(0), substringLength(0), release(false) { }
+    unsigned substringCount;
+    unsigned substringLength;
+    bool release;
+};
+
+typedef HashMap<StringImpl*, BufferUse> BufferUseMap;
+
+} // namespace
+
+// Called by the collector after marking. A shared substring keeps the whole buffer of
+// the string it was taken from alive, so when all the substrings still referring to a
+// buffer are live JSStrings that add up to a small part of it, and nothing else
+// references the buffer, their characters are copied out and the buffer is freed.
+void JSString::releaseSubstringBuffers(JSGlobalData& globalData)
+{
+    Vector<JSString*>& substrings = globalData.sharedSubstrings;
+    BufferUseMap bufferUses;
+
+    size_t liveCount = 0;
+    for (size_t i = 0; i < substrings.size(); ++i) {
+        JSString* string = substrings[i];
+        if (!Heap::isMarked(string)) {
+            // The cell is only destroyed when it is swept or reused, drop the buffer now.
+            string->m_value = UString();
+            continue;
+        }
+        substrings[liveCount++] = string;
+        StringImpl* impl = string->m_value.impl();
+        if (!impl->hasOneRef())
+            continue;
+        BufferUse& use = bufferUses.add(impl->substringBuffer(), BufferUse()).first->second;
+        use.substringCount++;
+        use.substringLength += impl->length();
+    }
+    substrings.shrink(liveCount);
+
+    bool releasesBuffers = false;
+    BufferUseMap::iterator end = bufferUses.end();
+    for (BufferUseMap::iterator it = bufferUses.begin(); it != end; ++it) {
+        StringImpl* buffer = it->first;
+        BufferUse& use = it->second;
+        if (!buffer->hasRefCount(use.substringCount) || use.substringLength * releasedSubstringBufferRatio > buffer->length())
+            continue;
+        use.release = true;
+        releasesBuffers = true;
+        globalData.substringStatistics.releasedBuffers++;
+        globalData.substringStatistics.releasedBufferBytes += buffer->length() * sizeof(UChar);
+    }
+    if (!releasesBuffers)
+        return;
+
+    liveCount = 0;
+    for (size_t i = 0; i < substrings.size(); ++i) {
+        JSString* string = substrings[i];
+        StringImpl* impl = string->m_value.impl();
+        if (impl->hasOneRef()) {
+            BufferUseMap::iterator it = bufferUses.find(impl->substringBuffer());
+            if (it != end && it->second.release) {
+                string->m_value = UString(impl->characters(), impl->length());
+                continue;
+            }
+        }
+        substrings[liveCount++] = string;
+    }
+    substrings.shrink(liveCount);
+}
+
 JSString* JSString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
@@ -347,6 +347,17 @@ namespace JSC {
         JSString* getIndex(ExecState*, unsigned);
         JSString* getIndexSlowCase(ExecState*, unsigned);
 
+        // Reads character i without resolving the rope, when that takes only a few steps.
+        bool tryGetCharacter(unsigned i, UChar&) const;
+
+        // Substrings shorter than this are copied, so that they never keep the buffer
+        // of the string they were taken from alive.
+        static const unsigned minSharedSubstringLength = 16;
+        // Substrings sharing a buffer at least this long are tracked, and the buffer is
+        // released once only substrings much smaller than it survive a collection.
+        static const unsigned minTrackedSubstringBufferLength = 4096;
+        static void releaseSubstringBuffers(JSGlobalData&);
+
         JSValue replaceCharacter(ExecState*, UChar, const UString& replacement);
 
         static Structure* createStructure(JSGlobalData& globalData, JSValue proto) { return Structure::create(globalData, proto, TypeInfo(StringType, OverridesGetOwnPropertySlot | NeedsThisConversion), AnonymousSlotCount, 0); }
@@ -359,6 +370,7 @@ namespace JSC {
         }
 
         void resolveRope(ExecState*) const;
+        bool getCharacterFromRope(unsigned i, UChar&) const;
         JSString* substringFromRope(ExecState*, unsigned offset, unsigned length);
 
         void appendStringInConstruct(unsigned& index, const UString& string)
@@ -505,6 +517,15 @@ namespace JSC {
         return jsSingleCharacterSubstring(exec, m_value, i);
     }
 
+    inline bool JSString::tryGetCharacter(unsigned i, UChar& character) const
+    {
+        ASSERT(i < m_length);
+        if (isRope())
+            return getCharacterFromRope(i, character);
+        character = m_value.characters()[i];
+        return true;
+    }
+
     inline JSString* jsString(JSGlobalData* globalData, const UString& s)
     {
         int size = s.length();
@@ -550,7 +571,21 @@ namespace JSC {
             if (c <= maxSingleCharacterString)
                 return globalData->smallStrings.singleCharacterString(globalData, c);
         }
-        return fixupVPtr(globalData, new (globalData) JSString(globalData, UString(StringImpl::create(s.impl(), offset, length)), JSString::HasOtherOwner));
+        // The characters are copied or shared before allocating, since the collection
+        // the allocation may trigger can replace the buffer s refers to.
+        if (length < JSString::minSharedSubstringLength) {
+            UString copy(s.characters() + offset, length);
+            globalData->substringStatistics.copiedSubstrings++;
+            return fixupVPtr(globalData, new (globalData) JSString(globalData, copy));
+        }
+        UString substring(StringImpl::create(s.impl(), offset, length));
+        JSString* string = fixupVPtr(globalData, new (globalData) JSString(globalData, substring, JSString::HasOtherOwner));
+        StringImpl* buffer = substring.impl()->substringBuffer();
+        if (buffer && buffer->length() >= JSString::minTrackedSubstringBufferLength) {
+            globalData->sharedSubstrings.append(string);
+            globalData->substringStatistics.trackedSubstrings++;
+        }
+        return string;
     }
 
     inline JSString* jsOwnedString(JSGlobalData* globalData, const UString& s)
@@ -141,8 +141,21 @@ template <LiteralParser::ParserMode mode> static inline bool isSafeStringCharact
 template <LiteralParser::ParserMode mode> inline LiteralParser::TokenType LiteralParser::Lexer::lexString(LiteralParserToken& token)
 {
     ++m_ptr;
-    const UChar* runStart;
+    const UChar* runStart = m_ptr;
+    while (m_ptr < m_end && isSafeStringCharacter<mode>(*m_ptr))
+        ++m_ptr;
+    if (m_ptr < m_end && *m_ptr == '"') {
+        // No escapes, so the token can refer to the source characters.
+        token.stringStart = runStart;
+        token.stringLength = m_ptr - runStart;
+        token.stringToken = UString();
+        token.type = TokString;
+        token.end = ++m_ptr;
+        return TokString;
+    }
+
     UStringBuilder builder;
+    builder.append(runStart, m_ptr - runStart);
     do {
         runStart = m_ptr;
         while (m_ptr < m_end && isSafeStringCharacter<mode>(*m_ptr))
@@ -208,6 +221,8 @@ template <LiteralParser::ParserMode mode> inline LiteralParser::TokenType Litera
         return TokError;
 
     token.stringToken = builder.toUString();
+    token.stringStart = token.stringToken.characters();
+    token.stringLength = token.stringToken.length();
     token.type = TokString;
     token.end = ++m_ptr;
     return TokString;
@@ -287,6 +302,67 @@ LiteralParser::TokenType LiteralParser::Lexer::lexNumber(LiteralParserToken& tok
     return TokNumber;
 }
 
+inline UString LiteralParser::makeString(const Lexer::LiteralParserToken& token)
+{
+    if (!token.stringToken.isNull())
+        return token.stringToken;
+    return UString(token.stringStart, token.stringLength);
+}
+
+inline Identifier LiteralParser::makeIdentifier(const CachedProperty* property, const Lexer::LiteralParserToken& token)
+{
+    // Comparing against the name the last object with this shape had here saves an
+    // identifier table lookup for each key.
+    if (property && Identifier::equal(property->name.impl(), token.stringStart, token.stringLength))
+        return property->name;
+    return Identifier(m_exec, token.stringStart, token.stringLength);
+}
+
+inline const LiteralParser::CachedProperty* LiteralParser::cachedProperty(unsigned depth, Structure* structure)
+{
+    if (depth >= m_propertyCache.size())
+        return 0;
+    Vector<CachedProperty>& properties = m_propertyCache[depth];
+    unsigned index = structure->propertyStorageSize();
+    if (index >= properties.size())
+        return 0;
+    const CachedProperty& property = properties[index];
+    if (!property.structure.get() || property.structure.get()->previousID() != structure)
+        return 0;
+    return &property;
+}
+
+inline void LiteralParser::putProperty(unsigned depth, JSObject* object, const Identifier& name, JSValue value)
+{
+    JSGlobalData& globalData = m_exec->globalData();
+    Structure* structure = object->structure();
+    if (const CachedProperty* property = cachedProperty(depth, structure)) {
+        if (property->name == name) {
+            object->transitionTo(globalData, property->structure.get());
+            object->putDirectOffset(globalData, property->offset, value);
+            return;
+        }
+    }
+
+    PutPropertySlot slot;
+    object->putDirect(globalData, name, value, slot);
+
+    if (slot.type() != PutPropertySlot::NewProperty || object->structure() == structure || object->structure()->isDictionary())
+        return;
+    unsigned index = structure->propertyStorageSize();
+    if (depth >= maximumCachedDepth || index >= maximumCachedProperties)
+        return;
+    if (depth >= m_propertyCache.size())
+        m_propertyCache.resize(depth + 1);
+    Vector<CachedProperty>& properties = m_propertyCache[depth];
+    if (index >= properties.size())
+        properties.resize(index + 1);
+    CachedProperty& property = properties[index];
+    property.name = name;
+    property.structure.set(globalData, object->structure());
+    property.offset = slot.cachedOffset();
+}
+
 JSValue LiteralParser::parse(ParserState initialState)
 {
     ParserState state = initialState;
@@ -345,7 +421,7 @@ JSValue LiteralParser::parse(ParserState initialState)
                         return JSValue();
                     
                     m_lexer.next();
-                    identifierStack.append(Identifier(m_exec, identifierToken.stringToken));
+                    identifierStack.append(makeIdentifier(cachedProperty(objectStack.size(), object->structure()), identifierToken));
                     stateStack.append(DoParseObjectEndExpression);
                     goto startParseExpression;
                 } else if (type != TokRBrace) 
@@ -367,13 +443,13 @@ JSValue LiteralParser::parse(ParserState initialState)
                     return JSValue();
 
                 m_lexer.next();
-                identifierStack.append(Identifier(m_exec, identifierToken.stringToken));
+                identifierStack.append(makeIdentifier(cachedProperty(objectStack.size(), asObject(objectStack.last())->structure()), identifierToken));
                 stateStack.append(DoParseObjectEndExpression);
                 goto startParseExpression;
             }
             case DoParseObjectEndExpression:
             {
-                asObject(objectStack.last())->putDirect(m_exec->globalData(), identifierStack.last(), lastValue);
+                putProperty(objectStack.size(), asObject(objectStack.last()), identifierStack.last(), lastValue);
                 identifierStack.removeLast();
                 if (m_lexer.currentToken().type == TokComma)
                     goto doParseObjectStartExpression;
@@ -394,7 +470,7 @@ JSValue LiteralParser::parse(ParserState initialState)
                     case TokString: {
                         Lexer::LiteralParserToken stringToken = m_lexer.currentToken();
                         m_lexer.next();
-                        lastValue = jsString(m_exec, stringToken.stringToken);
+                        lastValue = jsString(m_exec, makeString(stringToken));
                         break;
                     }
                     case TokNumber: {
@@ -26,8 +26,10 @@
 #ifndef LiteralParser_h
 #define LiteralParser_h
 
+#include "Identifier.h"
 #include "JSGlobalObjectFunctions.h"
 #include "JSValue.h"
+#include "Strong.h"
 #include "UString.h"
 
 namespace JSC {
@@ -66,6 +68,11 @@ namespace JSC {
                 TokenType type;
                 const UChar* start;
                 const UChar* end;
+                // The characters of a string token. For strings without escapes they
+                // point into the source and stringToken is null, so no copy is made
+                // until one is needed.
+                const UChar* stringStart;
+                unsigned stringLength;
                 UString stringToken;
                 double numberToken;
             };
@@ -98,12 +105,30 @@ namespace JSC {
             const UChar* m_end;
         };
         
+        // A property added to an object at a given nesting depth and property
+        // index, and the Structure the object had afterwards. Objects with the
+        // same keys in the same order as the last one seen at their depth take
+        // these transitions directly, without a Structure lookup for each key.
+        struct CachedProperty {
+            Identifier name;
+            Strong<Structure> structure;
+            size_t offset;
+        };
+        static const unsigned maximumCachedDepth = 16;
+        static const unsigned maximumCachedProperties = 64;
+
         class StackGuard;
         JSValue parse(ParserState);
 
+        UString makeString(const Lexer::LiteralParserToken&);
+        Identifier makeIdentifier(const CachedProperty*, const Lexer::LiteralParserToken&);
+        const CachedProperty* cachedProperty(unsigned depth, Structure*);
+        void putProperty(unsigned depth, JSObject*, const Identifier&, JSValue);
+
         ExecState* m_exec;
         LiteralParser::Lexer m_lexer;
         ParserMode m_mode;
+        Vector<Vector<CachedProperty> > m_propertyCache;
     };
 }
 
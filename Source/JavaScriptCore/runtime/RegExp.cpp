@@ -26,6 +26,7 @@
 #include "Lexer.h"
 #include "yarr/Yarr.h"
 #include "yarr/YarrJIT.h"
+#include "yarr/YarrPrefilter.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -71,6 +72,8 @@ struct RegExpRepresentation {
     Yarr::YarrCodeBlock m_regExpJITCode;
 #endif
     OwnPtr<Yarr::BytecodePattern> m_regExpBytecode;
+    OwnPtr<Yarr::Prefilter> m_prefilter;
+    bool m_matchOnlyAtCandidates;
 };
 
 inline RegExp::RegExp(JSGlobalData* globalData, const UString& patternString, RegExpFlags flags)
@@ -84,6 +87,7 @@ inline RegExp::RegExp(JSGlobalData* globalData, const UString& patternString, Re
 #endif
     , m_representation(adoptPtr(new RegExpRepresentation))
 {
+    m_representation->m_matchOnlyAtCandidates = false;
     m_state = compile(globalData);
 }
 
@@ -107,11 +111,24 @@ RegExp::RegExpState RegExp::compile(JSGlobalData* globalData)
         return ParseError;
 
     m_numSubpatterns = pattern.m_numSubpatterns;
+    m_representation->m_prefilter = Yarr::Prefilter::create(pattern);
+
+    // If the prefilter finds every position a match can begin at, the matchers
+    // only try the position they are started at, and match() moves on to the
+    // next candidate after a failed attempt.
+    if (m_representation->m_prefilter && m_representation->m_prefilter->findsAllCandidates()) {
+        ASSERT(pattern.m_body->m_alternatives.size() == 1);
+        Yarr::PatternAlternative* alternative = pattern.m_body->m_alternatives[0];
+        if (!alternative->onceThrough()) {
+            alternative->setOnceThrough();
+            m_representation->m_matchOnlyAtCandidates = true;
+        }
+    }
 
     RegExpState res = ByteCode;
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && globalData->canUseJIT()) {
+    if (globalData->canUseJIT()) {
         Yarr::jitCompile(pattern, globalData, m_representation->m_regExpJITCode);
 #if ENABLE(YARR_JIT_DEBUG)
         if (!m_representation->m_regExpJITCode.isFallBack())
@@ -155,23 +172,35 @@ int RegExp::match(const UString& s, int startOffset, Vector<int, 32>* ovector)
         }
 
         ASSERT(offsetVector);
-        // Initialize offsetVector with the return value (index 0) and the 
-        // first subpattern start indicies (even index values) set to -1.
-        // No need to init the subpattern end indicies.
-        for (unsigned j = 0, i = 0; i < m_numSubpatterns + 1; j += 2, i++)            
-            offsetVector[j] = -1;
 
         int result;
+        do {
+            // Initialize offsetVector with the return value (index 0) and the 
+            // first subpattern start indicies (even index values) set to -1.
+            // No need to init the subpattern end indicies.
+            for (unsigned j = 0, i = 0; i < m_numSubpatterns + 1; j += 2, i++)            
+                offsetVector[j] = -1;
+
+            if (m_representation->m_prefilter) {
+                int candidate = m_representation->m_prefilter->findCandidate(s.characters(), startOffset, s.length());
+                if (candidate < 0)
+                    return -1;
+                startOffset = candidate;
+            }
+
 #if ENABLE(YARR_JIT)
-        if (m_state == JITCode) {
-            result = Yarr::execute(m_representation->m_regExpJITCode, s.characters(), startOffset, s.length(), offsetVector);
+            if (m_state == JITCode) {
+                result = Yarr::execute(m_representation->m_regExpJITCode, s.characters(), startOffset, s.length(), offsetVector);
 #if ENABLE(YARR_JIT_DEBUG)
-            matchCompareWithInterpreter(s, startOffset, offsetVector, result);
+                matchCompareWithInterpreter(s, startOffset, offsetVector, result);
 #endif
-        } else
+            } else
 #endif
-            result = Yarr::interpret(m_representation->m_regExpBytecode.get(), s.characters(), startOffset, s.length(), offsetVector);
-        ASSERT(result >= -1);
+                result = Yarr::interpret(m_representation->m_regExpBytecode.get(), s.characters(), startOffset, s.length(), offsetVector);
+            ASSERT(result >= -1);
+
+            ++startOffset;
+        } while (result == -1 && m_representation->m_matchOnlyAtCandidates && static_cast<unsigned>(startOffset) <= s.length());
 
 #if ENABLE(REGEXP_TRACING)
         if (result != -1)
@@ -255,9 +284,9 @@ void RegExp::matchCompareWithInterpreter(const UString& s, int startOffset, int*
         const size_t jitAddrSize = 20;
         char jitAddr[jitAddrSize];
         if (m_state == JITCode)
-            snprintf(jitAddr, jitAddrSize, "fallback");
-        else
             snprintf(jitAddr, jitAddrSize, "0x%014lx", reinterpret_cast<unsigned long int>(codeBlock.getAddr()));
+        else
+            snprintf(jitAddr, jitAddrSize, "fallback");
 #else
         const char* jitAddr = "JIT Off";
 #endif
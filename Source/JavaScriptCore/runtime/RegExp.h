@@ -51,6 +51,9 @@ namespace JSC {
 
         int match(const UString&, int startOffset, Vector<int, 32>* ovector = 0);
         unsigned numSubpatterns() const { return m_numSubpatterns; }
+
+        // True if matches run JIT compiled code, false if they fall back to the bytecode interpreter.
+        bool isJITCompiled() const { return m_state == JITCode; }
         
 #if ENABLE(REGEXP_TRACING)
         void printTraceData();
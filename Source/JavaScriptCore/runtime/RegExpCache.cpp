@@ -47,6 +47,11 @@ PassRefPtr<RegExp> RegExpCache::create(const UString& patternString, RegExpFlags
 {
     RefPtr<RegExp> regExp = RegExp::create(m_globalData, patternString, flags);
 
+    if (regExp->isJITCompiled())
+        ++m_jitCompiledCount;
+    else if (regExp->isValid())
+        ++m_interpreterFallbackCount;
+
     if (patternString.length() >= maxCacheablePatternLength)
         return regExp;
 
@@ -71,6 +76,8 @@ RegExpCache::RegExpCache(JSGlobalData* globalData)
     : m_globalData(globalData)
     , m_nextKeyToEvict(-1)
     , m_isFull(false)
+    , m_jitCompiledCount(0)
+    , m_interpreterFallbackCount(0)
 {
 }
 
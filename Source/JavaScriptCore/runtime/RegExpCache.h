@@ -45,6 +45,11 @@ public:
     PassRefPtr<RegExp> create(const UString& patternString, RegExpFlags, RegExpCacheMap::iterator);
     RegExpCache(JSGlobalData* globalData);
 
+    // Number of regular expressions created through the cache that were compiled
+    // by the YARR JIT, and that fell back to the YARR interpreter.
+    unsigned jitCompiledCount() const { return m_jitCompiledCount; }
+    unsigned interpreterFallbackCount() const { return m_interpreterFallbackCount; }
+
 private:
     static const unsigned maxCacheablePatternLength = 256;
 
@@ -61,6 +66,8 @@ private:
     JSGlobalData* m_globalData;
     int m_nextKeyToEvict;
     bool m_isFull;
+    unsigned m_jitCompiledCount;
+    unsigned m_interpreterFallbackCount;
 };
 
 } // namespace JSC
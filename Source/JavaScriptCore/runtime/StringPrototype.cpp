@@ -484,11 +484,21 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToString(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
+    JSValue a0 = exec->argument(0);
+    if (thisValue.isString() && a0.isUInt32()) {
+        // Read the character without resolving the string if it is a rope.
+        JSString* string = asString(thisValue);
+        uint32_t i = a0.asUInt32();
+        if (i >= string->length())
+            return JSValue::encode(jsEmptyString(exec));
+        UChar c;
+        if (string->tryGetCharacter(i, c))
+            return JSValue::encode(jsSingleCharacterString(exec, c));
+    }
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
     UString s = thisValue.toThisString(exec);
     unsigned len = s.length();
-    JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < len)
@@ -504,11 +514,21 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
+    JSValue a0 = exec->argument(0);
+    if (thisValue.isString() && a0.isUInt32()) {
+        // Read the character without resolving the string if it is a rope.
+        JSString* string = asString(thisValue);
+        uint32_t i = a0.asUInt32();
+        if (i >= string->length())
+            return JSValue::encode(jsNaN());
+        UChar c;
+        if (string->tryGetCharacter(i, c))
+            return JSValue::encode(jsNumber(c));
+    }
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
     UString s = thisValue.toThisString(exec);
     unsigned len = s.length();
-    JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < len)
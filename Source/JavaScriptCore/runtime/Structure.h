@@ -285,11 +285,22 @@ namespace JSC {
         return asCell()->structure()->typeInfo().needsThisConversion();
     }
 
+    ALWAYS_INLINE bool MarkStack::testAndSetMarked(JSCell* cell)
+    {
+#if ENABLE(PARALLEL_GC)
+        // The helper threads only mark while the stacks are in parallel mode,
+        // the rest of the time the bits can be set without atomic operations.
+        if (m_isInParallelMode)
+            return Heap::concurrentTestAndSetMarked(cell);
+#endif
+        return Heap::testAndSetMarked(cell);
+    }
+
     ALWAYS_INLINE void MarkStack::internalAppend(JSCell* cell)
     {
         ASSERT(!m_isCheckingForDefaultMarkViolation);
         ASSERT(cell);
-        if (Heap::testAndSetMarked(cell))
+        if (testAndSetMarked(cell))
             return;
         if (cell->structure()->typeInfo().type() >= CompoundType)
             m_values.append(cell);
@@ -52,7 +52,7 @@ namespace JSC {
 // Number of ticks before the first timeout check is done.
 static const int ticksUntilFirstCheck = 1024;
 
-// Number of milliseconds between each timeout check.
+// Default number of milliseconds between each timeout check.
 static const int intervalBetweenChecks = 1000;
 
 // Returns the time the current thread has spent executing, in milliseconds.
@@ -107,6 +107,7 @@ static inline unsigned getCPUTime()
 
 TimeoutChecker::TimeoutChecker()
     : m_timeoutInterval(0)
+    , m_checkInterval(intervalBetweenChecks)
     , m_startCount(0)
 {
     reset();
@@ -131,6 +132,10 @@ bool TimeoutChecker::didTimeOut(ExecState* exec)
     
     unsigned timeDiff = currentTime - m_timeAtLastCheck;
     
+    // Checks closer together than the clock can measure at least double the
+    // tick threshold, even when the interval is a single millisecond.
+    float ratio = timeDiff ? static_cast<float>(m_checkInterval) / timeDiff : max(2u, m_checkInterval);
+
     if (timeDiff == 0)
         timeDiff = 1;
     
@@ -138,8 +143,8 @@ bool TimeoutChecker::didTimeOut(ExecState* exec)
     m_timeAtLastCheck = currentTime;
     
     // Adjust the tick threshold so we get the next checkTimeout call in the
-    // interval specified in intervalBetweenChecks.
-    m_ticksUntilNextCheck = static_cast<unsigned>((static_cast<float>(intervalBetweenChecks) / timeDiff) * m_ticksUntilNextCheck);
+    // interval specified in m_checkInterval.
+    m_ticksUntilNextCheck = static_cast<unsigned>(ratio * m_ticksUntilNextCheck);
     // If the new threshold is 0 reset it to the default threshold. This can happen if the timeDiff is higher than the
     // preferred script check time interval.
     if (m_ticksUntilNextCheck == 0)
@@ -43,6 +43,11 @@ namespace JSC {
         unsigned timeoutInterval() const { return m_timeoutInterval; }
         
         unsigned ticksUntilNextCheck() { return m_ticksUntilNextCheck; }
+
+        // The time, in milliseconds, the tick threshold is adjusted to leave
+        // between two checks.
+        void setCheckInterval(unsigned checkInterval) { m_checkInterval = checkInterval; }
+        unsigned checkInterval() const { return m_checkInterval; }
         
         void start()
         {
@@ -63,6 +68,7 @@ namespace JSC {
 
     private:
         unsigned m_timeoutInterval;
+        unsigned m_checkInterval;
         unsigned m_timeAtLastCheck;
         unsigned m_timeExecuting;
         unsigned m_startCount;
@@ -27,11 +27,32 @@
 #define WriteBarrier_h
 
 #include "JSValue.h"
+#include "MarkedBlock.h"
 
 namespace JSC {
 class JSCell;
 class JSGlobalData;
 
+#if ENABLE(GGC)
+void writeBarrierSlowCase(JSGlobalData&, const JSCell* owner);
+
+// An old cell pointing to a young cell is added to the remembered set of the
+// heap, minor collections mark from it instead of marking the old generation.
+// Nothing is old while the young generation is disabled.
+inline void writeBarrier(JSGlobalData& globalData, const JSCell* owner, JSCell* cell)
+{
+    if (!owner || !cell)
+        return;
+    if (MarkedBlock::blockFor(owner)->isOld(owner) && !MarkedBlock::blockFor(cell)->isOld(cell))
+        writeBarrierSlowCase(globalData, owner);
+}
+
+inline void writeBarrier(JSGlobalData& globalData, const JSCell* owner, JSValue value)
+{
+    if (value.isCell())
+        writeBarrier(globalData, owner, value.asCell());
+}
+#else
 inline void writeBarrier(JSGlobalData&, const JSCell*, JSValue)
 {
 }
@@ -39,6 +60,7 @@ inline void writeBarrier(JSGlobalData&, const JSCell*, JSValue)
 inline void writeBarrier(JSGlobalData&, const JSCell*, JSCell*)
 {
 }
+#endif
 
 typedef enum { } Unknown;
 typedef JSValue* HandleSlot;
@@ -0,0 +1,149 @@
+/*
+* SUMMARY: Array.prototype.sort on int32, double and mixed arrays
+*
+* Arrays that only ever held int32 values, or only numbers, take fast
+* paths in sort, indexOf and join. Each case is repeated so that it also
+* runs from compiled code, and must give the same result every time.
+*
+* -0 is told apart from +0 by the sign of 1 / x.
+*
+* See ECMA Section 15.4.4.11 Array.prototype.sort
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Array.prototype.sort on int32, double and mixed arrays';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+function numeric(x, y)
+{
+  return x - y;
+}
+
+
+status = inSection(1);
+actual = repeat(function () { return [3, 1, 2, -5, 0].sort(numeric).join(); });
+expect = '-5,0,1,2,3';
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { return [2147483647, -2147483648, 0, -1].sort(numeric).join(); });
+expect = '-2147483648,-1,0,2147483647';
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { return [10, 9, 1, -1].sort().join(); });
+expect = '-1,1,10,9';
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { return [2.5, -1.5, 0.25, 1e300, -Infinity].sort(numeric).join(); });
+expect = '-Infinity,-1.5,0.25,2.5,1e+300';
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { var a = [3, 1.5, 2, -1]; a.sort(numeric); return a.join() + ':' + typeof a[0]; });
+expect = '-1,1.5,2,3:number';
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { var a = [3, '2', 1.5]; a.sort(numeric); return a.join() + ':' + typeof a[1]; });
+expect = '1.5,2,3:string';
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { return [3, NaN, 1].sort().join(); });
+expect = '1,3,NaN';
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { var a = [1, -0, 2]; a.sort(numeric); return describe(a[0]) + ',' + a[1] + ',' + a[2]; });
+expect = '-0,1,2';
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { var a = [0, -0, 1]; a.sort(numeric); return (describe(a[0]) + describe(a[1])).length + ':' + (describe(a[0]) == '-0' || describe(a[1]) == '-0'); });
+expect = '4:true';
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { return [-0, 0].sort().length; });
+expect = 2;
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { var a = [3, undefined, 1, , 2]; a.sort(numeric); return a.length + ':' + a.join() + ':' + (4 in a); });
+expect = '5:1,2,3,,:false';
+addThis();
+
+status = inSection(12);
+actual = repeat(function () { var a = [3, 1, 2]; a[1] = 0.5; return a.sort(numeric).join(); });
+expect = '0.5,2,3';
+addThis();
+
+status = inSection(13);
+actual = repeat(function () { var a = [3, 1, 2]; a[1] = 'x'; return a.sort().join(); });
+expect = '2,3,x';
+addThis();
+
+status = inSection(14);
+actual = repeat(function () { var a = [3, 1, 2]; a.length = 0; a.push(2.5, 1); return a.sort(numeric).join(); });
+expect = '1,2.5';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function describe(x)
+{
+  if (x === 0)
+    return 1 / x > 0 ? '+0' : '-0';
+  return String(x);
+}
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
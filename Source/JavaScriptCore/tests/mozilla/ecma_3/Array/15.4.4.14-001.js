@@ -0,0 +1,144 @@
+/*
+* SUMMARY: Array.prototype.indexOf on int32, double and mixed arrays
+*
+* Arrays that only ever held int32 values, or only numbers, take fast
+* paths in sort, indexOf and join. Each case is repeated so that it also
+* runs from compiled code, and must give the same result every time.
+*
+* See ECMA-262 5th Edition, Section 15.4.4.14 Array.prototype.indexOf
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Array.prototype.indexOf on int32, double and mixed arrays';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+status = inSection(1);
+actual = repeat(function () { return [1, 2, 3].indexOf(2); });
+expect = 1;
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { return [1, 2, 3].indexOf(2.0); });
+expect = 1;
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { return [1, 2, 3].indexOf(2.5); });
+expect = -1;
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { return [1, 2, 3].indexOf('2'); });
+expect = -1;
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { return [1, 2, -2147483648].indexOf(-2147483648); });
+expect = 2;
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { return [1, 2, 1].indexOf(1, 1); });
+expect = 2;
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { return [1, 2, 1].indexOf(1, -1); });
+expect = 2;
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { return [1.5, 2.5].indexOf(2.5); });
+expect = 1;
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { return [1.5, NaN].indexOf(NaN); });
+expect = -1;
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { return [NaN].indexOf(NaN); });
+expect = -1;
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { return [1, 0].indexOf(-0); });
+expect = 1;
+addThis();
+
+status = inSection(12);
+actual = repeat(function () { return [1, -0].indexOf(0); });
+expect = 1;
+addThis();
+
+status = inSection(13);
+actual = repeat(function () { return [1.5, -0].indexOf(-0); });
+expect = 1;
+addThis();
+
+status = inSection(14);
+actual = repeat(function () { return [1, '1', 1.5].indexOf('1'); });
+expect = 1;
+addThis();
+
+status = inSection(15);
+actual = repeat(function () { return [1, , 3].indexOf(undefined); });
+expect = -1;
+addThis();
+
+status = inSection(16);
+actual = repeat(function () { var a = [1, 2, 3]; a[1] = 2.5; return a.indexOf(2.5) + ':' + a.indexOf(2); });
+expect = '1:-1';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
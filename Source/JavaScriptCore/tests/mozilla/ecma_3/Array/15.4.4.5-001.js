@@ -0,0 +1,119 @@
+/*
+* SUMMARY: Array.prototype.join on int32, double and mixed arrays
+*
+* Arrays that only ever held int32 values, or only numbers, take fast
+* paths in sort, indexOf and join. Each case is repeated so that it also
+* runs from compiled code, and must give the same result every time.
+*
+* See ECMA Section 15.4.4.5 Array.prototype.join
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Array.prototype.join on int32, double and mixed arrays';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+status = inSection(1);
+actual = repeat(function () { return [1, -2, 2147483647, -2147483648, 0].join(); });
+expect = '1,-2,2147483647,-2147483648,0';
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { return [1, 22, 333].join(''); });
+expect = '122333';
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { return [1, 2, 3].join(' and '); });
+expect = '1 and 2 and 3';
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { return [-0].join(); });
+expect = '0';
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { return [0, -0].join('|'); });
+expect = '0|0';
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { return [1.5, NaN, Infinity, -Infinity, 1e21].join(); });
+expect = '1.5,NaN,Infinity,-Infinity,1e+21';
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { return [1, , 3].join(); });
+expect = '1,,3';
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { return [1, 'a', 2.5, null, undefined, true].join('-'); });
+expect = '1-a-2.5---true';
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { var a = []; for (var i = 0; i < 20; i++) a.push(i * 7 - 50); return a.join(); });
+expect = '-50,-43,-36,-29,-22,-15,-8,-1,6,13,20,27,34,41,48,55,62,69,76,83';
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { var a = [1, 2, 3]; a[1] = 0.5; return a.join(); });
+expect = '1,0.5,3';
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { var a = [1, 2, 3]; a[1] = {toString: function () { return 'x'; }}; return a.join(); });
+expect = '1,x,3';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
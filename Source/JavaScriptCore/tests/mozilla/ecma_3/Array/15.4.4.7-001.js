@@ -0,0 +1,130 @@
+/*
+* SUMMARY: Array.prototype.push on holey and full arrays
+*
+* Calls to push are compiled to a specialized thunk that only handles a
+* single value fitting in the existing storage of the array, and falls back
+* to the native function otherwise. Each case is repeated so that it also
+* runs from compiled code, and must give the same result every time.
+*
+* See ECMA Section 15.4.4.7 Array.prototype.push
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Array.prototype.push on holey and full arrays';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+status = inSection(1);
+actual = repeat(function () { var a = [1, , 3]; return a.push(4) + ':' + a.length + ':' + (1 in a) + ':' + a[3]; });
+expect = '4:4:false:4';
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { var a = []; a[5] = 1; a.push(2); return a.length + ':' + a[6] + ':' + (0 in a); });
+expect = '7:2:false';
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { var a = [1, 2, 3]; a.length = 10; a.push(4); return a.length + ':' + a[10] + ':' + (3 in a); });
+expect = '11:4:false';
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { var a = []; for (var i = 0; i < 100; i++) a.push(i); return a.length + ':' + a[0] + ':' + a[99]; });
+expect = '100:0:99';
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { var a = [1, 2, 3, 4]; a.push(5); a.push(6); return a.join(); });
+expect = '1,2,3,4,5,6';
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { var a = new Array(3); a.push(1); return a.length + ':' + a[3] + ':' + (0 in a); });
+expect = '4:1:false';
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { var a = [1, 2]; return a.push() + ':' + a.length; });
+expect = '2:2';
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { var a = [1, 2]; return a.push(3, 4) + ':' + a.join(); });
+expect = '4:1,2,3,4';
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { var a = [3, 1]; a.push(2.5); return a.sort(function (x, y) { return x - y; }).join(); });
+expect = '1,2.5,3';
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { var a = [3, 1]; a.push('2'); return a.sort(function (x, y) { return x - y; }).join() + ':' + typeof a[1]; });
+expect = '1,2,3:string';
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { var a = [3, 1]; a.push(-0); a.sort(function (x, y) { return x - y; }); return 1 / a[0]; });
+expect = -Infinity;
+addThis();
+
+status = inSection(12);
+actual = repeat(function () { var a = [1, 2]; a.push(2); return a.indexOf(2) + ':' + a.lastIndexOf(2); });
+expect = '1:2';
+addThis();
+
+status = inSection(13);
+actual = repeat(function () { var o = {length: 2}; return Array.prototype.push.call(o, 'x') + ':' + o[2]; });
+expect = '3:x';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
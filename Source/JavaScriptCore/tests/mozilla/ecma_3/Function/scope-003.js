@@ -0,0 +1,82 @@
+/*
+* SUMMARY: The name of a function expression is in scope inside of it
+*
+* Parenthesized function expressions in global code are parsed and
+* compiled ahead of their first call. The name of a named function
+* expression must still resolve to the function itself, in front of
+* the global variables.
+*
+* See ECMA Section 13 Function Definition
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'The name of a function expression is in scope inside of it';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+// recursion through the name
+status = inSection(1);
+actual = (function fact(n) { return n ? n * fact(n - 1) : 1; })(5);
+expect = 120;
+addThis();
+
+
+// the name hides a global variable
+status = inSection(2);
+var g = 1;
+actual = (function g() { return g === arguments.callee; })();
+expect = true;
+addThis();
+
+
+// the global variable is not changed
+status = inSection(3);
+actual = g;
+expect = 1;
+addThis();
+
+
+// a function expression stored and called later sees the globals of that time
+status = inSection(4);
+var h = (function () { return g; });
+g = 2;
+actual = h();
+expect = 2;
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,175 @@
+/*
+* SUMMARY: Math.abs, Math.floor, Math.min and Math.max on their edge cases
+*
+* Calls to these functions are compiled to specialized thunks that only
+* handle the common int32 and double cases, and fall back to the native
+* functions otherwise. Each call is repeated so that it also runs from
+* compiled code, and must give the same result every time.
+*
+* -0 is told apart from +0 by the sign of 1 / x.
+*
+* See ECMA Section 15.8.2 Function Properties of the Math Object
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'Math.abs, Math.floor, Math.min and Math.max on their edge cases';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+
+status = inSection(1);
+actual = repeat(function () { return describe(Math.abs(-0)); });
+expect = '+0';
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { return describe(Math.abs(-2147483648)); });
+expect = '2147483648';
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { return describe(Math.abs(-2147483647)); });
+expect = '2147483647';
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { return describe(Math.abs(-1.5)); });
+expect = '1.5';
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { return describe(Math.abs(NaN)); });
+expect = 'NaN';
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { return describe(Math.min(0, -0)); });
+expect = '-0';
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { return describe(Math.min(-0, 0)); });
+expect = '-0';
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { return describe(Math.max(0, -0)); });
+expect = '+0';
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { return describe(Math.max(NaN, 1)); });
+expect = 'NaN';
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { return describe(Math.max(1, NaN)); });
+expect = 'NaN';
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { return describe(Math.min(1, NaN)); });
+expect = 'NaN';
+addThis();
+
+status = inSection(12);
+actual = repeat(function () { return describe(Math.min(-2147483648, 2147483647)); });
+expect = '-2147483648';
+addThis();
+
+status = inSection(13);
+actual = repeat(function () { return describe(Math.max(0.5, 1.5)); });
+expect = '1.5';
+addThis();
+
+status = inSection(14);
+actual = repeat(function () { return describe(Math.floor(-0.5)); });
+expect = '-1';
+addThis();
+
+status = inSection(15);
+actual = repeat(function () { return describe(Math.floor(-0)); });
+expect = '-0';
+addThis();
+
+status = inSection(16);
+actual = repeat(function () { return describe(Math.floor(0.5)); });
+expect = '+0';
+addThis();
+
+status = inSection(17);
+actual = repeat(function () { return describe(Math.floor(2147483647.5)); });
+expect = '2147483647';
+addThis();
+
+status = inSection(18);
+actual = repeat(function () { return describe(Math.floor(2147483648.5)); });
+expect = '2147483648';
+addThis();
+
+status = inSection(19);
+actual = repeat(function () { return describe(Math.floor(-2.5)); });
+expect = '-3';
+addThis();
+
+status = inSection(20);
+actual = repeat(function () { return describe(Math.floor(NaN)); });
+expect = 'NaN';
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function describe(x)
+{
+  if (x === 0)
+    return 1 / x > 0 ? '+0' : '-0';
+  return String(x);
+}
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -0,0 +1,269 @@
+/*
+* SUMMARY: Testing back references, alone and quantified
+*
+* Back references are compiled by the YARR JIT, including greedy,
+* non-greedy and fixed count quantifiers. A reference to a group that
+* did not participate, or captured the empty string, matches the empty
+* string, as does a reference placed before its group.
+*
+* See ECMA Section 15.10.2.9 AtomEscape
+*/
+//-----------------------------------------------------------------------------
+var i = 0;
+var bug = '(none)';
+var summary = 'Testing back references, alone and quantified';
+var status = '';
+var statusmessages = new Array();
+var pattern = '';
+var patterns = new Array();
+var string = '';
+var strings = new Array();
+var actualmatch = '';
+var actualmatches = new Array();
+var expectedmatch = '';
+var expectedmatches = new Array();
+
+
+// greedy \1* consumes every repetition
+status = inSection(1);
+pattern = /(a)\1*/;
+string = 'aaaa';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaaa', 'a');
+addThis();
+
+
+// greedy \1* gives back repetitions
+status = inSection(2);
+pattern = /(a)\1*a/;
+string = 'aaaa';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaaa', 'a');
+addThis();
+
+
+// greedy \1* followed by another atom
+status = inSection(3);
+pattern = /(a)\1*b/;
+string = 'xaaab';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaab', 'a');
+addThis();
+
+
+// bounded \1{1,3}
+status = inSection(4);
+pattern = /(a)\1{1,3}/;
+string = 'aaaaaa';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaaa', 'a');
+addThis();
+
+
+// bounded \1{1,3} gives back
+status = inSection(5);
+pattern = /(a)\1{1,3}a/;
+string = 'aaa';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaa', 'a');
+addThis();
+
+
+// fixed count \1{2}
+status = inSection(6);
+pattern = /(ab)\1{2}c/;
+string = 'abababc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abababc', 'ab');
+addThis();
+
+
+// non-greedy \1*? matches as few as needed
+status = inSection(7);
+pattern = /(ab)\1*?c/;
+string = 'abababc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abababc', 'ab');
+addThis();
+
+
+// non-greedy \1*? stops at the first match
+status = inSection(8);
+pattern = /(ab)\1*?ab/;
+string = 'abababab';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abab', 'ab');
+addThis();
+
+
+// non-greedy \1+? to the end
+status = inSection(9);
+pattern = /(a)\1+?a$/;
+string = 'aaaa';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaaa', 'a');
+addThis();
+
+
+// non-greedy \1{2,}?
+status = inSection(10);
+pattern = /(\w)\1{2,}?z/;
+string = 'xbbbbz';
+actualmatch = string.match(pattern);
+expectedmatch = Array('bbbbz', 'b');
+addThis();
+
+
+// repeated back reference to digits
+status = inSection(11);
+pattern = /(\d+)-\1+/;
+string = '12-1212';
+actualmatch = string.match(pattern);
+expectedmatch = Array('12-1212', '12');
+addThis();
+
+
+// alternation feeding a quantified reference
+status = inSection(12);
+pattern = /(a|ab)\1*c/;
+string = 'ababc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ababc', 'ab');
+addThis();
+
+
+// alternation feeding a fixed count
+status = inSection(13);
+pattern = /(a|ab)\1{2}c/;
+string = 'abababc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abababc', 'ab');
+addThis();
+
+
+// alternation feeding a non-greedy reference
+status = inSection(14);
+pattern = /(a|ab)\1*?c/;
+string = 'ababc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ababc', 'ab');
+addThis();
+
+
+// quoted string
+status = inSection(15);
+pattern = /(['"]).*?\1/;
+string = 'say "hi" now';
+actualmatch = string.match(pattern);
+expectedmatch = Array('"hi"', '"');
+addThis();
+
+
+// matching tags
+status = inSection(16);
+pattern = /<(\w+)>.*<\/\1>/;
+string = 'x<b>bold</b>y';
+actualmatch = string.match(pattern);
+expectedmatch = Array('<b>bold</b>', 'b');
+addThis();
+
+
+// non-participating group with \1*
+status = inSection(17);
+pattern = /(x)?\1*y/;
+string = 'aay';
+actualmatch = string.match(pattern);
+expectedmatch = Array('y', undefined);
+addThis();
+
+
+// non-participating group with \1{3}
+status = inSection(18);
+pattern = /(b)?a\1{3}/;
+string = 'ca';
+actualmatch = string.match(pattern);
+expectedmatch = Array('a', undefined);
+addThis();
+
+
+// non-participating alternative
+status = inSection(19);
+pattern = /(a)|\1b/;
+string = 'b';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b', undefined);
+addThis();
+
+
+// empty capture with \1*
+status = inSection(20);
+pattern = /(a*)\1*b/;
+string = 'b';
+actualmatch = string.match(pattern);
+expectedmatch = Array('b', '');
+addThis();
+
+
+// empty capture repeated
+status = inSection(21);
+pattern = /(a*)\1*b/;
+string = 'aaaab';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaaab', 'aaaa');
+addThis();
+
+
+// forward reference
+status = inSection(22);
+pattern = /\1(a)/;
+string = 'ba';
+actualmatch = string.match(pattern);
+expectedmatch = Array('a', 'a');
+addThis();
+
+
+// two character group repeated
+status = inSection(23);
+pattern = /(..)\1{0,2}x/;
+string = 'ababababx';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abababx', 'ab');
+addThis();
+
+
+// no match
+status = inSection(24);
+pattern = /(a)\1{3}/;
+string = 'aaa';
+actualmatch = string.match(pattern);
+expectedmatch = null;
+addThis();
+
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusmessages[i] = status;
+  patterns[i] = pattern;
+  strings[i] = string;
+  actualmatches[i] = actualmatch;
+  expectedmatches[i] = expectedmatch;
+  i++;
+}
+
+
+function test()
+{
+  enterFunc ('test');
+  printBugNumber (bug);
+  printStatus (summary);
+  testRegExp(statusmessages, patterns, strings, actualmatches, expectedmatches);
+  exitFunc ('test');
+}
@@ -0,0 +1,234 @@
+/*
+* SUMMARY: Testing matches that start at a later occurrence of a literal
+*
+* Before a regexp is run, the input is scanned for the longest literal
+* every match contains. When the offset of the literal from the start of
+* a match is exact, only the positions in front of its occurrences are
+* tried; otherwise the scan only skips input that cannot match. Case
+* insensitive patterns compare the literal case folded.
+*
+* See ECMA Section 15.10.2 Pattern Semantics
+*/
+//-----------------------------------------------------------------------------
+var i = 0;
+var bug = '(none)';
+var summary = 'Testing matches that start at a later occurrence of a literal';
+var status = '';
+var statusmessages = new Array();
+var pattern = '';
+var patterns = new Array();
+var string = '';
+var strings = new Array();
+var actualmatch = '';
+var actualmatches = new Array();
+var expectedmatch = '';
+var expectedmatches = new Array();
+
+
+// an exact literal offset, the first occurrence of the literal does not match
+status = inSection(1);
+pattern = /(\d)abc/;
+string = 'xabc 1abc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('1abc', '1');
+addThis();
+
+
+// an exact literal offset after a fixed count class
+status = inSection(2);
+pattern = /[a-z]{2}-42/;
+string = 'A-42 B-42 bc-42';
+actualmatch = string.match(pattern);
+expectedmatch = Array('bc-42');
+addThis();
+
+
+// an exact literal offset of zero, several failing occurrences
+status = inSection(3);
+pattern = /foo\d/;
+string = 'foo foox foo7';
+actualmatch = string.match(pattern);
+expectedmatch = Array('foo7');
+addThis();
+
+
+// an exact literal offset, global match
+status = inSection(4);
+pattern = /o\d/g;
+string = 'o1 o o2 ox o3';
+actualmatch = string.match(pattern);
+expectedmatch = Array('o1', 'o2', 'o3');
+addThis();
+
+
+// an exact literal offset, no occurrence matches
+status = inSection(5);
+pattern = /abc\d/;
+string = 'abcx abcy abc';
+actualmatch = string.match(pattern);
+expectedmatch = null;
+addThis();
+
+
+// an exact literal offset before the end of input
+status = inSection(6);
+pattern = /(\S)cd$/;
+string = 'xcd ycd';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ycd', 'y');
+addThis();
+
+
+// an exact literal offset after a word boundary
+status = inSection(7);
+pattern = /\bcat\w*/;
+string = 'concatenate catalog';
+actualmatch = string.match(pattern);
+expectedmatch = Array('catalog');
+addThis();
+
+
+// an exact literal offset after a start of line
+status = inSection(8);
+pattern = /^abc/;
+string = 'xabc abc';
+actualmatch = string.match(pattern);
+expectedmatch = null;
+addThis();
+
+
+// an exact literal offset after a start of line, multiline
+status = inSection(9);
+pattern = /^abc/m;
+string = 'xabc\nabc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('abc');
+addThis();
+
+
+// an inexact literal offset, the match starts before the literal
+status = inSection(10);
+pattern = /\w+@example/;
+string = 'mail x y@example';
+actualmatch = string.match(pattern);
+expectedmatch = Array('y@example');
+addThis();
+
+
+// an inexact literal offset, the match extends past the first occurrence
+status = inSection(11);
+pattern = /a.*bc/;
+string = 'xa yb abc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('a yb abc');
+addThis();
+
+
+// an inexact literal offset, a greedy prefix
+status = inSection(12);
+pattern = /(a+)bc/;
+string = 'aaabc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('aaabc', 'aaa');
+addThis();
+
+
+// an inexact literal offset, the literal is missing
+status = inSection(13);
+pattern = /\d+px/;
+string = '12pt 3em';
+actualmatch = string.match(pattern);
+expectedmatch = null;
+addThis();
+
+
+// an inexact literal offset, global match
+status = inSection(14);
+pattern = /\d+px/g;
+string = '1px 22pt 333px';
+actualmatch = string.match(pattern);
+expectedmatch = Array('1px', '333px');
+addThis();
+
+
+// case insensitive, an exact literal offset
+status = inSection(15);
+pattern = /abc/i;
+string = 'xx ABC';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ABC');
+addThis();
+
+
+// case insensitive, a literal after a class
+status = inSection(16);
+pattern = /(\d)AbC/i;
+string = 'aBc 1aBc';
+actualmatch = string.match(pattern);
+expectedmatch = Array('1aBc', '1');
+addThis();
+
+
+// case insensitive, an inexact literal offset
+status = inSection(17);
+pattern = /x+YZ/i;
+string = 'xy XXXyz';
+actualmatch = string.match(pattern);
+expectedmatch = Array('XXXyz');
+addThis();
+
+
+// case insensitive, first characters of several alternatives
+status = inSection(18);
+pattern = /bq|dq/i;
+string = 'aq DQ';
+actualmatch = string.match(pattern);
+expectedmatch = Array('DQ');
+addThis();
+
+
+// case insensitive, non-ASCII first character
+status = inSection(19);
+pattern = /\u00e9t\u00e9/i;
+string = 'et\u00e9 \u00c9T\u00c9';
+actualmatch = string.match(pattern);
+expectedmatch = Array('\u00c9T\u00c9');
+addThis();
+
+
+// case insensitive, global match
+status = inSection(20);
+pattern = /ab\d/gi;
+string = 'ab1 AB Ab2 aB3';
+actualmatch = string.match(pattern);
+expectedmatch = Array('ab1', 'Ab2', 'aB3');
+addThis();
+
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function addThis()
+{
+  statusmessages[i] = status;
+  patterns[i] = pattern;
+  strings[i] = string;
+  actualmatches[i] = actualmatch;
+  expectedmatches[i] = expectedmatch;
+  i++;
+}
+
+
+function test()
+{
+  enterFunc ('test');
+  printBugNumber (bug);
+  printStatus (summary);
+  testRegExp(statusmessages, patterns, strings, actualmatches, expectedmatches);
+  exitFunc ('test');
+}
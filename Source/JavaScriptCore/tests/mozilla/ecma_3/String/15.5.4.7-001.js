@@ -0,0 +1,149 @@
+/*
+* SUMMARY: String.prototype.indexOf on ropes and substrings
+*
+* Calls to indexOf are compiled to a specialized thunk that only handles a
+* flat receiver and a single character search string, and falls back to
+* the native function otherwise. Each call is repeated so that it also runs
+* from compiled code, and must give the same result every time.
+*
+* See ECMA Section 15.5.4.7 String.prototype.indexOf
+*/
+//-----------------------------------------------------------------------------
+var UBound = 0;
+var bug = '(none)';
+var summary = 'String.prototype.indexOf on ropes and substrings';
+var status = '';
+var statusitems = [];
+var actual = '';
+var actualvalues = [];
+var expect= '';
+var expectedvalues = [];
+
+var base = 'abcdef';
+
+// a new rope on each call, "abcdefabcdeffx"
+function rope()
+{
+  var left = base + 'a';
+  return left + base.substring(1) + 'fx';
+}
+
+
+status = inSection(1);
+actual = repeat(function () { return rope().indexOf('x'); });
+expect = 13;
+addThis();
+
+status = inSection(2);
+actual = repeat(function () { return rope().indexOf('q'); });
+expect = -1;
+addThis();
+
+status = inSection(3);
+actual = repeat(function () { return rope().indexOf('fx'); });
+expect = 12;
+addThis();
+
+status = inSection(4);
+actual = repeat(function () { return rope().indexOf('a', 1); });
+expect = 6;
+addThis();
+
+status = inSection(5);
+actual = repeat(function () { return rope().indexOf(''); });
+expect = 0;
+addThis();
+
+status = inSection(6);
+actual = repeat(function () { return base.substring(3).indexOf('d'); });
+expect = 0;
+addThis();
+
+status = inSection(7);
+actual = repeat(function () { return base.substring(3).indexOf('a'); });
+expect = -1;
+addThis();
+
+status = inSection(8);
+actual = repeat(function () { return base.substring(3, 5).indexOf('f'); });
+expect = -1;
+addThis();
+
+status = inSection(9);
+actual = repeat(function () { return base.substr(1).indexOf('b'); });
+expect = 0;
+addThis();
+
+status = inSection(10);
+actual = repeat(function () { return base.slice(-2).indexOf('f'); });
+expect = 1;
+addThis();
+
+status = inSection(11);
+actual = repeat(function () { return base.indexOf('f'); });
+expect = 5;
+addThis();
+
+status = inSection(12);
+actual = repeat(function () { return base.indexOf('\u0100'); });
+expect = -1;
+addThis();
+
+status = inSection(13);
+actual = repeat(function () { return ('abc\u0100def').indexOf('\u0100'); });
+expect = 3;
+addThis();
+
+status = inSection(14);
+actual = repeat(function () { return base.indexOf(5); });
+expect = -1;
+addThis();
+
+status = inSection(15);
+actual = repeat(function () { return ('a5').indexOf(5); });
+expect = 1;
+addThis();
+
+
+
+//-----------------------------------------------------------------------------
+test();
+//-----------------------------------------------------------------------------
+
+
+
+function repeat(f)
+{
+  var result = f();
+  for (var i = 0; i < 100; i++)
+  {
+    var next = f();
+    if (next !== result)
+      return 'unstable: ' + result + ' then ' + next;
+  }
+  return result;
+}
+
+
+function addThis()
+{
+  statusitems[UBound] = status;
+  actualvalues[UBound] = actual;
+  expectedvalues[UBound] = expect;
+  UBound++;
+}
+
+
+function test()
+{
+  enterFunc('test');
+  printBugNumber(bug);
+  printStatus(summary);
+
+  for (var i=0; i<UBound; i++)
+  {
+    reportCompare(expectedvalues[i], actualvalues[i], statusitems[i]);
+  }
+
+  exitFunc ('test');
+}
@@ -108,6 +108,50 @@ inline int atomicDecrement(int volatile* addend) { return __gnu_cxx::__exchange_
 
 #endif
 
+// Makes the memory accesses before the barrier visible to other processors
+// before the ones after it.
+#if OS(WINDOWS) || OS(DARWIN) || OS(ANDROID) || COMPILER(GCC)
+#define HAVE_MEMORY_BARRIER 1
+#endif
+
+#if OS(WINDOWS)
+inline void memoryBarrier() { MemoryBarrier(); }
+#elif OS(DARWIN)
+inline void memoryBarrier() { OSMemoryBarrier(); }
+#elif OS(ANDROID)
+inline void memoryBarrier() { android_memory_barrier(); }
+#elif COMPILER(GCC)
+inline void memoryBarrier() { __sync_synchronize(); }
+#endif
+
+#if ENABLE(COMPARE_AND_SWAP)
+
+// Atomically replaces *location with newValue if it still holds expected.
+// Returns false if *location was changed by another thread in the meantime.
+#if OS(WINDOWS)
+inline bool weakCompareAndSwap(unsigned volatile* location, unsigned expected, unsigned newValue)
+{
+    return InterlockedCompareExchange(reinterpret_cast<long volatile*>(location), static_cast<long>(newValue), static_cast<long>(expected)) == static_cast<long>(expected);
+}
+#elif OS(DARWIN)
+inline bool weakCompareAndSwap(unsigned volatile* location, unsigned expected, unsigned newValue)
+{
+    return OSAtomicCompareAndSwap32Barrier(expected, newValue, reinterpret_cast<int32_t volatile*>(location));
+}
+#elif OS(ANDROID)
+inline bool weakCompareAndSwap(unsigned volatile* location, unsigned expected, unsigned newValue)
+{
+    return !android_atomic_cmpxchg(expected, newValue, reinterpret_cast<int32_t volatile*>(location));
+}
+#else
+inline bool weakCompareAndSwap(unsigned volatile* location, unsigned expected, unsigned newValue)
+{
+    return __sync_bool_compare_and_swap(location, expected, newValue);
+}
+#endif
+
+#endif // ENABLE(COMPARE_AND_SWAP)
+
 } // namespace WTF
 
 #if USE(LOCKFREE_THREADSAFEREFCOUNTED)
@@ -115,4 +159,12 @@ using WTF::atomicDecrement;
 using WTF::atomicIncrement;
 #endif
 
+#if HAVE(MEMORY_BARRIER)
+using WTF::memoryBarrier;
+#endif
+
+#if ENABLE(COMPARE_AND_SWAP)
+using WTF::weakCompareAndSwap;
+#endif
+
 #endif // Atomics_h
@@ -47,12 +47,16 @@ public:
     // the memory must all currently be in a decommitted state.
     static void* reserveUncommitted(size_t, Usage = UnknownUsage, bool writable = true, bool executable = false);
     static void releaseDecommitted(void*, size_t);
+    // Returns 0 instead of crashing when the address space is exhausted.
+    static void* tryReserveUncommitted(size_t, Usage = UnknownUsage, bool writable = true, bool executable = false);
 
     // These methods are symmetric; they commit or decommit a region of VM (uncommitted VM should
     // never be accessed, since the OS may not have attached physical memory for these regions).
     // Clients should only call commit on uncommitted regions and decommit on committed regions.
     static void commit(void*, size_t, bool writable, bool executable);
     static void decommit(void*, size_t);
+    // Returns false instead of crashing when the memory can't be committed.
+    static bool tryCommit(void*, size_t, bool writable, bool executable);
 
     // These methods are symmetric; reserveAndCommit allocates VM in an committed state,
     // decommitAndRelease should be called on a region of VM allocated by a single reservation,
@@ -33,17 +33,7 @@
 
 namespace WTF {
 
-void* OSAllocator::reserveUncommitted(size_t bytes, Usage usage, bool writable, bool executable)
-{
-    void* result = reserveAndCommit(bytes, usage, writable, executable);
-#if HAVE(MADV_FREE_REUSE)
-    // To support the "reserve then commit" model, we have to initially decommit.
-    while (madvise(result, bytes, MADV_FREE_REUSABLE) == -1 && errno == EAGAIN) { }
-#endif
-    return result;
-}
-
-void* OSAllocator::reserveAndCommit(size_t bytes, Usage usage, bool writable, bool executable)
+static void* tryReserveAndCommit(size_t bytes, OSAllocator::Usage usage, bool writable, bool executable)
 {
     // All POSIX reservations start out logically committed.
     int protection = PROT_READ;
@@ -82,6 +72,33 @@ void* OSAllocator::reserveAndCommit(size_t bytes, Usage usage, bool writable, bo
 
     result = mmap(result, bytes, protection, flags, fd, 0);
     if (result == MAP_FAILED)
+        return 0;
+    return result;
+}
+
+void* OSAllocator::reserveUncommitted(size_t bytes, Usage usage, bool writable, bool executable)
+{
+    void* result = tryReserveUncommitted(bytes, usage, writable, executable);
+    if (!result)
+        CRASH();
+    return result;
+}
+
+void* OSAllocator::tryReserveUncommitted(size_t bytes, Usage usage, bool writable, bool executable)
+{
+    void* result = tryReserveAndCommit(bytes, usage, writable, executable);
+#if HAVE(MADV_FREE_REUSE)
+    // To support the "reserve then commit" model, we have to initially decommit.
+    if (result)
+        while (madvise(result, bytes, MADV_FREE_REUSABLE) == -1 && errno == EAGAIN) { }
+#endif
+    return result;
+}
+
+void* OSAllocator::reserveAndCommit(size_t bytes, Usage usage, bool writable, bool executable)
+{
+    void* result = tryReserveAndCommit(bytes, usage, writable, executable);
+    if (!result)
         CRASH();
     return result;
 }
@@ -97,6 +114,13 @@ void OSAllocator::commit(void* address, size_t bytes, bool, bool)
 #endif
 }
 
+bool OSAllocator::tryCommit(void* address, size_t bytes, bool writable, bool executable)
+{
+    // Pages are committed when first touched, there is nothing to fail here.
+    commit(address, bytes, writable, executable);
+    return true;
+}
+
 void OSAllocator::decommit(void* address, size_t bytes)
 {
 #if HAVE(MADV_FREE_REUSE)
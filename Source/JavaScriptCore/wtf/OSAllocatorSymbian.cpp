@@ -84,6 +84,12 @@ void* OSAllocator::reserveUncommitted(size_t reservationSize, Usage usage, bool
     return base; 
 }
 
+void* OSAllocator::tryReserveUncommitted(size_t reservationSize, Usage usage, bool writable, bool executable)
+{
+    // Data reservations fail by returning 0, code chunks panic.
+    return reserveUncommitted(reservationSize, usage, writable, executable);
+}
+
 // Inverse operation of reserveUncommitted()
 void OSAllocator::releaseDecommitted(void* parkedBase, size_t bytes) 
 {
@@ -102,6 +108,13 @@ void OSAllocator::commit(void* address, size_t bytes, bool, bool executable)
         dataAllocatorInstance()->commit(address, bytes);
 }
 
+bool OSAllocator::tryCommit(void* address, size_t bytes, bool, bool executable)
+{
+    if (!executable)
+        return dataAllocatorInstance()->commit(address, bytes);
+    return true;
+}
+
 void OSAllocator::decommit(void* address, size_t bytes) 
 { 
     if (dataAllocatorInstance()->contains(address))
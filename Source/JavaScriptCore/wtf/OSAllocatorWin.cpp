@@ -38,14 +38,19 @@ static inline DWORD protection(bool writable, bool executable)
         (writable ? PAGE_READWRITE : PAGE_READONLY);
 }
 
-void* OSAllocator::reserveUncommitted(size_t bytes, Usage, bool writable, bool executable)
+void* OSAllocator::reserveUncommitted(size_t bytes, Usage usage, bool writable, bool executable)
 {
-    void* result = VirtualAlloc(0, bytes, MEM_RESERVE, protection(writable, executable));
+    void* result = tryReserveUncommitted(bytes, usage, writable, executable);
     if (!result)
         CRASH();
     return result;
 }
 
+void* OSAllocator::tryReserveUncommitted(size_t bytes, Usage, bool writable, bool executable)
+{
+    return VirtualAlloc(0, bytes, MEM_RESERVE, protection(writable, executable));
+}
+
 void* OSAllocator::reserveAndCommit(size_t bytes, Usage, bool writable, bool executable)
 {
     void* result = VirtualAlloc(0, bytes, MEM_RESERVE | MEM_COMMIT, protection(writable, executable));
@@ -56,11 +61,15 @@ void* OSAllocator::reserveAndCommit(size_t bytes, Usage, bool writable, bool exe
 
 void OSAllocator::commit(void* address, size_t bytes, bool writable, bool executable)
 {
-    void* result = VirtualAlloc(address, bytes, MEM_COMMIT, protection(writable, executable));
-    if (!result)
+    if (!tryCommit(address, bytes, writable, executable))
         CRASH();
 }
 
+bool OSAllocator::tryCommit(void* address, size_t bytes, bool writable, bool executable)
+{
+    return VirtualAlloc(address, bytes, MEM_COMMIT, protection(writable, executable));
+}
+
 void OSAllocator::decommit(void* address, size_t bytes)
 {
     bool result = VirtualFree(address, bytes, MEM_DECOMMIT);
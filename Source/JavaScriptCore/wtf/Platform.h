@@ -1278,6 +1278,22 @@
 
 #define ENABLE_JSC_ZOMBIES 0
 
+#if !defined(ENABLE_COMPARE_AND_SWAP) && (OS(WINDOWS) || OS(DARWIN) || OS(ANDROID) || (COMPILER(GCC) && !OS(SYMBIAN)))
+#define ENABLE_COMPARE_AND_SWAP 1
+#endif
+
+/* Parallel marking is compiled in where threads and compare-and-swap are
+   available; helper threads are only started when Heap is asked for them. */
+#if !defined(ENABLE_PARALLEL_GC) && ENABLE(COMPARE_AND_SWAP) && (USE(PTHREADS) || OS(WINDOWS)) && !ENABLE(SINGLE_THREADED)
+#define ENABLE_PARALLEL_GC 1
+#endif
+
+/* Generational collection relies on the write barriers of the C++ runtime,
+   the JIT stores cells without them. */
+#if !defined(ENABLE_GGC) && !ENABLE(JIT) && !ENABLE(JSC_ZOMBIES)
+#define ENABLE_GGC 1
+#endif
+
 /* FIXME: Eventually we should enable this for all platforms and get rid of the define. */
 #if PLATFORM(MAC) || PLATFORM(WIN) || PLATFORM(QT)
 #define WTF_USE_PLATFORM_STRATEGIES 1
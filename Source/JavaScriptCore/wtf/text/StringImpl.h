@@ -229,6 +229,10 @@ public:
 
     ALWAYS_INLINE void deref() { --m_refCount; if (!m_refCount && !m_static) delete this; }
     ALWAYS_INLINE bool hasOneRef() const { return (m_refCount == 1 && !m_static); }
+    ALWAYS_INLINE bool hasRefCount(unsigned refCount) const { return (m_refCount == refCount && !m_static); }
+
+    // The string whose buffer a substring created with create(rep, offset, length) refers to, or 0.
+    StringImpl* substringBuffer() const { return bufferOwnership() == BufferSubstring ? m_substringBuffer : 0; }
 
     static StringImpl* empty();
 
@@ -1269,8 +1269,14 @@ public:
 
             context->matchBegin = input.getPos();
 
-            if (currentTerm().alternative.onceThrough)
-                context->term += currentTerm().alternative.next;
+            // Skip the alternatives that are only tried at the start position,
+            // there is nothing left to try if all of them are.
+            while (currentTerm().alternative.onceThrough) {
+                int next = currentTerm().alternative.next;
+                if (next <= 0)
+                    return JSRegExpNoMatch;
+                context->term += next;
+            }
 
             MATCH_NEXT();
         }
@@ -1543,6 +1543,166 @@ class YarrGenerator : private MacroAssembler {
         state.setBacktrackLabel(backtrackBegin);
     }
 
+    // Jumps to emptyMatch when the referenced subpattern did not take part in the match, or
+    // matched the empty string. A back reference to it then matches without consuming input.
+    void checkEmptyBackReference(unsigned subpatternId, JumpList& emptyMatch)
+    {
+        const RegisterID matchPosition = regT0;
+        const RegisterID character = regT1;
+
+        load32(Address(output, ((subpatternId << 1) + 1) * sizeof(int)), character);
+        emptyMatch.append(branch32(Equal, character, TrustedImm32(-1)));
+        load32(Address(output, (subpatternId << 1) * sizeof(int)), matchPosition);
+        emptyMatch.append(branch32(Equal, matchPosition, TrustedImm32(-1)));
+        emptyMatch.append(branch32(Equal, matchPosition, character));
+    }
+
+    // Compares the input to the referenced subpattern's match once, advancing index past it.
+    // The subpattern must have matched a non empty string. index is left partway on failure.
+    void generateBackReferenceIteration(TermGenerationState& state, JumpList& failures)
+    {
+        const RegisterID matchPosition = regT0;
+        const RegisterID character = regT1;
+        unsigned subpatternId = state.term().backReferenceSubpatternId;
+        Address matchBeginAddress(output, (subpatternId << 1) * sizeof(int));
+        Address matchEndAddress(output, ((subpatternId << 1) + 1) * sizeof(int));
+
+        // Check that the rest of the input is at least as long as the subpattern's match.
+        load32(matchEndAddress, character);
+        load32(matchBeginAddress, matchPosition);
+        sub32(matchPosition, character);
+        add32(index, character);
+        failures.append(branch32(Above, character, length));
+
+        Label loop(this);
+        load16(BaseIndex(input, matchPosition, TimesTwo, 0), character);
+        failures.append(branch16(NotEqual, BaseIndex(input, index, TimesTwo, state.inputOffset() * sizeof(UChar)), character));
+        add32(TrustedImm32(1), matchPosition);
+        add32(TrustedImm32(1), index);
+        branch32(NotEqual, matchPosition, matchEndAddress).linkTo(loop, this);
+    }
+
+    // The first frame slot of a back reference holds the index before the term, or before
+    // the current iteration of a greedy term, the second the number of iterations matched.
+    void generateBackReferenceFixed(TermGenerationState& state)
+    {
+        const RegisterID countRegister = regT1;
+        PatternTerm& term = state.term();
+        unsigned countLocation = term.frameLocation + 1;
+
+        storeToFrame(index, term.frameLocation);
+
+        JumpList emptyMatch;
+        checkEmptyBackReference(term.backReferenceSubpatternId, emptyMatch);
+
+        JumpList failures;
+        if (term.quantityCount == 1)
+            generateBackReferenceIteration(state, failures);
+        else {
+            storeToFrame(TrustedImm32(0), countLocation);
+            Label loop(this);
+            generateBackReferenceIteration(state, failures);
+            loadFromFrame(countLocation, countRegister);
+            add32(TrustedImm32(1), countRegister);
+            storeToFrame(countRegister, countLocation);
+            branch32(NotEqual, countRegister, Imm32(term.quantityCount)).linkTo(loop, this);
+        }
+        Jump matched = jump();
+
+        // There is only one way for a fixed count back reference to match, so backtracking
+        // just restores the index and moves on to the previous term.
+        Label backtrackBegin(this);
+        failures.link(this);
+        loadFromFrame(term.frameLocation, index);
+        state.jumpToBacktrack(this);
+
+        matched.link(this);
+        emptyMatch.link(this);
+
+        state.setBacktrackLabel(backtrackBegin);
+    }
+
+    void generateBackReferenceGreedy(TermGenerationState& state)
+    {
+        const RegisterID matchPosition = regT0;
+        const RegisterID countRegister = regT1;
+        PatternTerm& term = state.term();
+        unsigned subpatternId = term.backReferenceSubpatternId;
+        unsigned countLocation = term.frameLocation + 1;
+
+        // With nothing to repeat the count stays 0, and backtracking moves straight on.
+        storeToFrame(TrustedImm32(0), countLocation);
+        JumpList done;
+        checkEmptyBackReference(subpatternId, done);
+
+        JumpList failures;
+        Label loop(this);
+        if (term.quantityCount != quantifyInfinite) {
+            loadFromFrame(countLocation, countRegister);
+            done.append(branch32(Equal, countRegister, Imm32(term.quantityCount)));
+        }
+        storeToFrame(index, term.frameLocation);
+        generateBackReferenceIteration(state, failures);
+        loadFromFrame(countLocation, countRegister);
+        add32(TrustedImm32(1), countRegister);
+        storeToFrame(countRegister, countLocation);
+        jump(loop);
+
+        // Rewind the iteration that failed partway.
+        failures.link(this);
+        loadFromFrame(term.frameLocation, index);
+        done.append(jump());
+
+        // Give back one iteration. Every iteration is as long as the subpattern's match.
+        Label backtrackBegin(this);
+        loadFromFrame(countLocation, countRegister);
+        state.jumpToBacktrack(this, branchTest32(Zero, countRegister));
+        sub32(TrustedImm32(1), countRegister);
+        storeToFrame(countRegister, countLocation);
+        load32(Address(output, ((subpatternId << 1) + 1) * sizeof(int)), matchPosition);
+        sub32(matchPosition, index);
+        load32(Address(output, (subpatternId << 1) * sizeof(int)), matchPosition);
+        add32(matchPosition, index);
+
+        done.link(this);
+
+        state.setBacktrackLabel(backtrackBegin);
+    }
+
+    void generateBackReferenceNonGreedy(TermGenerationState& state)
+    {
+        const RegisterID countRegister = regT1;
+        PatternTerm& term = state.term();
+        unsigned countLocation = term.frameLocation + 1;
+
+        storeToFrame(index, term.frameLocation);
+        storeToFrame(TrustedImm32(0), countLocation);
+
+        Jump firstTimeDoNothing = jump();
+
+        JumpList hardFail;
+        Label hardFailLabel(this);
+        loadFromFrame(term.frameLocation, index);
+        state.jumpToBacktrack(this);
+
+        // Match one more iteration, continuing from where the previous one ended.
+        Label backtrackBegin(this);
+        checkEmptyBackReference(term.backReferenceSubpatternId, hardFail);
+        if (term.quantityCount != quantifyInfinite) {
+            loadFromFrame(countLocation, countRegister);
+            hardFail.append(branch32(Equal, countRegister, Imm32(term.quantityCount)));
+        }
+        generateBackReferenceIteration(state, hardFail);
+        loadFromFrame(countLocation, countRegister);
+        add32(TrustedImm32(1), countRegister);
+        storeToFrame(countRegister, countLocation);
+        hardFail.linkTo(hardFailLabel, this);
+
+        firstTimeDoNothing.link(this);
+
+        state.setBacktrackLabel(backtrackBegin);
+    }
+
     void generateParenthesesDisjunction(PatternTerm& parenthesesTerm, TermGenerationState& state, unsigned alternativeFrameLocation)
     {
         ASSERT((parenthesesTerm.type == PatternTerm::TypeParenthesesSubpattern) || (parenthesesTerm.type == PatternTerm::TypeParentheticalAssertion));
@@ -1897,7 +2057,23 @@ class YarrGenerator : private MacroAssembler {
             break;
 
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            // Comparing case insensitively needs Unicode case folding of both strings,
+            // which the interpreter does.
+            if (m_pattern.m_ignoreCase) {
+                m_shouldFallBack = true;
+                break;
+            }
+            switch (term.quantityType) {
+            case QuantifierFixedCount:
+                generateBackReferenceFixed(state);
+                break;
+            case QuantifierGreedy:
+                generateBackReferenceGreedy(state);
+                break;
+            case QuantifierNonGreedy:
+                generateBackReferenceNonGreedy(state);
+                break;
+            }
             break;
 
         case PatternTerm::TypeForwardReference:
@@ -2234,6 +2410,13 @@ public:
     {
         generateEnter();
 
+        // Back references read the end index of the subpattern they refer to, which the
+        // caller leaves uninitialized.
+        if (m_pattern.m_containsBackreferences) {
+            for (unsigned i = 1; i <= m_pattern.m_numSubpatterns; ++i)
+                store32(TrustedImm32(-1), Address(output, ((i << 1) + 1) * sizeof(int)));
+        }
+
         if (!m_pattern.m_body->m_hasFixedSize)
             store32(index, Address(output));
 
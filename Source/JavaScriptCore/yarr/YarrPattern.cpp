@@ -768,20 +768,18 @@ public:
     //   * where the parens do not contain any capturing subpatterns.
     void checkForTerminalParentheses()
     {
-        // This check is much too crude; should be just checking whether the candidate
-        // node contains nested capturing subpatterns, not the whole expression!
-        if (m_pattern.m_numSubpatterns)
-            return;
-
         Vector<PatternAlternative*>& alternatives = m_pattern.m_body->m_alternatives;
         for (size_t i = 0; i < alternatives.size(); ++i) {
             Vector<PatternTerm>& terms = alternatives[i]->m_terms;
             if (terms.size()) {
                 PatternTerm& term = terms.last();
+                // Subpattern ids are allocated in order, so the parens contain no capturing
+                // subpatterns if none were allocated between their start and end.
                 if (term.type == PatternTerm::TypeParenthesesSubpattern
                     && term.quantityType == QuantifierGreedy
                     && term.quantityCount == quantifyInfinite
-                    && !term.capture())
+                    && !term.capture()
+                    && term.parentheses.lastSubpatternId < term.parentheses.subpatternId)
                     term.parentheses.isTerminal = true;
             }
         }
@@ -947,7 +945,117 @@ public:
         }
     }
 
+    // Finds the longest run of pattern characters in the body that every match must contain.
+    // A run whose offset from the start of the match is exact is preferred, since matching
+    // can then skip straight to the run's occurrences.
+    void setupRequiredLiteral()
+    {
+        if (m_pattern.m_body->m_alternatives.size() != 1)
+            return;
+
+        Vector<PatternTerm>& terms = m_pattern.m_body->m_alternatives[0]->m_terms;
+        Vector<UChar> run;
+        unsigned runOffset = 0;
+        bool runOffsetIsExact = false;
+        bool offsetIsExact = true;
+
+        for (unsigned i = 0; i <= terms.size(); ++i) {
+            if (i < terms.size() && isRequiredLiteralCharacter(terms[i])) {
+                PatternTerm& term = terms[i];
+                if (run.isEmpty()) {
+                    runOffset = term.inputPosition;
+                    runOffsetIsExact = offsetIsExact;
+                }
+                UChar ch = m_pattern.m_ignoreCase ? Unicode::toLower(term.patternCharacter) : term.patternCharacter;
+                for (unsigned count = 0; count < term.quantityCount && run.size() < maxRequiredLiteralLength; ++count)
+                    run.append(ch);
+                continue;
+            }
+
+            if (!run.isEmpty()) {
+                bool isBetter = m_pattern.m_requiredLiteral.isEmpty()
+                    || (runOffsetIsExact && !m_pattern.m_requiredLiteralOffsetIsExact)
+                    || ((runOffsetIsExact == m_pattern.m_requiredLiteralOffsetIsExact) && (run.size() > m_pattern.m_requiredLiteral.size()));
+                if (isBetter) {
+                    m_pattern.m_requiredLiteral.swap(run);
+                    m_pattern.m_requiredLiteralOffset = runOffset;
+                    m_pattern.m_requiredLiteralOffsetIsExact = runOffsetIsExact;
+                }
+                run.clear();
+            }
+
+            if (i < terms.size() && !hasFixedWidth(terms[i]))
+                offsetIsExact = false;
+        }
+    }
+
+    // Collects the characters the first term of each body alternative can match.
+    void setupFirstCharacters()
+    {
+        FirstCharacterSet& firstCharacters = m_pattern.m_firstCharacters;
+        Vector<PatternAlternative*>& alternatives = m_pattern.m_body->m_alternatives;
+
+        for (unsigned alt = 0; alt < alternatives.size(); ++alt) {
+            Vector<PatternTerm>& terms = alternatives[alt]->m_terms;
+            if (!terms.size())
+                return;
+
+            PatternTerm& term = terms[0];
+            if (term.quantityType != QuantifierFixedCount || !term.quantityCount)
+                return;
+
+            if (term.type == PatternTerm::TypePatternCharacter) {
+                UChar ch = term.patternCharacter;
+                firstCharacters.add(ch);
+                if (m_pattern.m_ignoreCase) {
+                    firstCharacters.add(Unicode::toLower(ch));
+                    firstCharacters.add(Unicode::toUpper(ch));
+                }
+            } else if (term.type == PatternTerm::TypeCharacterClass && !term.invert()) {
+                CharacterClass* characterClass = term.characterClass;
+                for (unsigned i = 0; i < characterClass->m_matches.size(); ++i)
+                    firstCharacters.add(characterClass->m_matches[i]);
+                for (unsigned i = 0; i < characterClass->m_ranges.size(); ++i) {
+                    for (UChar ch = characterClass->m_ranges[i].begin; ch <= characterClass->m_ranges[i].end; ++ch)
+                        firstCharacters.add(ch);
+                }
+                if (characterClass->m_matchesUnicode.size() || characterClass->m_rangesUnicode.size())
+                    firstCharacters.m_containsNonASCII = true;
+            } else
+                return;
+        }
+
+        m_pattern.m_containsFirstCharacters = !alternatives.isEmpty();
+    }
+
 private:
+    static const unsigned maxRequiredLiteralLength = 255;
+
+    bool isRequiredLiteralCharacter(PatternTerm& term)
+    {
+        if (term.type != PatternTerm::TypePatternCharacter || term.quantityType != QuantifierFixedCount)
+            return false;
+        // Case insensitive characters are only folded in the ASCII range.
+        UChar ch = term.patternCharacter;
+        return !m_pattern.m_ignoreCase || isASCII(ch) || (Unicode::toLower(ch) == Unicode::toUpper(ch));
+    }
+
+    static bool hasFixedWidth(PatternTerm& term)
+    {
+        switch (term.type) {
+        case PatternTerm::TypeAssertionBOL:
+        case PatternTerm::TypeAssertionEOL:
+        case PatternTerm::TypeAssertionWordBoundary:
+        case PatternTerm::TypeForwardReference:
+            return true;
+        case PatternTerm::TypePatternCharacter:
+        case PatternTerm::TypeCharacterClass:
+            return term.quantityType == QuantifierFixedCount;
+        default:
+            return false;
+        }
+    }
+
     YarrPattern& m_pattern;
     PatternAlternative* m_alternative;
     CharacterClassConstructor m_characterClassConstructor;
@@ -985,6 +1093,8 @@ const char* YarrPattern::compile(const UString& patternString)
         
     constructor.setupOffsets();
     constructor.setupBeginChars();
+    constructor.setupRequiredLiteral();
+    constructor.setupFirstCharacters();
 
     return 0;
 }
@@ -995,8 +1105,11 @@ YarrPattern::YarrPattern(const UString& pattern, bool ignoreCase, bool multiline
     , m_containsBackreferences(false)
     , m_containsBeginChars(false)
     , m_containsBOL(false)
+    , m_containsFirstCharacters(false)
+    , m_requiredLiteralOffsetIsExact(false)
     , m_numSubpatterns(0)
     , m_maxBackReference(0)
+    , m_requiredLiteralOffset(0)
     , newlineCached(0)
     , digitsCached(0)
     , spacesCached(0)
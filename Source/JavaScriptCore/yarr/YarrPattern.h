@@ -312,6 +312,39 @@ struct BeginChar {
     unsigned mask;
 };
 
+// The characters below 128 that can start a match, and whether any other character can.
+struct FirstCharacterSet {
+    FirstCharacterSet()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (unsigned i = 0; i < 4; ++i)
+            m_ascii[i] = 0;
+        m_containsNonASCII = false;
+    }
+
+    void add(UChar ch)
+    {
+        if (ch < 128)
+            m_ascii[ch >> 5] |= 1u << (ch & 31);
+        else
+            m_containsNonASCII = true;
+    }
+
+    bool contains(UChar ch) const
+    {
+        if (ch < 128)
+            return m_ascii[ch >> 5] & (1u << (ch & 31));
+        return m_containsNonASCII;
+    }
+
+    uint32_t m_ascii[4];
+    bool m_containsNonASCII;
+};
+
 struct YarrPattern {
     YarrPattern(const UString& pattern, bool ignoreCase, bool multiline, const char** error);
 
@@ -329,6 +362,9 @@ struct YarrPattern {
         m_containsBackreferences = false;
         m_containsBeginChars = false;
         m_containsBOL = false;
+        m_containsFirstCharacters = false;
+        m_requiredLiteralOffsetIsExact = false;
+        m_requiredLiteralOffset = 0;
 
         newlineCached = 0;
         digitsCached = 0;
@@ -343,6 +379,8 @@ struct YarrPattern {
         deleteAllValues(m_userCharacterClasses);
         m_userCharacterClasses.clear();
         m_beginChars.clear();
+        m_requiredLiteral.clear();
+        m_firstCharacters.clear();
     }
 
     bool containsIllegalBackReference()
@@ -398,6 +436,8 @@ struct YarrPattern {
     bool m_containsBackreferences : 1;
     bool m_containsBeginChars : 1;
     bool m_containsBOL : 1;
+    bool m_containsFirstCharacters : 1;
+    bool m_requiredLiteralOffsetIsExact : 1;
     unsigned m_numSubpatterns;
     unsigned m_maxBackReference;
     PatternDisjunction* m_body;
@@ -405,6 +445,13 @@ struct YarrPattern {
     Vector<CharacterClass*> m_userCharacterClasses;
     Vector<BeginChar> m_beginChars;
 
+    // Characters that every match contains, lower cased for case insensitive patterns. Their
+    // offset from the start of a match is a lower bound, or exact if all the terms before
+    // them have a fixed width.
+    Vector<UChar> m_requiredLiteral;
+    unsigned m_requiredLiteralOffset;
+    FirstCharacterSet m_firstCharacters;
+
 private:
     const char* compile(const UString& patternString);
 
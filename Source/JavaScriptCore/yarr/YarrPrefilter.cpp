@@ -0,0 +1,126 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "YarrPrefilter.h"
+
+namespace JSC { namespace Yarr {
+
+PassOwnPtr<Prefilter> Prefilter::create(YarrPattern& pattern)
+{
+    if (pattern.m_requiredLiteral.isEmpty() && !pattern.m_containsFirstCharacters)
+        return PassOwnPtr<Prefilter>();
+    return adoptPtr(new Prefilter(pattern));
+}
+
+Prefilter::Prefilter(YarrPattern& pattern)
+    : m_ignoreCase(pattern.m_ignoreCase)
+    , m_literalOffsetIsExact(pattern.m_requiredLiteralOffsetIsExact)
+    , m_containsFirstCharacters(pattern.m_containsFirstCharacters)
+    , m_literalOffset(pattern.m_requiredLiteralOffset)
+    , m_firstCharacters(pattern.m_firstCharacters)
+{
+    m_literal.append(pattern.m_requiredLiteral);
+    ASSERT(m_literal.size() <= 255);
+
+    // The shift applied when the character under the end of the literal is
+    // ch: the distance from the last occurrence of ch (excluding the final
+    // position) to the end of the literal. Characters are bucketed by their
+    // low byte, so a bucket takes the smallest shift of the characters in it.
+    unsigned literalLength = m_literal.size();
+    for (unsigned i = 0; i < 256; ++i)
+        m_shifts[i] = literalLength;
+    for (unsigned i = 0; i + 1 < literalLength; ++i)
+        m_shifts[m_literal[i] & 0xff] = literalLength - 1 - i;
+}
+
+int Prefilter::findLiteral(const UChar* input, unsigned start, unsigned length) const
+{
+    unsigned literalLength = m_literal.size();
+    if (start > length || length - start < literalLength)
+        return -1;
+
+    const UChar* literal = m_literal.data();
+    unsigned last = literalLength - 1;
+
+    if (!last) {
+        UChar ch = literal[0];
+        for (unsigned position = start; position < length; ++position) {
+            if (fold(input[position]) == ch)
+                return position;
+        }
+        return -1;
+    }
+
+    for (unsigned position = start; position + last < length; ) {
+        UChar ch = fold(input[position + last]);
+        if (ch == literal[last]) {
+            unsigned i = last;
+            while (i && fold(input[position + i - 1]) == literal[i - 1])
+                --i;
+            if (!i)
+                return position;
+        }
+        position += m_shifts[ch & 0xff];
+    }
+    return -1;
+}
+
+int Prefilter::findFirstCharacter(const UChar* input, unsigned start, unsigned length) const
+{
+    for (unsigned position = start; position < length; ++position) {
+        if (m_firstCharacters.contains(input[position]))
+            return position;
+    }
+    return -1;
+}
+
+int Prefilter::findCandidate(const UChar* input, unsigned start, unsigned length) const
+{
+    if (findsAllCandidates()) {
+        // Skip the occurrences of the literal where the first character can't match.
+        while (true) {
+            int literalPosition = findLiteral(input, start + m_literalOffset, length);
+            if (literalPosition < 0)
+                return -1;
+            unsigned candidate = literalPosition - m_literalOffset;
+            if (!m_containsFirstCharacters || m_firstCharacters.contains(input[candidate]))
+                return candidate;
+            start = candidate + 1;
+        }
+    }
+
+    // The literal may be anywhere after its offset, so it only tells whether
+    // the rest of the input can match at all.
+    if (!m_literal.isEmpty() && findLiteral(input, start + m_literalOffset, length) < 0)
+        return -1;
+
+    if (m_containsFirstCharacters)
+        return findFirstCharacter(input, start, length);
+
+    return start;
+}
+
+} } // namespace JSC::Yarr
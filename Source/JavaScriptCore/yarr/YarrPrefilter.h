@@ -0,0 +1,71 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef YarrPrefilter_h
+#define YarrPrefilter_h
+
+#include "YarrPattern.h"
+#include <wtf/PassOwnPtr.h>
+#include <wtf/Vector.h>
+
+namespace JSC { namespace Yarr {
+
+// Skips over the input where a match cannot begin before the JIT or the
+// interpreter is run, using the required literal and first character set
+// found by YarrPattern. The literal is searched for with Boyer-Moore-Horspool.
+class Prefilter {
+    WTF_MAKE_NONCOPYABLE(Prefilter); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns 0 if the pattern has nothing worth scanning for.
+    static PassOwnPtr<Prefilter> create(YarrPattern&);
+
+    // Returns the first offset at or after start at which a match may begin,
+    // or -1 if no match can begin in the rest of the input.
+    int findCandidate(const UChar* input, unsigned start, unsigned length) const;
+
+    // True if every position a match can begin at is returned by findCandidate,
+    // so a failed match attempt can be resumed from the next candidate.
+    bool findsAllCandidates() const { return !m_literal.isEmpty() && m_literalOffsetIsExact; }
+
+private:
+    Prefilter(YarrPattern&);
+
+    UChar fold(UChar ch) const { return (m_ignoreCase && ch >= 'A' && ch <= 'Z') ? (ch | 0x20) : ch; }
+
+    int findLiteral(const UChar* input, unsigned start, unsigned length) const;
+    int findFirstCharacter(const UChar* input, unsigned start, unsigned length) const;
+
+    bool m_ignoreCase;
+    bool m_literalOffsetIsExact;
+    bool m_containsFirstCharacters;
+    unsigned m_literalOffset;
+    Vector<UChar> m_literal;
+    unsigned char m_shifts[256];
+    FirstCharacterSet m_firstCharacters;
+};
+
+} } // namespace JSC::Yarr
+
+#endif // YarrPrefilter_h
@@ -3,5 +3,6 @@
 SOURCES += \
     yarr/YarrInterpreter.cpp \
     yarr/YarrPattern.cpp \
+    yarr/YarrPrefilter.cpp \
     yarr/YarrSyntaxChecker.cpp
 
@@ -747,6 +747,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/graphics/android/rendering/PaintTileOperation.cpp \
 	platform/graphics/android/rendering/RasterRenderer.cpp \
 	platform/graphics/android/rendering/ShaderProgram.cpp \
+	platform/graphics/android/rendering/SoftwareRenderer.cpp \
 	platform/graphics/android/rendering/Surface.cpp \
 	platform/graphics/android/rendering/SurfaceBacking.cpp \
 	platform/graphics/android/rendering/SurfaceCollection.cpp \
@@ -755,6 +756,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/graphics/android/rendering/TexturesGenerator.cpp \
 	platform/graphics/android/rendering/Tile.cpp \
 	platform/graphics/android/rendering/TileGrid.cpp \
+	platform/graphics/android/rendering/TileMemoryPool.cpp \
 	platform/graphics/android/rendering/TileTexture.cpp \
 	platform/graphics/android/rendering/TilesManager.cpp \
 	platform/graphics/android/rendering/TilesProfiler.cpp \
@@ -196,6 +196,8 @@ public:
     bool goingLeft() { return m_goingLeft; }
 
     float scale() { return m_scale; }
+    // only for software compositing, drawGL() sets the scale otherwise
+    void setScale(float scale) { m_scale = scale; }
 
     // Currently, we only use 3 modes : kAllTextures, kClippedTextures and
     // kSingleSurfaceRendering ( for every mode > kClippedTextures ) .
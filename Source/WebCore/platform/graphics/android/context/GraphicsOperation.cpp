@@ -51,5 +51,56 @@ void Operation::operator delete(void*)
     CRASH();
 }
 
+static bool isRect(const IntRect& a, const IntRect& b, const IntRect& united)
+{
+    IntRect overlap = intersection(a, b);
+    return united.width() * united.height() + overlap.width() * overlap.height()
+        == a.width() * a.height() + b.width() * b.height();
+}
+
+bool FillRect::merge(Operation* next)
+{
+    FillRect* other = next->asFillRect();
+    if (!other || other->m_state != m_state || other->m_canvasState != m_canvasState)
+        return false;
+    if (other->m_hasColor != m_hasColor || (m_hasColor && other->m_color != m_color))
+        return false;
+    // a shadow is drawn per rect, merging would change its outline
+    if (m_state && SkColorGetA(m_state->shadow.color))
+        return false;
+
+    // only merge rects sharing a full edge, so that no pixel is covered twice
+    const FloatRect& rect = other->m_rect;
+    bool horizontal = rect.y() == m_rect.y() && rect.height() == m_rect.height()
+        && (rect.x() == m_rect.maxX() || rect.maxX() == m_rect.x());
+    bool vertical = rect.x() == m_rect.x() && rect.width() == m_rect.width()
+        && (rect.y() == m_rect.maxY() || rect.maxY() == m_rect.y());
+    if (!horizontal && !vertical)
+        return false;
+
+    m_rect.unite(rect);
+
+    // the covered area stays valid only if the union is still a rect
+    const IntRect* otherOpaque = other->opaqueRect();
+    IntRect opaque = *opaqueRect();
+    if (!opaque.isEmpty() && otherOpaque && !otherOpaque->isEmpty()) {
+        IntRect united = unionRect(opaque, *otherOpaque);
+        setOpaqueRect(isRect(opaque, *otherOpaque, united) ? united : IntRect());
+    } else
+        setOpaqueRect(IntRect());
+    return true;
+}
+
+bool FillRect::solidColor(Color& color)
+{
+    if (m_hasColor)
+        color = m_color;
+    else if (m_state && !m_state->fillShader)
+        color = Color(m_state->fillColor);
+    else
+        return false;
+    return !color.hasAlpha();
+}
+
 } // namespace GraphicsOperation
 } // namespace WebCore
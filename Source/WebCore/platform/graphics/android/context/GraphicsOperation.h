@@ -60,6 +60,8 @@ class CanvasState;
 
 namespace GraphicsOperation {
 
+class FillRect;
+
 class Operation {
 public:
     Operation()
@@ -91,6 +93,14 @@ public:
     virtual bool isOpaque() { return false; }
     virtual void setOpaqueRect(const IntRect& bounds) {}
 
+    // Used to optimize recordings once they are complete.
+    // Matrix operations concatenate their transform and return true
+    virtual bool concatTransform(AffineTransform& transform) { return false; }
+    // Folds the operation played back right after this one into it, returns
+    // false if the two cannot be merged
+    virtual bool merge(Operation* next) { return false; }
+    virtual FillRect* asFillRect() { return 0; }
+
 #if DEBUG_GRAPHICS_OPERATIONS
     typedef enum { UndefinedOperation
                   // Matrix operations
@@ -186,6 +196,10 @@ public:
         context->concatCTM(m_matrix);
         return true;
     }
+    virtual bool concatTransform(AffineTransform& transform) {
+        transform.multiply(m_matrix);
+        return true;
+    }
     TYPE(ConcatCTMOperation)
 private:
     AffineTransform m_matrix;
@@ -198,6 +212,10 @@ public:
         context->rotate(m_angle);
         return true;
     }
+    virtual bool concatTransform(AffineTransform& transform) {
+        transform.rotate(rad2deg(m_angle));
+        return true;
+    }
     TYPE(RotateOperation)
 private:
     float m_angle;
@@ -210,6 +228,10 @@ public:
         context->scale(m_scale);
         return true;
     }
+    virtual bool concatTransform(AffineTransform& transform) {
+        transform.scaleNonUniform(m_scale.width(), m_scale.height());
+        return true;
+    }
     TYPE(ScaleOperation)
 private:
     FloatSize m_scale;
@@ -222,6 +244,10 @@ public:
         context->translate(m_x, m_y);
         return true;
     }
+    virtual bool concatTransform(AffineTransform& transform) {
+        transform.translate(m_x, m_y);
+        return true;
+    }
     TYPE(TranslateOperation)
 private:
     float m_x;
@@ -475,6 +501,10 @@ public:
     }
     virtual bool isOpaque() { return (m_hasColor && !m_color.hasAlpha())
             || (!m_hasColor && SkColorGetA(m_state->fillColor) == 0xFF); }
+    virtual bool merge(Operation* next);
+    virtual FillRect* asFillRect() { return this; }
+    // Returns true if the rect is filled with a single opaque color
+    bool solidColor(Color& color);
     TYPE(FillRectOperation)
 private:
     FloatRect m_rect;
@@ -30,6 +30,7 @@
 #include "PlatformGraphicsContextRecording.h"
 
 #include "AndroidLog.h"
+#include "ClassTracker.h"
 #include "FloatRect.h"
 #include "FloatQuad.h"
 #include "Font.h"
@@ -131,12 +132,16 @@ public:
     CanvasState(CanvasState* parent)
         : m_parent(parent)
         , m_isTransparencyLayer(false)
+        , m_hasDrawing(false)
+        , m_lastDrawingId(0)
     {}
 
     CanvasState(CanvasState* parent, float opacity)
         : m_parent(parent)
         , m_isTransparencyLayer(true)
         , m_opacity(opacity)
+        , m_hasDrawing(false)
+        , m_lastDrawingId(0)
     {}
 
     ~CanvasState() {
@@ -191,6 +196,47 @@ public:
         m_operations.append(data);
     }
 
+    // Records that a drawing operation with the given id depends on this
+    // state (either directly or through a child state)
+    void markDrawing(size_t id) {
+        for (CanvasState* state = this; state; state = state->m_parent) {
+            state->m_hasDrawing = true;
+            state->m_lastDrawingId = std::max(state->m_lastDrawingId, id);
+        }
+    }
+
+    // Drops state operations that no drawing depends on, and folds runs of
+    // back to back matrix operations into a single ConcatCTM.
+    // Returns the number of operations removed.
+    size_t optimize(android::LinearAllocator* heap) {
+        size_t removed = 0;
+        size_t lastId = 0;
+        Vector<RecordingData*> operations;
+        for (size_t i = 0; i < m_operations.size(); i++) {
+            RecordingData* data = m_operations[i];
+            if (!m_hasDrawing || data->m_orderBy > m_lastDrawingId) {
+                data->~RecordingData();
+                removed++;
+                continue;
+            }
+
+            AffineTransform transform;
+            RecordingData* previous = operations.size() ? operations.last() : 0;
+            if (previous && data->m_orderBy == lastId + 1
+                && previous->m_operation->concatTransform(transform)
+                && data->m_operation->concatTransform(transform)) {
+                previous->m_operation->~Operation();
+                previous->m_operation = new (heap) GraphicsOperation::ConcatCTM(transform);
+                data->~RecordingData();
+                removed++;
+            } else
+                operations.append(data);
+            lastId = data->m_orderBy;
+        }
+        m_operations.swap(operations);
+        return removed;
+    }
+
     bool isTransparencyLayer() {
         return m_isTransparencyLayer;
     }
@@ -203,6 +249,8 @@ private:
     CanvasState *m_parent;
     bool m_isTransparencyLayer;
     float m_opacity;
+    bool m_hasDrawing;
+    size_t m_lastDrawingId;
     Vector<RecordingData*> m_operations;
 };
 
@@ -216,10 +264,20 @@ public:
     RecordingImpl()
         : m_tree(&m_heap)
         , m_nodeCount(0)
+        , m_optimizedNodeCount(0)
+        , m_finalized(false)
     {
     }
 
     ~RecordingImpl() {
+#ifdef DEBUG_COUNT
+        if (m_finalized) {
+            ClassTracker::instance()->decrement("RecordingOperation (recorded)", m_nodeCount);
+            ClassTracker::instance()->decrement("RecordingOperation (kept)", m_optimizedNodeCount);
+            ClassTracker::instance()->decrement("RecordingBytes", m_heap.usedSize());
+        }
+#endif
+        clearPendingOperations();
         clearStates();
         clearCanvasStates();
         clearSkPaints();
@@ -290,8 +348,41 @@ public:
 
     android::LinearAllocator* heap() { return &m_heap; }
 
+    void appendDrawingOperation(const IntRect& bounds, RecordingData* data) {
+        data->m_operation->m_canvasState->markDrawing(data->m_orderBy);
+        m_pendingOperations.append(PendingOperation(bounds, data));
+    }
+
+    // Called once recording is complete: optimizes the recorded operations,
+    // then builds the tree used for playback
+    void finalize() {
+        if (m_finalized)
+            return;
+        m_finalized = true;
+
+        size_t removed = 0;
+        for (size_t i = 0; i < m_canvasStates.size(); i++)
+            removed += m_canvasStates[i]->optimize(heap());
+        removed += mergeDrawingOperations();
+
+        for (size_t i = 0; i < m_pendingOperations.size(); i++)
+            m_tree.append(m_pendingOperations[i].bounds, m_pendingOperations[i].data);
+        m_pendingOperations.clear();
+        m_tree.finalize();
+
+        m_optimizedNodeCount = m_nodeCount - removed;
+        ALOGV("Recording finalized, %d operations recorded, %d kept, %d bytes",
+              m_nodeCount, m_optimizedNodeCount, m_heap.usedSize());
+#ifdef DEBUG_COUNT
+        ClassTracker::instance()->increment("RecordingOperation (recorded)", m_nodeCount);
+        ClassTracker::instance()->increment("RecordingOperation (kept)", m_optimizedNodeCount);
+        ClassTracker::instance()->increment("RecordingBytes", m_heap.usedSize());
+#endif
+    }
+
     RTree::RTree m_tree;
     int m_nodeCount;
+    int m_optimizedNodeCount;
 
     void dumpMemoryStats() {
         static const char* PREFIX = "  ";
@@ -301,6 +392,45 @@ public:
 
 private:
 
+    struct PendingOperation {
+        PendingOperation(const IntRect& bounds, RecordingData* data)
+            : bounds(bounds)
+            , data(data)
+        {}
+        IntRect bounds;
+        RecordingData* data;
+    };
+
+    // Merges drawing operations that are played back one after the other
+    // (nothing recorded in between) when they can be drawn as one.
+    // Returns the number of operations removed.
+    size_t mergeDrawingOperations() {
+        size_t removed = 0;
+        size_t lastId = 0;
+        Vector<PendingOperation> operations;
+        operations.reserveCapacity(m_pendingOperations.size());
+        for (size_t i = 0; i < m_pendingOperations.size(); i++) {
+            PendingOperation& pending = m_pendingOperations[i];
+            PendingOperation* previous = operations.size() ? &operations.last() : 0;
+            if (previous && pending.data->m_orderBy == lastId + 1
+                && previous->data->m_operation->merge(pending.data->m_operation)) {
+                previous->bounds.unite(pending.bounds);
+                pending.data->~RecordingData();
+                removed++;
+            } else
+                operations.append(pending);
+            lastId = pending.data->m_orderBy;
+        }
+        m_pendingOperations.swap(operations);
+        return removed;
+    }
+
+    void clearPendingOperations() {
+        for (size_t i = 0; i < m_pendingOperations.size(); i++)
+            m_pendingOperations[i].data->~RecordingData();
+        m_pendingOperations.clear();
+    }
+
     void clearStates() {
         StateHashSet::iterator end = m_states.end();
         for (StateHashSet::iterator it = m_states.begin(); it != end; ++it)
@@ -324,6 +454,8 @@ private:
     StateHashSet m_states;
     SkPaintHashSet m_paints;
     Vector<CanvasState*> m_canvasStates;
+    Vector<PendingOperation> m_pendingOperations;
+    bool m_finalized;
 };
 
 Recording::~Recording()
@@ -481,6 +613,57 @@ void Recording::draw(SkCanvas* canvas)
     }
 }
 
+// Returns true if the nodes drawn in area leave it filled with a single color
+static bool isSolidColorOperation(const Vector<RecordingData*>& nodes,
+                                  const IntRect& area, Color& color)
+{
+    // Only the last operation drawn in the area matters: if it is an opaque
+    // fill covering the whole area, everything below it is hidden
+    RecordingData* top = 0;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (!top || nodes[i]->m_orderBy > top->m_orderBy)
+            top = nodes[i];
+    }
+    if (!top)
+        return false;
+
+    GraphicsOperation::Operation* op = top->m_operation;
+    const IntRect* opaqueRect = op->opaqueRect();
+    if (!opaqueRect || !opaqueRect->contains(area))
+        return false;
+    GraphicsOperation::FillRect* fill = op->asFillRect();
+    if (!fill || !fill->solidColor(color))
+        return false;
+    ALOGV("Area " INT_RECT_FORMAT " is covered by %s() with color %x",
+          INT_RECT_ARGS(area), op->name(), color.rgb());
+    return true;
+}
+
+bool Recording::isSolidColor(const IntRect& area, Color& color)
+{
+    if (!m_recording || area.isEmpty())
+        return false;
+    Vector<RecordingData*> nodes;
+    m_recording->m_tree.search(area, nodes);
+    return isSolidColorOperation(nodes, area, color);
+}
+
+void Recording::findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+{
+    colors.clear();
+    colors.resize(areas.size());
+    if (!m_recording)
+        return;
+
+    Vector<Vector<RecordingData*> > lists;
+    m_recording->m_tree.search(areas, lists);
+    for (size_t i = 0; i < areas.size(); i++) {
+        Color color;
+        if (!areas[i].isEmpty() && isSolidColorOperation(lists[i], areas[i], color))
+            colors[i] = color;
+    }
+}
+
 void Recording::setRecording(RecordingImpl* impl)
 {
     if (m_recording == impl)
@@ -514,6 +697,8 @@ PlatformGraphicsContextRecording::PlatformGraphicsContextRecording(Recording* re
 PlatformGraphicsContextRecording::~PlatformGraphicsContextRecording()
 {
     ALOGV("RECORDING: end");
+    if (mRecording)
+        mRecording->recording()->finalize();
     IF_ALOGV()
         mRecording->recording()->dumpMemoryStats();
 }
@@ -1071,7 +1256,7 @@ void PlatformGraphicsContextRecording::appendDrawingOperation(
     ALOGV("RECORDING: appendOperation %p->%s() bounds " INT_RECT_FORMAT, operation, operation->name(),
             INT_RECT_ARGS(ibounds));
     RecordingData* data = new (heap()) RecordingData(operation, mRecording->recording()->m_nodeCount++);
-    mRecording->recording()->m_tree.insert(ibounds, data);
+    mRecording->recording()->appendDrawingOperation(ibounds, data);
 }
 
 void PlatformGraphicsContextRecording::appendStateOperation(GraphicsOperation::Operation* operation)
@@ -53,6 +53,12 @@ public:
     ~Recording();
 
     void draw(SkCanvas* canvas);
+    // Returns true if the recording is proven to paint the area, in
+    // recording coordinates, with a single opaque color
+    bool isSolidColor(const IntRect& area, Color& color);
+    // Same as isSolidColor() for several areas, with a single search of the
+    // recording: colors[i] is left invalid if areas[i] isn't a single color
+    void findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors);
     void setRecording(RecordingImpl* impl);
     RecordingImpl* recording() { return m_recording; }
 
@@ -31,7 +31,9 @@
 #include "RTree.h"
 
 #include "AndroidLog.h"
+#include <algorithm>
 #include <utils/LinearAllocator.h>
+#include <wtf/MathExtras.h>
 
 namespace WebCore {
 
@@ -130,6 +132,19 @@ int computeDeltaArea(Node* node, int& minx, int& miny,
 // If N's parent is also full, we go up in the hierachy and repeat
 // (Node::adjustTree()).
 //
+// Bulk loading
+// ------------
+//
+// Recordings know all their elements up front, so rather than inserting
+// them one at a time (and paying for the splits), they are queued with
+// RTree::append() and packed bottom-up in RTree::finalize(), following
+// "STR: A Simple and Efficient Algorithm for R-Tree Packing",
+// Leutenegger et al. (97). At each level, the n nodes are sorted by the
+// x coordinate of their center and cut into ceil(sqrt(n / M)) vertical
+// slices; each slice is then sorted by y and packed in runs of M nodes.
+// Nodes of a level are allocated consecutively, which keeps siblings close
+// to each other in memory during searches.
+//
 //////////////////////////////////////////////////////////////////////
 
 RTree::RTree(android::LinearAllocator* allocator, int M)
@@ -146,6 +161,8 @@ RTree::~RTree()
     delete m_listA;
     delete m_listB;
     deleteNode(m_root);
+    for (unsigned i = 0; i < m_pending.size(); i++)
+        deleteNode(m_pending[i]);
 }
 
 void RTree::insert(WebCore::IntRect& bounds, WebCore::RecordingData* payload)
@@ -155,11 +172,93 @@ void RTree::insert(WebCore::IntRect& bounds, WebCore::RecordingData* payload)
     m_root->insert(e);
 }
 
-void RTree::search(WebCore::IntRect& clip, Vector<WebCore::RecordingData*>&list)
+void RTree::append(WebCore::IntRect& bounds, WebCore::RecordingData* payload)
+{
+    m_pending.append(Node::create(this, bounds.x(), bounds.y(),
+                                  bounds.maxX(), bounds.maxY(), payload));
+}
+
+static bool compareCenterX(const Node* a, const Node* b)
+{
+    return a->m_minX + a->m_maxX < b->m_minX + b->m_maxX;
+}
+
+static bool compareCenterY(const Node* a, const Node* b)
+{
+    return a->m_minY + a->m_maxY < b->m_minY + b->m_maxY;
+}
+
+void RTree::packLevel(Vector<Node*>& level)
+{
+    unsigned count = level.size();
+    unsigned nbParents = (count + m_maxChildren - 1) / m_maxChildren;
+    unsigned nbSlices = static_cast<unsigned>(ceilf(sqrtf(nbParents)));
+    unsigned sliceSize = nbSlices * m_maxChildren;
+
+    std::sort(level.begin(), level.end(), compareCenterX);
+
+    Vector<Node*> parents;
+    parents.reserveCapacity(nbParents + nbSlices);
+    for (unsigned start = 0; start < count; start += sliceSize) {
+        unsigned end = std::min(start + sliceSize, count);
+        std::sort(level.begin() + start, level.begin() + end, compareCenterY);
+        for (unsigned i = start; i < end; i += m_maxChildren) {
+            Node* parent = Node::create(this);
+            unsigned last = std::min(i + m_maxChildren, end);
+            for (unsigned j = i; j < last; j++)
+                parent->simpleAdd(level[j]);
+            parent->tighten();
+            parents.append(parent);
+        }
+    }
+    level.swap(parents);
+}
+
+void RTree::finalize()
+{
+    if (m_pending.isEmpty())
+        return;
+
+    if (m_root->m_nbChildren) {
+        // the tree already has content, fall back to regular insertions
+        for (unsigned i = 0; i < m_pending.size(); i++)
+            m_root->insert(m_pending[i]);
+        m_pending.clear();
+        return;
+    }
+
+    Vector<Node*> level;
+    level.swap(m_pending);
+    while (level.size() > m_maxChildren)
+        packLevel(level);
+
+    for (unsigned i = 0; i < level.size(); i++)
+        m_root->simpleAdd(level[i]);
+    m_root->tighten();
+}
+
+void RTree::search(const WebCore::IntRect& clip, Vector<WebCore::RecordingData*>& list)
 {
+    ASSERT(m_pending.isEmpty());
     m_root->search(clip.x(), clip.y(), clip.maxX(), clip.maxY(), list);
 }
 
+void RTree::search(const Vector<WebCore::IntRect>& clips,
+                   Vector<Vector<WebCore::RecordingData*> >& lists)
+{
+    ASSERT(m_pending.isEmpty());
+    lists.clear();
+    lists.resize(clips.size());
+
+    Vector<unsigned, 32> candidates;
+    for (unsigned i = 0; i < clips.size(); i++) {
+        if (m_root->overlap(clips[i].x(), clips[i].y(), clips[i].maxX(), clips[i].maxY()))
+            candidates.append(i);
+    }
+    if (candidates.size())
+        m_root->search(clips, candidates, lists);
+}
+
 void RTree::remove(WebCore::IntRect& clip)
 {
     m_root->remove(clip.x(), clip.y(), clip.maxX(), clip.maxY());
@@ -268,9 +367,9 @@ Node::Node(RTree* t, int minx, int miny, int maxx, int maxy, WebCore::RecordingD
 
 Node::~Node()
 {
+    // m_children lives in the tree's LinearAllocator, no need to free it
     for (unsigned i = 0; i < m_nbChildren; i++)
         m_tree->deleteNode(m_children[i]);
-    delete[] m_children;
     if (m_payload)
         m_payload->~RecordingData();
 }
@@ -321,11 +420,17 @@ int Node::delta(Node* node)
     return computeDeltaArea(node, m_minX, m_minY, m_maxX, m_maxY);
 }
 
+void Node::allocateChildren()
+{
+    void* buffer = m_tree->m_allocator->alloc(sizeof(Node*) * (m_tree->m_maxChildren + 1));
+    m_children = static_cast<Node**>(buffer);
+}
+
 void Node::simpleAdd(Node* node)
 {
     node->setParent(this);
     if (!m_children)
-        m_children = new Node*[m_tree->m_maxChildren + 1];
+        allocateChildren();
     m_children[m_nbChildren] = node;
     m_nbChildren++;
 }
@@ -577,6 +682,29 @@ void Node::search(int minx, int miny, int maxx, int maxy, Vector<WebCore::Record
     }
 }
 
+void Node::search(const Vector<WebCore::IntRect>& clips, const Vector<unsigned, 32>& candidates,
+                  Vector<Vector<WebCore::RecordingData*> >& lists)
+{
+    // candidates holds the indices of the clips overlapping this node
+    if (isElement()) {
+        for (unsigned i = 0; i < candidates.size(); i++)
+            lists[candidates[i]].append(m_payload);
+    }
+
+    Vector<unsigned, 32> childCandidates;
+    for (unsigned int i = 0; i < m_nbChildren; i++) {
+        Node* child = m_children[i];
+        childCandidates.shrink(0);
+        for (unsigned j = 0; j < candidates.size(); j++) {
+            const WebCore::IntRect& clip = clips[candidates[j]];
+            if (child->overlap(clip.x(), clip.y(), clip.maxX(), clip.maxY()))
+                childCandidates.append(candidates[j]);
+        }
+        if (childCandidates.size())
+            child->search(clips, childCandidates, lists);
+    }
+}
+
 bool Node::inside(int minx, int miny, int maxx, int maxy)
 {
     return (minx <= m_minX
@@ -70,8 +70,18 @@ public:
     ~RTree();
 
     void insert(WebCore::IntRect& bounds, WebCore::RecordingData* payload);
+    // Queues an element without touching the tree; queued elements are
+    // bulk loaded when finalize() is called
+    void append(WebCore::IntRect& bounds, WebCore::RecordingData* payload);
+    // Builds the tree from the queued elements (Sort-Tile-Recursive packing
+    // if the tree is empty, regular insertions otherwise)
+    void finalize();
     // Does an overlap search
-    void search(WebCore::IntRect& clip, Vector<WebCore::RecordingData*>& list);
+    void search(const WebCore::IntRect& clip, Vector<WebCore::RecordingData*>& list);
+    // Does an overlap search for several clips in a single traversal,
+    // lists[i] receives the elements overlapping clips[i]
+    void search(const Vector<WebCore::IntRect>& clips,
+                Vector<Vector<WebCore::RecordingData*> >& lists);
     // Does an inclusive remove -- all elements fully inside the clip will
     // be removed from the tree
     void remove(WebCore::IntRect& clip);
@@ -81,12 +91,14 @@ public:
     void deleteNode(Node* n);
 
 private:
+    void packLevel(Vector<Node*>& level);
 
     Node* m_root;
     unsigned m_maxChildren;
     ElementList* m_listA;
     ElementList* m_listB;
     android::LinearAllocator* m_allocator;
+    Vector<Node*> m_pending;
 
     friend class Node;
 };
@@ -132,6 +144,8 @@ public:
 
     void insert(Node* n);
     void search(int minx, int miny, int maxx, int maxy, Vector<WebCore::RecordingData*>& list);
+    void search(const Vector<WebCore::IntRect>& clips, const Vector<unsigned, 32>& candidates,
+                Vector<Vector<WebCore::RecordingData*> >& lists);
     void remove(int minx, int miny, int maxx, int maxy);
 
     // Intentionally not implemented as Node* is custom allocated, we don't want to use this
@@ -143,6 +157,7 @@ private:
     void setParent(Node* n);
     Node* findNode(Node* n);
     void simpleAdd(Node* n);
+    void allocateChildren();
     void add(Node* n);
     void remove(Node* n);
     void destroy(int index);
@@ -169,6 +184,8 @@ private:
 
     WebCore::RecordingData* m_payload;
 
+    friend class RTree;
+
 public:
 
     int m_minX;
@@ -322,6 +322,12 @@ void CanvasLayer::contentDraw(SkCanvas* canvas, PaintStyle style)
     canvas->drawBitmapRect(bitmap, 0, dst, 0);
 }
 
+void CanvasLayer::contentFindSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+{
+    colors.clear();
+    colors.resize(areas.size());
+}
+
 bool CanvasLayer::drawGL(bool layerTilesDisabled)
 {
     MutexLocker locker(s_mutex);
@@ -54,6 +54,8 @@ public:
 
     virtual bool drawGL(bool layerTilesDisabled);
     virtual void contentDraw(SkCanvas* canvas, PaintStyle style);
+    virtual bool contentIsSolidColor(const IntRect& area, Color& color) { return false; }
+    virtual void contentFindSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors);
     virtual bool needsTexture();
     virtual bool needsIsolatedSurface() { return true; }
 
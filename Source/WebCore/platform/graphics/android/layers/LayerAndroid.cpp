@@ -73,6 +73,9 @@ LayerAndroid::LayerAndroid(RenderLayer* owner) : Layer(),
     m_imageCRC(0),
     m_scale(1),
     m_lastComputeTextureSize(0),
+    m_damageOpacity(1),
+    m_hasDamageState(false),
+    m_contentDamaged(false),
     m_owningLayer(owner),
     m_type(LayerAndroid::WebCoreLayer),
     m_intrinsicallyComposited(true),
@@ -103,6 +106,9 @@ LayerAndroid::LayerAndroid(const LayerAndroid& layer) : Layer(layer),
     m_imageCRC(layer.m_imageCRC),
     m_scale(layer.m_scale),
     m_lastComputeTextureSize(0),
+    m_damageOpacity(1),
+    m_hasDamageState(false),
+    m_contentDamaged(false),
     m_owningLayer(layer.m_owningLayer),
     m_type(LayerAndroid::UILayer),
     m_intrinsicallyComposited(layer.m_intrinsicallyComposited),
@@ -297,6 +303,38 @@ void LayerAndroid::addDirtyArea()
         getChild(i)->addDirtyArea();
 }
 
+bool LayerAndroid::collectDamage(SkRegion& damage, bool parentVisible)
+{
+    bool visible = parentVisible && m_visible;
+    FloatRect area;
+    if (visible) {
+        area = m_drawTransform.mapRect(FloatRect(0, 0, getWidth(), getHeight()));
+        area.intersect(m_clippingRect);
+    }
+
+    bool damaged = !m_hasDamageState || m_contentDamaged
+        || area != m_damageArea
+        || m_drawOpacity != m_damageOpacity
+        || getScrollOffset() != m_damageScrollOffset;
+    bool fullDamage = false;
+    if (damaged) {
+        if (m_drawTransform.hasPerspective())
+            fullDamage = true;
+        damage.op(enclosingIntRect(m_damageArea), SkRegion::kUnion_Op);
+        damage.op(enclosingIntRect(area), SkRegion::kUnion_Op);
+    }
+
+    m_damageArea = area;
+    m_damageOpacity = m_drawOpacity;
+    m_damageScrollOffset = getScrollOffset();
+    m_hasDamageState = true;
+    m_contentDamaged = false;
+
+    for (int i = 0; i < countChildren(); i++)
+        fullDamage |= getChild(i)->collectDamage(damage, visible);
+    return fullDamage;
+}
+
 void LayerAndroid::addAnimation(PassRefPtr<AndroidAnimation> prpAnim)
 {
     RefPtr<AndroidAnimation> anim = prpAnim;
@@ -873,6 +911,65 @@ bool LayerAndroid::drawTreeSurfacesGL()
     return askScreenUpdate;
 }
 
+void LayerAndroid::drawSurfaceAndChildrenCanvas(SkCanvas* canvas, float scale,
+                                                SoftwareRenderer* renderer)
+{
+    if (surface()->getFirstLayer() == this)
+        surface()->drawCanvas(canvas, scale, renderer);
+
+    // return early, since children will be painted directly by drawTreeSurfacesCanvas
+    if (preserves3D())
+        return;
+
+    int count = countChildren();
+    Vector <LayerAndroid*> sublayers;
+    for (int i = 0; i < count; i++)
+        sublayers.append(getChild(i));
+
+    std::stable_sort(sublayers.begin(), sublayers.end(), compareLayerZ);
+    for (int i = 0; i < count; i++)
+        sublayers[i]->drawTreeSurfacesCanvas(canvas, scale, renderer);
+}
+
+void LayerAndroid::drawTreeSurfacesCanvas(SkCanvas* canvas, float scale,
+                                          SoftwareRenderer* renderer)
+{
+    if (preserves3D()) {
+        // hit a preserve-3d layer, so render the entire 3D rendering context in z order
+        Vector<LayerAndroid*> contextLayers;
+        collect3dRenderingContext(contextLayers);
+        std::stable_sort(contextLayers.begin(), contextLayers.end(), compareLayerZ);
+
+        for (unsigned int i = 0; i < contextLayers.size(); i++)
+            contextLayers[i]->drawSurfaceAndChildrenCanvas(canvas, scale, renderer);
+    } else
+        drawSurfaceAndChildrenCanvas(canvas, scale, renderer);
+}
+
+void LayerAndroid::drawImageCanvas(SkCanvas* canvas)
+{
+    if (!m_imageCRC)
+        return;
+
+    ImageTexture* imageTexture = ImagesManager::instance()->retainImage(m_imageCRC);
+    const TransformationMatrix* transform = drawTransform();
+    if (imageTexture && transform) {
+        SkAutoCanvasRestore restore(canvas, true);
+        SkMatrix matrix;
+        GLUtils::toSkMatrix(matrix, *transform);
+        canvas->concat(matrix);
+
+        int canvasOpacity = SkScalarRound(getOpacity() * 255);
+        if (canvasOpacity < 255)
+            SkSafeUnref(canvas->setDrawFilter(new OpacityDrawFilter(canvasOpacity)));
+
+        SkRect dest;
+        dest.set(0, 0, getSize().width(), getSize().height());
+        imageTexture->drawCanvas(canvas, dest);
+    }
+    ImagesManager::instance()->releaseImage(m_imageCRC);
+}
+
 bool LayerAndroid::drawGL(bool layerTilesDisabled)
 {
     if (!layerTilesDisabled && m_imageCRC) {
@@ -911,6 +1008,23 @@ bool LayerAndroid::drawChildrenCanvas(SkCanvas* canvas, PaintStyle style)
     return askScreenUpdate;
 }
 
+bool LayerAndroid::contentIsSolidColor(const IntRect& area, Color& color)
+{
+    if (m_maskLayer || !m_content || TilesManager::instance()->getShowVisualIndicator())
+        return false;
+    return m_content->isSolidColor(area, color);
+}
+
+void LayerAndroid::contentFindSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+{
+    if (m_maskLayer || !m_content || TilesManager::instance()->getShowVisualIndicator()) {
+        colors.clear();
+        colors.resize(areas.size());
+        return;
+    }
+    m_content->findSolidColors(areas, colors);
+}
+
 void LayerAndroid::contentDraw(SkCanvas* canvas, PaintStyle style)
 {
     if (m_maskLayer && m_maskLayer->m_content) {
@@ -52,6 +52,7 @@ namespace WebCore {
 class LayerAndroid;
 class LayerContent;
 class ImageTexture;
+class SoftwareRenderer;
 class Surface;
 }
 
@@ -153,6 +154,10 @@ public:
 
     // draw the layer tree recursively in draw order, grouping and sorting 3d rendering contexts
     bool drawTreeSurfacesGL();
+    // same as drawTreeSurfacesGL, rendering the surfaces in software onto the canvas
+    void drawTreeSurfacesCanvas(SkCanvas* canvas, float scale, SoftwareRenderer* renderer);
+    // draw the layer image (if any) onto a canvas in content coordinates
+    void drawImageCanvas(SkCanvas* canvas);
 
     virtual bool drawGL(bool layerTilesDisabled);
     virtual bool drawCanvas(SkCanvas* canvas, bool drawChildren, PaintStyle style);
@@ -199,6 +204,14 @@ public:
     bool hasAnimations() const;
     void addDirtyArea();
 
+    // Adds to damage the areas (in content coordinates) covered before and
+    // after the change by the layers that moved, changed opacity, scrolled or
+    // got new content since the last call. Returns true if a damaged layer
+    // has a perspective transform and its area can't be tracked.
+    bool collectDamage(SkRegion& damage, bool parentVisible = true);
+    void setContentDamaged() { m_contentDamaged = true; }
+    const FloatRect& damageArea() const { return m_damageArea; }
+
     void dumpLayers(LayerDumper*) const;
 
     virtual IFrameLayerAndroid* updatePosition(SkRect viewport,
@@ -237,6 +250,11 @@ public:
     virtual void clearDirtyRegion();
 
     virtual void contentDraw(SkCanvas* canvas, PaintStyle style);
+    // returns true if contentDraw() is known to paint area with a single
+    // opaque color, without having to draw it
+    virtual bool contentIsSolidColor(const IntRect& area, Color& color);
+    // same as contentIsSolidColor() for several areas at once
+    virtual void contentFindSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors);
 
     virtual bool isMedia() const { return false; }
     virtual bool isVideo() const { return false; }
@@ -320,6 +338,7 @@ private:
     // recurse through the current 3d rendering context, adding layers in the context to the vector
     void collect3dRenderingContext(Vector<LayerAndroid*>& layersInContext);
     bool drawSurfaceAndChildrenGL();
+    void drawSurfaceAndChildrenCanvas(SkCanvas* canvas, float scale, SoftwareRenderer* renderer);
 
 #if DUMP_NAV_CACHE
     friend class CachedLayer::Debug; // debugging access only
@@ -387,6 +406,13 @@ private:
     static const double s_computeTextureDelay = 0.2; // 200 ms
     double m_lastComputeTextureSize;
 
+    // state of the layer when the damage was last collected
+    FloatRect m_damageArea;
+    float m_damageOpacity;
+    IntPoint m_damageScrollOffset;
+    bool m_hasDamageState;
+    bool m_contentDamaged;
+
     RenderLayer* m_owningLayer;
 
     LayerType m_type;
@@ -26,9 +26,11 @@
 #ifndef LayerContent_h
 #define LayerContent_h
 
+#include "Color.h"
 #include "IntRect.h"
 #include "SkRefCnt.h"
 #include <utils/threads.h>
+#include <wtf/Vector.h>
 
 class SkCanvas;
 class SkPicture;
@@ -47,6 +49,15 @@ public:
     virtual void checkForOptimisations() = 0;
     virtual float maxZoomScale() = 0;
     virtual void draw(SkCanvas* canvas) = 0;
+    // returns true if the content is known to be a single opaque color over area
+    virtual bool isSolidColor(const IntRect& area, Color& color) { return false; }
+    // same as isSolidColor() for several areas, colors[i] is left invalid
+    // when areas[i] isn't known to be a single color
+    virtual void findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+    {
+        colors.clear();
+        colors.resize(areas.size());
+    }
     virtual PrerenderedInval* prerenderForRect(const IntRect& dirty) { return 0; }
     virtual void clearPrerenders() { };
 
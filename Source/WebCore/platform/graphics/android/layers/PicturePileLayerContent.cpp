@@ -27,6 +27,22 @@ void PicturePileLayerContent::draw(SkCanvas* canvas)
         ALOGW("Warning: painting PicturePile without content!");
 }
 
+bool PicturePileLayerContent::isSolidColor(const IntRect& area, Color& color)
+{
+    android::Mutex::Autolock lock(m_drawLock);
+    return m_hasContent && m_picturePile.isSolidColor(area, color);
+}
+
+void PicturePileLayerContent::findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+{
+    android::Mutex::Autolock lock(m_drawLock);
+    if (!m_hasContent) {
+        LayerContent::findSolidColors(areas, colors);
+        return;
+    }
+    m_picturePile.findSolidColors(areas, colors);
+}
+
 void PicturePileLayerContent::serialize(SkWStream* stream)
 {
     if (!stream)
@@ -43,6 +43,8 @@ public:
     virtual void checkForOptimisations() {} // already performed, stored in m_hasText/m_hasContent
     virtual float maxZoomScale() { return m_maxZoomScale; }
     virtual void draw(SkCanvas* canvas);
+    virtual bool isSolidColor(const IntRect& area, Color& color);
+    virtual void findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors);
     virtual void serialize(SkWStream* stream);
     virtual PrerenderedInval* prerenderForRect(const IntRect& dirty);
     virtual void clearPrerenders();
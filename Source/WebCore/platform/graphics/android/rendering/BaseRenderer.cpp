@@ -32,6 +32,7 @@
 #if USE(ACCELERATED_COMPOSITING)
 
 #include "AndroidLog.h"
+#include "FloatRect.h"
 #include "GLUtils.h"
 #include "InstrumentedPlatformCanvas.h"
 #include "RasterRenderer.h"
@@ -92,6 +93,16 @@ void BaseRenderer::renderTiledContent(TileRenderInfo& renderInfo)
     const bool visualIndicator = TilesManager::instance()->getShowVisualIndicator();
     const SkSize& tileSize = renderInfo.tileSize;
 
+    // Ganesh locks the transfer queue and uploads from setupCanvas, so it
+    // can't complete a tile without painting it
+    if (!visualIndicator && getType() != Ganesh && checkForRecordedPureColor(renderInfo)) {
+        renderingComplete(renderInfo, 0);
+        return;
+    }
+
+    if (!visualIndicator && restoreContent(renderInfo))
+        return;
+
     Color *background = renderInfo.tilePainter->background();
     InstrumentedPlatformCanvas canvas(TilesManager::instance()->tileWidth(),
                                       TilesManager::instance()->tileHeight(),
@@ -150,6 +161,29 @@ void BaseRenderer::checkForPureColor(TileRenderInfo& renderInfo, InstrumentedPla
     deviceCheckForPureColor(renderInfo, &canvas);
 }
 
+bool BaseRenderer::checkForRecordedPureColor(TileRenderInfo& renderInfo)
+{
+    // the area of the content covered by the tile
+    const SkSize& tileSize = renderInfo.tileSize;
+    FloatRect area(renderInfo.x * tileSize.width(), renderInfo.y * tileSize.height(),
+                   tileSize.width(), tileSize.height());
+    area.scale(1 / renderInfo.scale);
+
+    Color color;
+    if (renderInfo.recordedColorChecked) {
+        color = renderInfo.recordedColor;
+        if (!color.isValid())
+            return false;
+    } else if (!renderInfo.tilePainter->isSolidColor(area, color))
+        return false;
+
+    ALOGV("tile (%d, %d) at scale %.2f is pure color %x from the recording",
+          renderInfo.x, renderInfo.y, renderInfo.scale, color.rgb());
+    renderInfo.isPureColor = true;
+    renderInfo.pureColor = color;
+    return true;
+}
+
 } // namespace WebCore
 
 #endif // USE(ACCELERATED_COMPOSITING)
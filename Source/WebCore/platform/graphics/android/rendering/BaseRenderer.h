@@ -62,8 +62,16 @@ struct TileRenderInfo {
     // info about the texture that we are to render into
     TextureInfo* textureInfo;
 
+    // version of the tile content when painting started
+    unsigned int contentVersion;
+
     bool isPureColor;
     Color pureColor;
+
+    // whether the recording was already searched for a single color while
+    // preparing the tile, recordedColor is invalid if it wasn't found
+    bool recordedColorChecked;
+    Color recordedColor;
 };
 
 /**
@@ -71,7 +79,7 @@ struct TileRenderInfo {
  */
 class BaseRenderer {
 public:
-    enum RendererType { Raster, Ganesh };
+    enum RendererType { Raster, Ganesh, Software };
     BaseRenderer(RendererType type) : m_type(type) {}
     virtual ~BaseRenderer() {}
 
@@ -87,8 +95,13 @@ public:
 protected:
 
     virtual void setupCanvas(const TileRenderInfo& renderInfo, SkCanvas* canvas) = 0;
+    // canvas is 0 if the tile content was obtained without painting it
     virtual void renderingComplete(const TileRenderInfo& renderInfo, SkCanvas* canvas) = 0;
     void checkForPureColor(TileRenderInfo& renderInfo, InstrumentedPlatformCanvas& canvas);
+    bool checkForRecordedPureColor(TileRenderInfo& renderInfo);
+
+    // restores the content previously painted for the tile, if it was kept
+    virtual bool restoreContent(TileRenderInfo& renderInfo) { return false; }
 
     // performs additional pure color check, renderInfo.isPureColor may already be set to true
     virtual void deviceCheckForPureColor(TileRenderInfo& renderInfo, SkCanvas* canvas) = 0;
@@ -38,6 +38,14 @@
 #include "TileGrid.h"
 #include "TilesManager.h"
 
+// Bitmaps bigger than this are not hashed entirely, only a sample of their
+// pixels is, so that computing the key of a large image doesn't stall the
+// webcore thread
+#define CRC_SAMPLE_THRESHOLD (256 * 1024)
+
+// Approximate number of bytes hashed for a sampled bitmap
+#define CRC_SAMPLE_BYTES (64 * 1024)
+
 namespace WebCore {
 
 // CRC computation adapted from Tools/DumpRenderTree/CyclicRedundancyCheck.cpp
@@ -55,7 +63,7 @@ static void makeCrcTable(unsigned crcTable[256])
     }
 }
 
-unsigned computeCrc(uint8_t* buffer, size_t size)
+static unsigned updateCrc(unsigned crc, const uint8_t* buffer, size_t size)
 {
     static unsigned crcTable[256];
     static bool crcTableComputed = false;
@@ -64,9 +72,35 @@ unsigned computeCrc(uint8_t* buffer, size_t size)
         crcTableComputed = true;
     }
 
-    unsigned crc = 0xffffffffL;
     for (size_t i = 0; i < size; ++i)
         crc = crcTable[(crc ^ buffer[i]) & 0xff] ^ ((crc >> 8) & 0x00ffffffL);
+    return crc;
+}
+
+unsigned computeCrc(uint8_t* buffer, size_t size)
+{
+    return updateCrc(0xffffffffL, buffer, size) ^ 0xffffffffL;
+}
+
+// Hashes the dimensions of the bitmap and a spread of 32 bit words from every
+// row. The first sampled word is shifted from one row to the next so that all
+// the columns get covered over the height of the image.
+static unsigned computeSampledCrc(const SkBitmap* bitmap, const uint8_t* pixels)
+{
+    int width = bitmap->width();
+    int height = bitmap->height();
+    unsigned crc = 0xffffffffL;
+    crc = updateCrc(crc, reinterpret_cast<const uint8_t*>(&width), sizeof(width));
+    crc = updateCrc(crc, reinterpret_cast<const uint8_t*>(&height), sizeof(height));
+
+    int rowWords = width * bitmap->bytesPerPixel() / sizeof(uint32_t);
+    int sampledWords = std::max(1, static_cast<int>(CRC_SAMPLE_BYTES / sizeof(uint32_t) / height));
+    int stride = std::max(1, rowWords / sampledWords);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + y * bitmap->rowBytes();
+        for (int x = y % stride; x < rowWords; x += stride)
+            crc = updateCrc(crc, row + x * sizeof(uint32_t), sizeof(uint32_t));
+    }
     return crc ^ 0xffffffffL;
 }
 
@@ -130,8 +164,13 @@ unsigned ImageTexture::computeCRC(const SkBitmap* bitmap)
     bitmap->lockPixels();
     uint8_t* img = static_cast<uint8_t*>(bitmap->getPixels());
     unsigned crc = 0;
-    if (img)
-        crc = computeCrc(img, bitmap->getSize());
+    if (img) {
+        size_t size = bitmap->getSize();
+        if (size > CRC_SAMPLE_THRESHOLD && bitmap->bytesPerPixel() >= 2)
+            crc = computeSampledCrc(bitmap, img);
+        else
+            crc = computeCrc(img, size);
+    }
     bitmap->unlockPixels();
     return crc;
 }
@@ -55,13 +55,16 @@ class TileGrid;
 // is stored in ImagesManager using its CRC as a hash key.
 // Simply comparing the address is not enough -- different image could end up
 // at the same address (i.e. the image is deallocated then a new one is
-// reallocated at the old address)
+// reallocated at the old address). Large bitmaps only get a sample of their
+// pixels hashed, to keep the cost of computing the key bounded.
 //
 // Each ImageTexture's CRC being unique, LayerAndroid instances simply store that
 // and retain/release the corresponding ImageTexture (so that
 // queued painting request will work correctly and not crash...).
 // LayerAndroid running on the UI thread will get the corresponding
-// ImageTexture at draw time.
+// ImageTexture at draw time. ImagesManager keeps a reference of its own on
+// the ImageTexture, so that an image no longer used by any layer stays around
+// (within a memory budget) in case it gets used again.
 //
 // ImageTexture recopy the original SkBitmap so that they can safely be used
 // on a different thread; it uses TileGrid to allocate and paint the image,
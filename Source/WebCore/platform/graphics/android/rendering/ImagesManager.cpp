@@ -35,8 +35,21 @@
 #include "SkRefCnt.h"
 #include "ImageTexture.h"
 
+#include <cutils/properties.h>
+#include <limits>
+
+// Default byte budget for the images no longer used by any layer, can be
+// overridden (in KB) with the webkit.images.cache_kb system property;
+// 0 releases the images as soon as they are unused
+#define DEFAULT_UNUSED_IMAGES_BUDGET (8 * 1024 * 1024)
+
 namespace WebCore {
 
+static size_t imageBytes(ImageTexture* image)
+{
+    return image->bitmap() ? image->bitmap()->getSize() : 0;
+}
+
 ImagesManager* ImagesManager::instance()
 {
     if (!gInstance)
@@ -47,6 +60,77 @@ ImagesManager* ImagesManager::instance()
 
 ImagesManager* ImagesManager::gInstance = 0;
 
+ImagesManager::ImagesManager()
+    : m_unusedBytes(0)
+    , m_budget(DEFAULT_UNUSED_IMAGES_BUDGET)
+    , m_hitCount(0)
+    , m_missCount(0)
+    , m_evictedCount(0)
+{
+    char value[PROPERTY_VALUE_MAX];
+    if (property_get("webkit.images.cache_kb", value, 0) > 0)
+        m_budget = std::max(0, atoi(value)) * 1024;
+}
+
+// 0 means no image, and the largest value can't be stored in the map
+static unsigned validImageKey(unsigned key)
+{
+    while (!key || key == std::numeric_limits<unsigned>::max())
+        key++;
+    return key;
+}
+
+// The CRC of a large bitmap only covers a sample of its pixels, and any CRC
+// can collide, so the content is compared before an image is shared, unless
+// the bitmap has the pixels the image was made from (see isSameSource)
+static bool hasSameContent(ImageTexture* image, SkBitmap* bitmap)
+{
+    SkBitmap* content = image->bitmap();
+    if (!content || content->width() != bitmap->width()
+        || content->height() != bitmap->height())
+        return false;
+
+    // the ImageTexture holds an 8888 copy of the bitmap
+    SkBitmap* converted = 0;
+    if (bitmap->config() != SkBitmap::kARGB_8888_Config)
+        bitmap = converted = ImageTexture::convertBitmap(bitmap);
+
+    bool same = true;
+    size_t rowSize = bitmap->width() * bitmap->bytesPerPixel();
+    bitmap->lockPixels();
+    content->lockPixels();
+    const uint8_t* pixels = static_cast<const uint8_t*>(bitmap->getPixels());
+    const uint8_t* contentPixels = static_cast<const uint8_t*>(content->getPixels());
+    if (!pixels || !contentPixels)
+        same = false;
+    for (int y = 0; same && y < bitmap->height(); y++) {
+        same = !memcmp(pixels + y * bitmap->rowBytes(),
+                       contentPixels + y * content->rowBytes(), rowSize);
+    }
+    content->unlockPixels();
+    bitmap->unlockPixels();
+
+    delete converted;
+    return same;
+}
+
+bool ImagesManager::isSameSource(unsigned imgCRC, SkBitmap* bitmap)
+{
+    // NOTE: callers must hold m_imagesLock
+    // the generation ID changes with the pixels, 0 means it is not known
+    uint32_t generationID = bitmap->getGenerationID();
+    return generationID && m_sourceGenerationIDs.get(imgCRC) == generationID;
+}
+
+void ImagesManager::setImageUsed(unsigned imgCRC, ImageTexture* image)
+{
+    // NOTE: callers must hold m_imagesLock
+    if (!m_unusedImages.contains(imgCRC))
+        return;
+    m_unusedImages.remove(imgCRC);
+    m_unusedBytes -= imageBytes(image);
+}
+
 ImageTexture* ImagesManager::setImage(SkBitmapRef* imgRef)
 {
     if (!imgRef)
@@ -56,17 +140,33 @@ ImageTexture* ImagesManager::setImage(SkBitmapRef* imgRef)
     SkBitmap* bitmap = &imgRef->bitmap();
     ImageTexture* image = 0;
     SkBitmap* img = 0;
-    unsigned crc = 0;
-
-    crc = ImageTexture::computeCRC(bitmap);
 
-    {
-        android::Mutex::Autolock lock(m_imagesLock);
-        if (m_images.contains(crc)) {
+    // images whose CRCs collide are kept under the next free keys
+    unsigned crc = validImageKey(ImageTexture::computeCRC(bitmap));
+    while (true) {
+        {
+            android::Mutex::Autolock lock(m_imagesLock);
+            if (!m_images.contains(crc))
+                break;
             image = m_images.get(crc);
             SkSafeRef(image);
+            setImageUsed(crc, image);
+            if (isSameSource(crc, bitmap)) {
+                m_hitCount++;
+                return image;
+            }
+        }
+
+        // compare outside of the lock, the reference keeps the image alive
+        if (hasSameContent(image, bitmap)) {
+            android::Mutex::Autolock lock(m_imagesLock);
+            m_sourceGenerationIDs.set(crc, bitmap->getGenerationID());
+            m_hitCount++;
             return image;
         }
+        ALOGV("image %x has a different content, trying the next key", crc);
+        releaseImage(crc);
+        crc = validImageKey(crc + 1);
     }
 
     // the image is not in the map, we add it
@@ -75,7 +175,13 @@ ImageTexture* ImagesManager::setImage(SkBitmapRef* imgRef)
     image = new ImageTexture(img, crc);
 
     android::Mutex::Autolock lock(m_imagesLock);
+    // reference held by the manager
+    SkSafeRef(image);
     m_images.set(crc, image);
+    m_sourceGenerationIDs.set(crc, bitmap->getGenerationID());
+    m_missCount++;
+    ALOGV("added image %x (%d x %d), %d hits / %d misses",
+          crc, img->width(), img->height(), m_hitCount, m_missCount);
 
     return image;
 }
@@ -90,6 +196,7 @@ ImageTexture* ImagesManager::retainImage(unsigned imgCRC)
     if (m_images.contains(imgCRC)) {
         image = m_images.get(imgCRC);
         SkSafeRef(image);
+        setImageUsed(imgCRC, image);
     }
     return image;
 }
@@ -102,10 +209,14 @@ void ImagesManager::releaseImage(unsigned imgCRC)
     android::Mutex::Autolock lock(m_imagesLock);
     if (m_images.contains(imgCRC)) {
         ImageTexture* image = m_images.get(imgCRC);
-        // don't need to remove image from the HashMap, it will unregister
-        // itself by calling onImageTextureDestroy().
-
         SkSafeUnref(image);
+
+        // only the manager's reference is left, keep the image for reuse
+        if (image->getRefCnt() == 1) {
+            m_unusedImages.add(imgCRC);
+            m_unusedBytes += imageBytes(image);
+            evictUnusedImages(m_budget);
+        }
     }
 }
 
@@ -114,6 +225,37 @@ void ImagesManager::onImageTextureDestroy(unsigned imgCRC)
     // NOTE: all unrefs must go through releaseImage, to ensure that
     // onImageTextureDestroy is called under the m_imagesLock
     m_images.remove(imgCRC);
+    m_sourceGenerationIDs.remove(imgCRC);
+}
+
+void ImagesManager::evictUnusedImages(size_t budget)
+{
+    // NOTE: callers must hold m_imagesLock
+    while (m_unusedBytes > budget && !m_unusedImages.isEmpty()) {
+        unsigned crc = m_unusedImages.first();
+        m_unusedImages.remove(crc);
+        ImageTexture* image = m_images.get(crc);
+        m_unusedBytes -= imageBytes(image);
+        m_evictedCount++;
+        ALOGV("evicting image %x, unused images use %d bytes", crc, m_unusedBytes);
+
+        // the image will unregister itself by calling onImageTextureDestroy()
+        SkSafeUnref(image);
+    }
+}
+
+size_t ImagesManager::unusedBytes()
+{
+    android::Mutex::Autolock lock(m_imagesLock);
+    return m_unusedBytes;
+}
+
+void ImagesManager::showStats()
+{
+    android::Mutex::Autolock lock(m_imagesLock);
+    ALOGD("*** %d images (%d unused, using %d bytes of %d budget): %d hits, %d misses, %d evicted ***",
+          m_images.size(), m_unusedImages.size(), m_unusedBytes, m_budget,
+          m_hitCount, m_missCount, m_evictedCount);
 }
 
 int ImagesManager::nbTextures()
@@ -123,6 +265,8 @@ int ImagesManager::nbTextures()
     int i = 0;
     int nb = 0;
     for (HashMap<unsigned, ImageTexture*>::iterator it = m_images.begin(); it != end; ++it) {
+        if (m_unusedImages.contains(it->first))
+            continue;
         nb += it->second->nbTextures();
         i++;
     }
@@ -135,6 +279,8 @@ bool ImagesManager::prepareTextures(GLWebViewState* state)
     android::Mutex::Autolock lock(m_imagesLock);
     HashMap<unsigned, ImageTexture*>::iterator end = m_images.end();
     for (HashMap<unsigned, ImageTexture*>::iterator it = m_images.begin(); it != end; ++it) {
+        if (m_unusedImages.contains(it->first))
+            continue;
         ret |= it->second->prepareGL(state);
     }
     return ret;
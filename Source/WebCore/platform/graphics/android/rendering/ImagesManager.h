@@ -27,6 +27,7 @@
 #define ImagesManager_h
 
 #include "HashMap.h"
+#include "ListHashSet.h"
 #include "SkBitmap.h"
 #include "SkBitmapRef.h"
 #include "SkRefCnt.h"
@@ -39,6 +40,14 @@ namespace WebCore {
 class ImageTexture;
 class GLWebViewState;
 
+// Shares the ImageTextures between layers, keyed by the CRC of their bitmap
+// (or the next free key if another image has the same CRC). An image is only
+// shared once its content was compared with the new bitmap, or if the bitmap
+// has the same pixels (generation ID) as the one the image was made from.
+// The manager holds a reference on each ImageTexture; when that is the last
+// one left, the image is unused and is kept for reuse until the bytes held by
+// the unused images go over a budget, the least recently used images being
+// evicted first.
 class ImagesManager {
 public:
     static ImagesManager* instance();
@@ -53,13 +62,30 @@ public:
     bool prepareTextures(GLWebViewState*);
     int nbTextures();
 
+    size_t unusedBytes();
+    void showStats();
+
 private:
-    ImagesManager() {}
+    ImagesManager();
+
+    bool isSameSource(unsigned imgCRC, SkBitmap* bitmap);
+    void setImageUsed(unsigned imgCRC, ImageTexture* image);
+    void evictUnusedImages(size_t budget);
 
     static ImagesManager* gInstance;
 
     android::Mutex m_imagesLock;
     HashMap<unsigned, ImageTexture*> m_images;
+    // images only referenced by the manager, least recently used first
+    ListHashSet<unsigned> m_unusedImages;
+    // generation ID of the bitmap each image was last matched with
+    HashMap<unsigned, uint32_t> m_sourceGenerationIDs;
+    size_t m_unusedBytes;
+    size_t m_budget;
+
+    unsigned int m_hitCount;
+    unsigned int m_missCount;
+    unsigned int m_evictedCount;
 };
 
 } // namespace WebCore
@@ -46,6 +46,7 @@ PaintTileOperation::PaintTileOperation(Tile* tile, TilePainter* painter,
     , m_painter(painter)
     , m_state(state)
     , m_isLowResPrefetch(isLowResPrefetch)
+    , m_scheduledDrawCount(TilesManager::instance()->getDrawGLCount())
 {
     if (m_tile)
         m_tile->setRepaintPending(true);
@@ -86,6 +87,14 @@ void PaintTileOperation::run(BaseRenderer* renderer)
     if (m_tile) {
         m_tile->paintBitmap(m_painter, renderer);
         m_tile->setRepaintPending(false);
+
+        // visible, high res tiles are due for the frame after they were
+        // requested (expanded prefetch tiles have an older draw count)
+        TilesManager* tilesManager = TilesManager::instance();
+        if (!m_isLowResPrefetch && m_tile->drawCount() >= m_scheduledDrawCount
+            && tilesManager->getDrawGLCount() > m_scheduledDrawCount + 1)
+            tilesManager->getProfiler()->deadlineMissed();
+
         m_tile = 0;
     }
 }
@@ -26,6 +26,7 @@
 #ifndef PaintTileSetOperation_h
 #define PaintTileSetOperation_h
 
+#include "IntRect.h"
 #include "Tile.h"
 #include "QueuedOperation.h"
 #include "SkRefCnt.h"
@@ -50,12 +51,17 @@ public:
     TilePainter* painter() { return m_painter; }
     void updatePainter(TilePainter* painter);
     float scale() { return m_tile->scale(); }
+    Tile* tile() { return m_tile; }
 
 private:
     Tile* m_tile;
     TilePainter* m_painter;
     GLWebViewState* m_state;
     bool m_isLowResPrefetch;
+
+    // draw count when the operation was scheduled, a visible tile is expected
+    // to be ready for the following frame
+    unsigned long long m_scheduledDrawCount;
 };
 
 class ScaleFilter : public OperationFilter {
@@ -74,6 +80,27 @@ private:
 };
 
 
+// Matches tiles of the painter at the given scale that lie outside of
+// keepArea (in tile coordinates), i.e. that have scrolled far off-screen
+class DistantTileFilter : public OperationFilter {
+public:
+    DistantTileFilter(const TilePainter* painter, float scale, const IntRect& keepArea)
+        : m_painter(painter)
+        , m_scale(scale)
+        , m_keepArea(keepArea) {}
+    virtual bool check(QueuedOperation* operation)
+    {
+        PaintTileOperation* op = static_cast<PaintTileOperation*>(operation);
+        Tile* tile = op->tile();
+        return tile && op->painter() == m_painter && tile->scale() == m_scale
+            && !m_keepArea.contains(tile->x(), tile->y());
+    }
+private:
+    const TilePainter* m_painter;
+    float m_scale;
+    IntRect m_keepArea;
+};
+
 class TilePainterFilter : public OperationFilter {
 public:
     TilePainterFilter(TilePainter* painter) : m_painter(painter) {}
@@ -97,6 +97,12 @@ void RasterRenderer::setupCanvas(const TileRenderInfo& renderInfo, SkCanvas* can
 
 void RasterRenderer::renderingComplete(const TileRenderInfo& renderInfo, SkCanvas* canvas)
 {
+    // keep the painted content, so the tile doesn't have to be painted again
+    // if it loses its texture
+    if (canvas && !renderInfo.isPureColor
+        && !TilesManager::instance()->getShowVisualIndicator())
+        TilesManager::instance()->tileMemoryPool()->store(renderInfo, m_bitmap);
+
     // We may swap the content of m_bitmap with the bitmap in the transfer queue.
     GLUtils::paintTextureWithBitmap(&renderInfo, m_bitmap);
 }
@@ -113,6 +119,17 @@ void RasterRenderer::deviceCheckForPureColor(TileRenderInfo& renderInfo, SkCanva
     m_bitmapPureColor = renderInfo.pureColor;
 }
 
+bool RasterRenderer::restoreContent(TileRenderInfo& renderInfo)
+{
+    if (!TilesManager::instance()->tileMemoryPool()->restore(renderInfo, m_bitmap))
+        return false;
+
+    renderInfo.isPureColor = false;
+    m_bitmapIsPureColor = false;
+    renderingComplete(renderInfo, 0);
+    return true;
+}
+
 } // namespace WebCore
 
 #endif // USE(ACCELERATED_COMPOSITING)
@@ -49,6 +49,7 @@ protected:
     virtual void setupCanvas(const TileRenderInfo& renderInfo, SkCanvas* canvas);
     virtual void renderingComplete(const TileRenderInfo& renderInfo, SkCanvas* canvas);
     virtual void deviceCheckForPureColor(TileRenderInfo& renderInfo, SkCanvas* canvas);
+    virtual bool restoreContent(TileRenderInfo& renderInfo);
 
 private:
     SkBitmap m_bitmap;
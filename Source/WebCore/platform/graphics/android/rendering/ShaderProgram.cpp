@@ -711,6 +711,13 @@ IntRect ShaderProgram::clippedRectWithVisibleContentRect(const IntRect& rect, in
     return viewport;
 }
 
+FloatRect ShaderProgram::contentClip()
+{
+    if (m_invViewClip.isEmpty())
+        return m_contentViewport;
+    return convertInvViewCoordToContentCoord(m_invViewClip);
+}
+
 float ShaderProgram::zValue(const TransformationMatrix& drawMatrix, float w, float h)
 {
     TransformationMatrix modifiedDrawMatrix = drawMatrix;
@@ -148,6 +148,9 @@ public:
 
     void clip(const FloatRect& rect);
     IntRect clippedRectWithVisibleContentRect(const IntRect& rect, int margin = 0);
+    // area of the content redrawn by the current frame, the framework keeps
+    // the previous frame's pixels outside of it
+    FloatRect contentClip();
     FloatRect contentViewport() { return m_contentViewport; }
 
     float contrast() { return m_contrast; }
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "SoftwareRenderer"
+#define LOG_NDEBUG 1
+
+#include "config.h"
+#include "SoftwareRenderer.h"
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "AndroidLog.h"
+#include "ClassTracker.h"
+#include "SkCanvas.h"
+#include "SkDevice.h"
+#include "TilePainter.h"
+#include "TilesManager.h"
+
+namespace WebCore {
+
+SoftwareRenderer::SoftwareRenderer()
+  : BaseRenderer(BaseRenderer::Software)
+  , m_tilesScale(0)
+{
+    m_bitmap.setConfig(SkBitmap::kARGB_8888_Config,
+                       TilesManager::instance()->tileWidth(),
+                       TilesManager::instance()->tileHeight());
+    m_bitmap.allocPixels();
+#ifdef DEBUG_COUNT
+    ClassTracker::instance()->increment("SoftwareRenderer");
+#endif
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+    clearTiles();
+#ifdef DEBUG_COUNT
+    ClassTracker::instance()->decrement("SoftwareRenderer");
+#endif
+}
+
+bool SoftwareRenderer::paintTile(TileRenderInfo& renderInfo)
+{
+    if (renderInfo.scale != m_tilesScale) {
+        clearTiles();
+        m_tilesScale = renderInfo.scale;
+    }
+
+    TileKey key(renderInfo.tilePainter, renderInfo.x, renderInfo.y);
+    if (m_tiles.find(key) != m_tiles.end())
+        return false;
+
+    renderTiledContent(renderInfo);
+    SkBitmap* content = new SkBitmap();
+    m_bitmap.copyTo(content, m_bitmap.config());
+    content->setIsOpaque(m_bitmap.isOpaque());
+    m_tiles[key] = content;
+    return true;
+}
+
+const SkBitmap& SoftwareRenderer::tileContent(TileRenderInfo& renderInfo)
+{
+    paintTile(renderInfo);
+    return *m_tiles[TileKey(renderInfo.tilePainter, renderInfo.x, renderInfo.y)];
+}
+
+void SoftwareRenderer::clearTiles()
+{
+    for (TileMap::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+        delete it->second;
+    m_tiles.clear();
+}
+
+void SoftwareRenderer::setupCanvas(const TileRenderInfo& renderInfo, SkCanvas* canvas)
+{
+    TRACE_METHOD();
+
+    // There is no Tile behind the render info, only the base surface has a
+    // background, layer tiles start out transparent
+    Color* background = renderInfo.tilePainter->background();
+    if (background) {
+        m_bitmap.setIsOpaque(!background->hasAlpha());
+        m_bitmap.eraseARGB(background->alpha(), background->red(),
+                           background->green(), background->blue());
+    } else {
+        m_bitmap.setIsOpaque(false);
+        m_bitmap.eraseARGB(0, 0, 0, 0);
+    }
+
+    SkDevice* device = new SkDevice(m_bitmap);
+
+    canvas->setDevice(device);
+
+    device->unref();
+}
+
+void SoftwareRenderer::renderingComplete(const TileRenderInfo& renderInfo, SkCanvas* canvas)
+{
+    // the content of pure color tiles found in the recording wasn't painted
+    if (!canvas && renderInfo.isPureColor) {
+        const Color& color = renderInfo.pureColor;
+        m_bitmap.setIsOpaque(!color.hasAlpha());
+        m_bitmap.eraseARGB(color.alpha(), color.red(), color.green(), color.blue());
+    }
+}
+
+void SoftwareRenderer::deviceCheckForPureColor(TileRenderInfo& renderInfo, SkCanvas* canvas)
+{
+    // pure color tiles only save a texture upload, which doesn't happen here
+}
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
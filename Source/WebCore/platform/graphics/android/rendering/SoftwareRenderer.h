@@ -0,0 +1,89 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SoftwareRenderer_h
+#define SoftwareRenderer_h
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "BaseRenderer.h"
+#include "SkBitmap.h"
+
+#include <map>
+
+class SkCanvas;
+
+namespace WebCore {
+
+/**
+ * Renders the tiles into bitmaps kept in memory instead of uploading them
+ * into textures, so that layer trees can be composited without a GL context.
+ * Painted tiles are kept, like textures, until the scale changes, so that
+ * compositing a frame doesn't paint again the tiles it already has.
+ */
+class SoftwareRenderer : public BaseRenderer {
+public:
+    SoftwareRenderer();
+    ~SoftwareRenderer();
+
+    // Paints the tile unless its content is already kept, returns true if it
+    // had to be painted
+    bool paintTile(TileRenderInfo& renderInfo);
+    // Returns the content of the tile, painting it first if needed
+    const SkBitmap& tileContent(TileRenderInfo& renderInfo);
+    void clearTiles();
+
+protected:
+    virtual void setupCanvas(const TileRenderInfo& renderInfo, SkCanvas* canvas);
+    virtual void renderingComplete(const TileRenderInfo& renderInfo, SkCanvas* canvas);
+    virtual void deviceCheckForPureColor(TileRenderInfo& renderInfo, SkCanvas* canvas);
+
+private:
+    struct TileKey {
+        TileKey(const TilePainter* painter, int x, int y) : painter(painter), x(x), y(y) {}
+        bool operator<(const TileKey& other) const
+        {
+            if (painter != other.painter)
+                return painter < other.painter;
+            if (x != other.x)
+                return x < other.x;
+            return y < other.y;
+        }
+        const TilePainter* painter;
+        int x;
+        int y;
+    };
+    typedef std::map<TileKey, SkBitmap*> TileMap;
+
+    // the tile being painted
+    SkBitmap m_bitmap;
+    TileMap m_tiles;
+    float m_tilesScale;
+};
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
+#endif // SoftwareRenderer_h
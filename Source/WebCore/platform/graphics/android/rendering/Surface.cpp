@@ -37,8 +37,10 @@
 #include "GLWebViewState.h"
 #include "PrerenderedInval.h"
 #include "SkCanvas.h"
+#include "SoftwareRenderer.h"
 #include "SurfaceBacking.h"
 #include "Tile.h"
+#include "TileGrid.h"
 #include "TileTexture.h"
 #include "TilesManager.h"
 
@@ -239,8 +241,9 @@ bool Surface::drawGL(bool layerTilesDisabled)
     if (singleLayer() && !getFirstLayer()->visible())
         return false;
 
+    FloatRect drawClip;
     if (!isBase()) {
-        FloatRect drawClip = getFirstLayer()->drawClip();
+        drawClip = getFirstLayer()->drawClip();
         if (!singleLayer()) {
             for (unsigned int i = 1; i < m_layers.size(); i++)
                 drawClip.unite(m_layers[i]->drawClip());
@@ -249,8 +252,12 @@ bool Surface::drawGL(bool layerTilesDisabled)
         TilesManager::instance()->shader()->clip(clippingRect);
     }
 
+    // the framework keeps what is outside of the clip from the previous frame
+    bool clippedOut = !isBase()
+        && !drawClip.intersects(TilesManager::instance()->shader()->contentClip());
+
     bool askRedraw = false;
-    if (m_surfaceBacking && !tilesDisabled) {
+    if (m_surfaceBacking && !tilesDisabled && !clippedOut) {
         ALOGV("drawGL on Surf %p with SurfBack %p, first layer %s (%d)", this, m_surfaceBacking,
               getFirstLayer()->subclassName(), getFirstLayer()->uniqueId());
 
@@ -271,12 +278,105 @@ bool Surface::drawGL(bool layerTilesDisabled)
     return askRedraw;
 }
 
+void Surface::canvasRenderInfo(TileRenderInfo& renderInfo, int x, int y, float scale)
+{
+    // there is no Tile nor texture behind the tiles painted for a canvas
+    renderInfo.x = x;
+    renderInfo.y = y;
+    renderInfo.scale = scale;
+    renderInfo.tileSize = SkSize::Make(TilesManager::tileWidth(),
+                                       TilesManager::tileHeight());
+    renderInfo.tilePainter = this;
+    renderInfo.baseTile = 0;
+    renderInfo.textureInfo = 0;
+    renderInfo.contentVersion = 0;
+    renderInfo.recordedColorChecked = false;
+    renderInfo.isPureColor = false;
+}
+
+void Surface::paintCanvasTiles(float scale, SoftwareRenderer* renderer)
+{
+    if (!needsTexture() || (singleLayer() && !getFirstLayer()->visible()))
+        return;
+
+    bool force3dContentVisible = true;
+    IntRect tilesArea = TileGrid::computeTilesArea(visibleContentArea(force3dContentVisible), scale);
+    for (int y = tilesArea.y(); y < tilesArea.maxY(); y++) {
+        for (int x = tilesArea.x(); x < tilesArea.maxX(); x++) {
+            TileRenderInfo renderInfo;
+            canvasRenderInfo(renderInfo, x, y, scale);
+            renderer->paintTile(renderInfo);
+        }
+    }
+}
+
+void Surface::drawCanvas(SkCanvas* canvas, float scale, SoftwareRenderer* renderer)
+{
+    if (singleLayer() && !getFirstLayer()->visible())
+        return;
+
+    SkAutoCanvasRestore acr(canvas, true);
+    if (!isBase()) {
+        FloatRect drawClip = getFirstLayer()->drawClip();
+        if (!singleLayer()) {
+            for (unsigned int i = 1; i < m_layers.size(); i++)
+                drawClip.unite(m_layers[i]->drawClip());
+        }
+        canvas->clipRect(drawClip);
+    }
+
+    if (needsTexture()) {
+        ALOGV("drawCanvas on Surf %p, first layer %s (%d)", this,
+              getFirstLayer()->subclassName(), getFirstLayer()->uniqueId());
+
+        // same tiling as TileGrid::drawGL, the tiles come from the renderer
+        // instead of textures
+        bool force3dContentVisible = true;
+        IntRect drawArea = visibleContentArea(force3dContentVisible);
+        IntRect tilesArea = TileGrid::computeTilesArea(drawArea, scale);
+
+        SkAutoCanvasRestore tilesRestore(canvas, true);
+        const TransformationMatrix* transform = drawTransform();
+        if (transform) {
+            SkMatrix matrix;
+            GLUtils::toSkMatrix(matrix, *transform);
+            canvas->concat(matrix);
+        }
+        canvas->clipRect(drawArea);
+
+        const float tileWidth = TilesManager::tileWidth() / scale;
+        const float tileHeight = TilesManager::tileHeight() / scale;
+        SkPaint paint;
+        paint.setAlpha(SkScalarRound(opacity() * 255));
+        paint.setFilterBitmap(true);
+
+        for (int y = tilesArea.y(); y < tilesArea.maxY(); y++) {
+            for (int x = tilesArea.x(); x < tilesArea.maxX(); x++) {
+                TileRenderInfo renderInfo;
+                canvasRenderInfo(renderInfo, x, y, scale);
+                SkRect rect = SkRect::MakeXYWH(x * tileWidth, y * tileHeight,
+                                               tileWidth, tileHeight);
+                canvas->drawBitmapRect(renderer->tileContent(renderInfo), 0, rect, &paint);
+            }
+        }
+    }
+
+    // draw member layers images
+    for (unsigned int i = 0; i < m_layers.size(); i++)
+        m_layers[i]->drawImageCanvas(canvas);
+}
+
 void Surface::swapTiles(bool calculateFrameworkInvals)
 {
     if (!m_surfaceBacking)
         return;
 
-    if (m_surfaceBacking->swapTiles() && calculateFrameworkInvals)
+    if (!m_surfaceBacking->swapTiles())
+        return;
+
+    for (unsigned int i = 0; i < m_layers.size(); i++)
+        m_layers[i]->setContentDamaged();
+    if (calculateFrameworkInvals)
         addFrameworkInvals();
 }
 
@@ -304,6 +404,29 @@ bool Surface::isMissingContent()
     return m_surfaceBacking->isMissingContent();
 }
 
+bool Surface::isDamaged(const SkRegion& damage)
+{
+    for (unsigned int i = 0; i < m_layers.size(); i++) {
+        if (damage.intersects(enclosingIntRect(m_layers[i]->damageArea())))
+            return true;
+    }
+    return false;
+}
+
+bool Surface::isComplete()
+{
+    if (!m_surfaceBacking)
+        return !needsTexture();
+
+    return m_surfaceBacking->isComplete();
+}
+
+void Surface::markTilesAsUsed()
+{
+    if (m_surfaceBacking)
+        m_surfaceBacking->markTilesAsUsed();
+}
+
 bool Surface::canUpdateWithBlit()
 {
     // If we don't have a texture, we have nothing to update and thus can take
@@ -414,6 +537,38 @@ Color* Surface::background()
     return &m_background;
 }
 
+bool Surface::isSolidColor(const FloatRect& area, Color& color)
+{
+    if (!singleLayer() || !getFirstLayer())
+        return false;
+
+    // in single surface mode, the children are drawn on top of the content
+    if (isBase()
+        && getFirstLayer()->countChildren()
+        && getFirstLayer()->state()->isSingleSurfaceRenderingMode())
+        return false;
+
+    return getFirstLayer()->contentIsSolidColor(enclosingIntRect(area), color);
+}
+
+void Surface::findSolidColors(const Vector<FloatRect>& areas, Vector<Color>& colors)
+{
+    // same restrictions as isSolidColor()
+    if (!singleLayer() || !getFirstLayer()
+        || (isBase()
+            && getFirstLayer()->countChildren()
+            && getFirstLayer()->state()->isSingleSurfaceRenderingMode())) {
+        TilePainter::findSolidColors(areas, colors);
+        return;
+    }
+
+    Vector<IntRect> contentAreas;
+    contentAreas.reserveCapacity(areas.size());
+    for (size_t i = 0; i < areas.size(); i++)
+        contentAreas.append(enclosingIntRect(areas[i]));
+    getFirstLayer()->contentFindSolidColors(contentAreas, colors);
+}
+
 bool Surface::blitFromContents(Tile* tile)
 {
     if (!singleLayer() || !tile || !getFirstLayer() || !getFirstLayer()->content())
@@ -39,7 +39,9 @@ namespace WebCore {
 class Tile;
 class SurfaceBacking;
 class LayerAndroid;
+class SoftwareRenderer;
 class TexturesResult;
+struct TileRenderInfo;
 
 class Surface : public TilePainter {
 public:
@@ -51,12 +53,24 @@ public:
     void addLayer(LayerAndroid* layer, const TransformationMatrix& transform);
     void prepareGL(bool layerTilesDisabled, bool updateWithBlit);
     bool drawGL(bool layerTilesDisabled);
+    // paints the visible tiles the renderer doesn't have yet
+    void paintCanvasTiles(float scale, SoftwareRenderer* renderer);
+    // composites the visible tiles onto the canvas, in content coordinates,
+    // painting the ones the renderer doesn't have yet
+    void drawCanvas(SkCanvas* canvas, float scale, SoftwareRenderer* renderer);
     void swapTiles(bool calculateFrameworkInvals);
     void addFrameworkInvals();
     bool isReady();
     bool isMissingContent();
     bool canUpdateWithBlit();
 
+    // true if one of the layers intersects the damaged area
+    bool isDamaged(const SkRegion& damage);
+    // true if the surface tiles are up to date and don't need to be prepared
+    // again as long as the surface isn't damaged
+    bool isComplete();
+    void markTilesAsUsed();
+
     void computeTexturesAmount(TexturesResult* result);
 
     LayerAndroid* getFirstLayer() const { return m_layers[0]; }
@@ -72,6 +86,8 @@ public:
     virtual float opacity();
     virtual Color* background();
     virtual bool blitFromContents(Tile* tile);
+    virtual bool isSolidColor(const FloatRect& area, Color& color);
+    virtual void findSolidColors(const Vector<FloatRect>& areas, Vector<Color>& colors);
 
 private:
     IntRect computePrepareArea();
@@ -79,6 +95,7 @@ private:
     IntRect fullContentArea();
     bool singleLayer() const { return m_layers.size() == 1; }
     bool useAggressiveRendering();
+    void canvasRenderInfo(TileRenderInfo& renderInfo, int x, int y, float scale);
 
     const TransformationMatrix* drawTransform();
     IntRect m_fullContentArea;
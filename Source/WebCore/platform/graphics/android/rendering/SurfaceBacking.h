@@ -53,6 +53,10 @@ public:
                                const IntRect& visibleContentArea,
                                const IntRect& fullContentArea,
                                LayerAndroid* layer);
+    void markTilesAsUsed()
+    {
+        m_frontTileGrid->markTilesAsUsed();
+    }
     void discardTextures()
     {
         m_frontTileGrid->discardTextures();
@@ -73,6 +77,12 @@ public:
         return m_zooming || m_frontTileGrid->isMissingContent();
     }
 
+    // all the visible tiles have up to date content at the current scale
+    bool isComplete()
+    {
+        return isReady() && !isDirty() && !isMissingContent();
+    }
+
     int nbTextures(IntRect& area, float scale)
     {
         // TODO: consider the zooming case for the backTileGrid
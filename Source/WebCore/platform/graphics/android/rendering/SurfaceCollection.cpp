@@ -34,6 +34,7 @@
 #include "ClassTracker.h"
 #include "GLWebViewState.h"
 #include "PaintTileOperation.h"
+#include "SkCanvas.h"
 #include "Surface.h"
 #include "ScrollableLayerAndroid.h"
 #include "TilesManager.h"
@@ -46,7 +47,11 @@ namespace WebCore {
 
 SurfaceCollection::SurfaceCollection(BaseLayerAndroid* layer)
         : m_compositedRoot(layer)
+        , m_pendingFullDamage(true)
+        , m_fullFrameDamage(true)
 {
+    m_damageContentRect.setEmpty();
+
     // layer must be non-null.
     SkSafeRef(m_compositedRoot);
 
@@ -91,8 +96,21 @@ void SurfaceCollection::prepareGL(const SkRect& visibleContentRect, bool tryToFa
         for (unsigned int i = 0; tryToFastBlit && i < m_surfaces.size(); i++)
             tryToFastBlit &= m_surfaces[i]->canUpdateWithBlit();
     }
-    for (unsigned int i = 0; i < m_surfaces.size(); i++)
-        m_surfaces[i]->prepareGL(layerTilesDisabled, tryToFastBlit);
+
+    // surfaces that are up to date and didn't change since the last frame
+    // don't need to be prepared again
+    bool skipUndamaged = !layerTilesDisabled && !m_pendingFullDamage;
+    int skipped = 0;
+    for (unsigned int i = 0; i < m_surfaces.size(); i++) {
+        Surface* surface = m_surfaces[i];
+        if (skipUndamaged && surface->isComplete() && !surface->isDamaged(m_pendingDamage)) {
+            surface->markTilesAsUsed();
+            skipped++;
+            continue;
+        }
+        surface->prepareGL(layerTilesDisabled, tryToFastBlit);
+    }
+    ALOGV("prepared %d surfaces, %d undamaged skipped", m_surfaces.size() - skipped, skipped);
 }
 
 bool SurfaceCollection::drawGL(const SkRect& visibleContentRect)
@@ -105,9 +123,45 @@ bool SurfaceCollection::drawGL(const SkRect& visibleContentRect)
     updateLayerPositions(visibleContentRect);
     bool layerTilesDisabled = m_compositedRoot->state()->isSingleSurfaceRenderingMode();
 
+    m_frameDamage.swap(m_pendingDamage);
+    m_pendingDamage.setEmpty();
+    m_fullFrameDamage = m_pendingFullDamage;
+    m_pendingFullDamage = false;
+    addDamageToFrameworkInvals();
+
     return m_compositedRoot->drawTreeSurfacesGL();
 }
 
+void SurfaceCollection::prepareCanvas(const SkRect& visibleContentRect)
+{
+    TRACE_METHOD();
+    // the surfaces clip to the viewport set by the shader when drawing with GL
+    TilesManager::instance()->shader()->getContentViewport() = visibleContentRect;
+    updateLayerPositions(visibleContentRect);
+}
+
+void SurfaceCollection::paintCanvas(float scale, SoftwareRenderer* renderer)
+{
+    TRACE_METHOD();
+    for (unsigned int i = 0; i < m_surfaces.size(); i++)
+        m_surfaces[i]->paintCanvasTiles(scale, renderer);
+}
+
+void SurfaceCollection::drawCanvas(SkCanvas* canvas, const SkRect& visibleContentRect,
+                                   float scale, SoftwareRenderer* renderer)
+{
+    TRACE_METHOD();
+    Color background = getBackgroundColor();
+    canvas->drawARGB(background.alpha(), background.red(),
+                     background.green(), background.blue(), SkXfermode::kSrc_Mode);
+
+    SkAutoCanvasRestore acr(canvas, true);
+    canvas->scale(scale, scale);
+    canvas->translate(-visibleContentRect.fLeft, -visibleContentRect.fTop);
+    canvas->clipRect(visibleContentRect);
+    m_compositedRoot->drawTreeSurfacesCanvas(canvas, scale, renderer);
+}
+
 Color SurfaceCollection::getBackgroundColor()
 {
     return static_cast<BaseLayerAndroid*>(m_compositedRoot)->getBackgroundColor();
@@ -220,6 +274,14 @@ void SurfaceCollection::updateLayerPositions(const SkRect& visibleContentRect)
 {
     m_compositedRoot->updatePositionsRecursive(visibleContentRect);
 
+    // scrolling or zooming moves everything on screen
+    if (visibleContentRect != m_damageContentRect) {
+        m_pendingFullDamage = true;
+        m_damageContentRect = visibleContentRect;
+    }
+    if (m_compositedRoot->collectDamage(m_pendingDamage))
+        m_pendingFullDamage = true;
+
 #ifdef DEBUG
     m_compositedRoot->showLayer(0);
     ALOGV("We have %d layers, %d textured",
@@ -228,6 +290,25 @@ void SurfaceCollection::updateLayerPositions(const SkRect& visibleContentRect)
 #endif
 }
 
+void SurfaceCollection::addDamageToFrameworkInvals()
+{
+    GLWebViewState* state = m_compositedRoot->state();
+    if (m_fullFrameDamage) {
+        m_frameDamage.setRect(enclosingIntRect(m_damageContentRect));
+        state->doFrameworkFullInval();
+        return;
+    }
+
+    // only the damaged area needs to be drawn again by the framework
+    ShaderProgram* shader = TilesManager::instance()->shader();
+    SkRegion::Iterator iterator(m_frameDamage);
+    while (!iterator.done()) {
+        FloatRect area = shader->rectInViewCoord(FloatRect(IntRect(iterator.rect())));
+        state->addDirtyArea(enclosingIntRect(area));
+        iterator.next();
+    }
+}
+
 int SurfaceCollection::backedSize()
 {
     int count = 0;
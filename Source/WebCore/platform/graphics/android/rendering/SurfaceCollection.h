@@ -29,15 +29,16 @@
 #include "Color.h"
 #include "SkRect.h"
 #include "SkRefCnt.h"
+#include "SkRegion.h"
 
 #include <wtf/Vector.h>
 
 class SkCanvas;
-class SkRegion;
 
 namespace WebCore {
 
 class BaseLayerAndroid;
+class SoftwareRenderer;
 class Surface;
 class TexturesResult;
 
@@ -51,6 +52,16 @@ public:
     void prepareGL(const SkRect& visibleContentRect, bool tryToFastBlit = false);
     bool drawGL(const SkRect& visibleContentRect);
     Color getBackgroundColor();
+
+    // Software compositing, without a GL context. Positions the layers for
+    // the visible rect, then paints and composites their tiles onto the canvas.
+    void prepareCanvas(const SkRect& visibleContentRect);
+    // paints the visible tiles of every surface the renderer doesn't have yet,
+    // so that drawCanvas only composites
+    void paintCanvas(float scale, SoftwareRenderer* renderer);
+    void drawCanvas(SkCanvas* canvas, const SkRect& visibleContentRect, float scale,
+                    SoftwareRenderer* renderer);
+
     void swapTiles();
     void addFrameworkInvals();
     bool isReady();
@@ -71,10 +82,25 @@ public:
     int size() { return m_surfaces.size(); }
     int backedSize();
 
+    // Area of the content (in content coordinates) that changed in the last
+    // frame drawn with drawGL(). The whole visible content is damaged when the
+    // viewport changed, or when the change of a layer can't be tracked.
+    const SkRegion& frameDamage() const { return m_frameDamage; }
+    bool isFullFrameDamage() const { return m_fullFrameDamage; }
+
 private:
     void updateLayerPositions(const SkRect& visibleContentRect);
+    void addDamageToFrameworkInvals();
     BaseLayerAndroid* const m_compositedRoot;
     WTF::Vector<Surface*> m_surfaces;
+
+    // damage accumulated since the last drawGL()
+    SkRegion m_pendingDamage;
+    bool m_pendingFullDamage;
+    SkRect m_damageContentRect;
+
+    SkRegion m_frameDamage;
+    bool m_fullFrameDamage;
 };
 
 } // namespace WebCore
@@ -38,13 +38,19 @@
 #include "TilesManager.h"
 #include "TransferQueue.h"
 
+#include <algorithm>
+
 namespace WebCore {
 
 TexturesGenerator::TexturesGenerator(TilesManager* instance)
   : Thread(false)
   , m_tilesManager(instance)
   , m_deferredMode(false)
+  , m_stealRequested(false)
   , m_renderer(0)
+  , m_sequence(0)
+  , m_heapDirty(false)
+  , m_heapDrawCount(0)
 {
 }
 
@@ -66,19 +72,27 @@ bool TexturesGenerator::tryUpdateOperationWithPainter(Tile* tile, TilePainter* p
 void TexturesGenerator::scheduleOperation(QueuedOperation* operation)
 {
     bool signal = false;
+    bool backlog = false;
     {
         android::Mutex::Autolock lock(mRequestedOperationsLock);
-        mRequestedOperations.append(operation);
+        int priority = operation->priority();
+        mRequestedOperations.append(ScheduledOperation(operation, priority, m_sequence++));
+        std::push_heap(mRequestedOperations.begin(), mRequestedOperations.end(), isLessUrgent);
         mRequestedOperationsHash.set(operation->uniquePtr(), operation);
+        m_tilesManager->getProfiler()->operationQueued();
 
-        bool deferrable = operation->priority() >= gDeferPriorityCutoff;
+        bool deferrable = priority >= gDeferPriorityCutoff;
         m_deferredMode &= deferrable;
 
         // signal if we weren't in deferred mode, or if we can no longer defer
         signal = !m_deferredMode || !deferrable;
+        backlog = !deferrable && mRequestedOperations.size() > 1;
     }
     if (signal)
         mRequestedOperationsCond.signal();
+    // more work than we can start now, let the idle generators take some
+    if (backlog)
+        m_tilesManager->wakeIdleGenerators(this);
 }
 
 void TexturesGenerator::removeOperationsForFilter(OperationFilter* filter)
@@ -87,16 +101,66 @@ void TexturesGenerator::removeOperationsForFilter(OperationFilter* filter)
         return;
 
     android::Mutex::Autolock lock(mRequestedOperationsLock);
+    bool removed = false;
     for (unsigned int i = 0; i < mRequestedOperations.size();) {
-        QueuedOperation* operation = mRequestedOperations[i];
+        QueuedOperation* operation = mRequestedOperations[i].operation;
         if (filter->check(operation)) {
-            mRequestedOperations.remove(i);
+            // swap with the last entry, the heap is rebuilt below
+            mRequestedOperations[i] = mRequestedOperations.last();
+            mRequestedOperations.removeLast();
             mRequestedOperationsHash.remove(operation->uniquePtr());
+            m_tilesManager->getProfiler()->operationCancelled();
             delete operation;
+            removed = true;
         } else {
             i++;
         }
     }
+    if (removed)
+        std::make_heap(mRequestedOperations.begin(), mRequestedOperations.end(), isLessUrgent);
+}
+
+int TexturesGenerator::queueSize()
+{
+    android::Mutex::Autolock lock(mRequestedOperationsLock);
+    return mRequestedOperations.size();
+}
+
+void TexturesGenerator::reprioritize()
+{
+    android::Mutex::Autolock lock(mRequestedOperationsLock);
+    m_heapDirty = true;
+}
+
+QueuedOperation* TexturesGenerator::stealOperation(TexturesGenerator* thief)
+{
+    android::Mutex::Autolock lock(mRequestedOperationsLock);
+    if (!mRequestedOperations.size())
+        return 0;
+
+    rebuildHeapIfNeeded();
+
+    // deferred work stays with its owner, which decides when to paint it
+    if (mRequestedOperations.first().priority >= gDeferPriorityCutoff)
+        return 0;
+
+    // the tile is still being painted, the operation has to wait behind it
+    if (m_tilesManager->startOperation(thief, mRequestedOperations.first().operation))
+        return 0;
+
+    return popFront();
+}
+
+void TexturesGenerator::wakeToSteal()
+{
+    {
+        android::Mutex::Autolock lock(mRequestedOperationsLock);
+        // deferred generators wait on purpose, busy ones steal when done
+        if (m_deferredMode || mRequestedOperations.size())
+            return;
+        m_stealRequested = true;
+    }
+    mRequestedOperationsCond.signal();
 }
 
 status_t TexturesGenerator::readyToRun()
@@ -105,47 +169,46 @@ status_t TexturesGenerator::readyToRun()
     return NO_ERROR;
 }
 
+// Must be called from within a lock!
+void TexturesGenerator::rebuildHeapIfNeeded()
+{
+    // Priorities depend on the draw count and the viewport, so they are only
+    // recomputed once per frame, or when explicitly invalidated.
+    unsigned long long drawCount = m_tilesManager->getDrawGLCount();
+    if (!m_heapDirty && drawCount == m_heapDrawCount)
+        return;
+
+    for (unsigned int i = 0; i < mRequestedOperations.size(); i++)
+        mRequestedOperations[i].priority = mRequestedOperations[i].operation->priority();
+    std::make_heap(mRequestedOperations.begin(), mRequestedOperations.end(), isLessUrgent);
+
+    m_heapDirty = false;
+    m_heapDrawCount = drawCount;
+}
+
+// Must be called from within a lock!
+QueuedOperation* TexturesGenerator::popFront()
+{
+    QueuedOperation* operation = mRequestedOperations.first().operation;
+    std::pop_heap(mRequestedOperations.begin(), mRequestedOperations.end(), isLessUrgent);
+    mRequestedOperations.removeLast();
+    mRequestedOperationsHash.remove(operation->uniquePtr());
+    m_tilesManager->getProfiler()->operationDequeued();
+    return operation;
+}
+
 // Must be called from within a lock!
 QueuedOperation* TexturesGenerator::popNext()
 {
-    // Priority can change between when it was added and now
-    // Hence why the entire queue is rescanned
-    QueuedOperation* current = mRequestedOperations.last();
-    int currentPriority = current->priority();
-    if (currentPriority < 0) {
-        mRequestedOperations.removeLast();
-        mRequestedOperationsHash.remove(current->uniquePtr());
-        return current;
-    }
-    int currentIndex = mRequestedOperations.size() - 1;
-    // Scan from the back to make removing faster (less items to copy)
-    for (int i = mRequestedOperations.size() - 2; i >= 0; i--) {
-        QueuedOperation *next = mRequestedOperations[i];
-        int nextPriority = next->priority();
-        if (nextPriority < 0) {
-            // Found a very high priority item, go ahead and just handle it now
-            mRequestedOperations.remove(i);
-            mRequestedOperationsHash.remove(next->uniquePtr());
-            return next;
-        }
-        // pick items preferrably by priority, or if equal, by order of
-        // insertion (as we add items at the back of the queue)
-        if (nextPriority <= currentPriority) {
-            current = next;
-            currentPriority = nextPriority;
-            currentIndex = i;
-        }
-    }
+    rebuildHeapIfNeeded();
 
-    if (!m_deferredMode && currentPriority >= gDeferPriorityCutoff) {
+    if (!m_deferredMode && mRequestedOperations.first().priority >= gDeferPriorityCutoff) {
         // finished with non-deferred rendering, enter deferred mode to wait
         m_deferredMode = true;
         return 0;
     }
 
-    mRequestedOperations.remove(currentIndex);
-    mRequestedOperationsHash.remove(current->uniquePtr());
-    return current;
+    return popFront();
 }
 
 bool TexturesGenerator::threadLoop()
@@ -154,9 +217,11 @@ bool TexturesGenerator::threadLoop()
     mRequestedOperationsLock.lock();
 
     if (!m_deferredMode) {
-        // if we aren't currently deferring work, wait for new work to arrive
-        while (!mRequestedOperations.size())
+        // if we aren't currently deferring work, wait for new work to arrive,
+        // or for another generator to have work to steal
+        while (!mRequestedOperations.size() && !m_stealRequested)
             mRequestedOperationsCond.wait(mRequestedOperationsLock);
+        m_stealRequested = false;
     } else {
         // if we only have deferred work, wait for better work, or a timeout
         mRequestedOperationsCond.waitRelative(mRequestedOperationsLock, gDeferNsecs);
@@ -173,20 +238,36 @@ bool TexturesGenerator::threadLoop()
 
         if (mRequestedOperations.size())
             currentOperation = popNext();
+        bool deferred = m_deferredMode;
         mRequestedOperationsLock.unlock();
 
+        if (currentOperation) {
+            // a stolen operation for the same tile may still be painting on
+            // another generator, queue this one behind it there
+            TexturesGenerator* painter = m_tilesManager->startOperation(this, currentOperation);
+            if (painter) {
+                painter->scheduleOperation(currentOperation);
+                currentOperation = 0;
+            }
+        }
+
+        // our own queue is empty, help a busier generator instead of sleeping
+        if (!currentOperation && !deferred)
+            currentOperation = m_tilesManager->stealOperation(this);
+
         if (currentOperation) {
             ALOGV("threadLoop, painting the request with priority %d",
                   currentOperation->priority());
             // swap out the renderer if necessary
             BaseRenderer::swapRendererIfNeeded(m_renderer);
             currentOperation->run(m_renderer);
+            m_tilesManager->finishOperation(currentOperation);
         }
 
         mRequestedOperationsLock.lock();
         if (m_deferredMode && !currentOperation)
             stop = true;
-        if (!mRequestedOperations.size()) {
+        if (!mRequestedOperations.size() && !currentOperation) {
             m_deferredMode = false;
             stop = true;
         }
@@ -197,6 +278,9 @@ bool TexturesGenerator::threadLoop()
     }
     ALOGV("threadLoop empty");
 
+    // nothing left to paint, compress the content kept for the painted tiles
+    m_tilesManager->tileMemoryPool()->compressPending();
+
     return true;
 }
 
@@ -54,22 +54,66 @@ public:
 
     void scheduleOperation(QueuedOperation* operation);
 
+    // Number of operations waiting in this generator's queue
+    int queueSize();
+
+    // Removes and returns the best non-deferred operation from the queue, so
+    // that thief can paint it. The operation is already marked as started for
+    // thief. Returns 0 if there is nothing worth stealing, or if the best
+    // operation's tile is being painted by another generator.
+    QueuedOperation* stealOperation(TexturesGenerator* thief);
+
+    // Wakes the generator if it is waiting for work with an empty queue, so
+    // that it steals from the others
+    void wakeToSteal();
+
+    // Priorities of queued operations are cached in a heap; this marks them
+    // as stale (e.g. because the viewport moved) so that they are recomputed
+    // before the next operation is picked.
+    void reprioritize();
+
     // low res tiles are put at or above this cutoff when not scrolling,
     // signifying that they should be deferred
     static const int gDeferPriorityCutoff = 500000000;
 
 private:
+    // Queue entry, with the priority computed when the heap was last built.
+    // Ties are broken by age, so that older operations are painted first.
+    struct ScheduledOperation {
+        ScheduledOperation() : operation(0), priority(0), sequence(0) {}
+        ScheduledOperation(QueuedOperation* operation, int priority, unsigned sequence)
+            : operation(operation), priority(priority), sequence(sequence) {}
+        QueuedOperation* operation;
+        int priority;
+        unsigned sequence;
+    };
+
+    // heap comparator, the most urgent operation ends up at the front
+    static bool isLessUrgent(const ScheduledOperation& a, const ScheduledOperation& b)
+    {
+        if (a.priority != b.priority)
+            return a.priority > b.priority;
+        return a.sequence > b.sequence;
+    }
+
     QueuedOperation* popNext();
+    QueuedOperation* popFront();
+    void rebuildHeapIfNeeded();
     virtual bool threadLoop();
-    WTF::Vector<QueuedOperation*> mRequestedOperations;
+    WTF::Vector<ScheduledOperation> mRequestedOperations;
     WTF::HashMap<void*, QueuedOperation*> mRequestedOperationsHash;
     android::Mutex mRequestedOperationsLock;
     android::Condition mRequestedOperationsCond;
     TilesManager* m_tilesManager;
 
     bool m_deferredMode;
+    bool m_stealRequested;
     BaseRenderer* m_renderer;
 
+    unsigned m_sequence;
+    bool m_heapDirty;
+    unsigned long long m_heapDrawCount;
+
     // defer painting for one second if best in queue has priority
     // QueuedOperation::gDeferPriorityCutoff or higher
     static const nsecs_t gDeferNsecs = 1000000000;
@@ -58,6 +58,9 @@ Tile::Tile(bool isLayerTile)
     , m_fullRepaint(true)
     , m_isLayerTile(isLayerTile)
     , m_drawCount(0)
+    , m_contentVersion(0)
+    , m_recordedColorPainter(0)
+    , m_recordedColorVersion(0)
     , m_state(Unpainted)
 {
 #ifdef DEBUG_COUNT
@@ -71,6 +74,7 @@ Tile::~Tile()
         m_backTexture->release(this);
     if (m_frontTexture)
         m_frontTexture->release(this);
+    TilesManager::instance()->tileMemoryPool()->remove(this);
 
 #ifdef DEBUG_COUNT
     ClassTracker::instance()->decrement("Tile");
@@ -82,14 +86,18 @@ Tile::~Tile()
 void Tile::setContents(int x, int y, float scale, bool isExpandedPrefetchTile)
 {
     // TODO: investigate whether below check/discard is necessary
-    if ((m_x != x)
+    bool moved = (m_x != x)
         || (m_y != y)
-        || (m_scale != scale)) {
-        // neither texture is relevant
+        || (m_scale != scale);
+    if (moved) {
+        // neither texture is relevant, nor the saved content
         discardTextures();
+        TilesManager::instance()->tileMemoryPool()->remove(this);
     }
 
     android::AutoMutex lock(m_atomicSync);
+    if (moved)
+        m_contentVersion++;
     m_x = x;
     m_y = y;
     m_scale = scale;
@@ -98,6 +106,20 @@ void Tile::setContents(int x, int y, float scale, bool isExpandedPrefetchTile)
         m_drawCount--; // deprioritize expanded painting region
 }
 
+void Tile::markAsUsed()
+{
+    android::AutoMutex lock(m_atomicSync);
+    m_drawCount = TilesManager::instance()->getDrawGLCount();
+}
+
+void Tile::setRecordedColor(TilePainter* painter, const Color& color)
+{
+    android::AutoMutex lock(m_atomicSync);
+    m_recordedColorPainter = painter;
+    m_recordedColorVersion = m_contentVersion;
+    m_recordedColor = color;
+}
+
 void Tile::reserveTexture()
 {
     TileTexture* texture = TilesManager::instance()->getAvailableTexture(this);
@@ -183,6 +205,8 @@ void Tile::markAsDirtyInternal()
     // NOTE: callers must hold lock on m_atomicSync
 
     m_dirty = true;
+    m_contentVersion++;
+    TilesManager::instance()->tileMemoryPool()->remove(this);
     if (m_state == UpToDate) {
         // We only mark a tile as unpainted in 'markAsDirty' if its status is
         // UpToDate: marking dirty means we need to repaint, but don't stop the
@@ -304,6 +328,10 @@ void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer)
     float scale = m_scale;
     const int x = m_x;
     const int y = m_y;
+    const unsigned int contentVersion = m_contentVersion;
+    const bool recordedColorChecked = painter == m_recordedColorPainter
+        && contentVersion == m_recordedColorVersion;
+    const Color recordedColor = m_recordedColor;
 
     if (!dirty || !texture) {
         m_atomicSync.unlock();
@@ -332,6 +360,9 @@ void Tile::paintBitmap(TilePainter* painter, BaseRenderer* renderer)
     renderInfo.tilePainter = painter;
     renderInfo.baseTile = this;
     renderInfo.textureInfo = textureInfo;
+    renderInfo.contentVersion = contentVersion;
+    renderInfo.recordedColorChecked = recordedColorChecked;
+    renderInfo.recordedColor = recordedColor;
 
     const float tileWidth = renderInfo.tileSize.width();
     const float tileHeight = renderInfo.tileSize.height();
@@ -130,6 +130,11 @@ public:
 
     // only used for prioritization - the higher, the more relevant the tile is
     unsigned long long drawCount() { return m_drawCount; }
+    // keeps the tile as relevant as if it had been prepared this frame
+    void markAsUsed();
+    // single color of the tile found from the recording of painter while
+    // preparing, used by the next paint if the content didn't change since
+    void setRecordedColor(TilePainter* painter, const Color& color);
     void discardTextures();
     void discardBackTexture();
     bool swapTexturesIfNeeded();
@@ -176,6 +181,16 @@ private:
     // own are used for new tiles and rendering
     unsigned long long m_drawCount;
 
+    // bumped whenever the content of the tile changes (invalidation, or new
+    // position/scale), so that content saved in the TileMemoryPool for an
+    // older version is never restored
+    unsigned int m_contentVersion;
+
+    // set by setRecordedColor(), valid for m_recordedColorVersion only
+    TilePainter* m_recordedColorPainter;
+    unsigned int m_recordedColorVersion;
+    Color m_recordedColor;
+
     // Tracks the state of painting for the tile. High level overview:
     // 1) Unpainted - until paint starts (and if marked dirty, in most cases)
     // 2) PaintingStarted - until paint completes
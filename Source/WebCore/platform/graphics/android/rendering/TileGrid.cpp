@@ -42,6 +42,10 @@
 #define EXPANDED_BOUNDS_INFLATE 1
 #define EXPANDED_PREFETCH_BOUNDS_Y_INFLATE 1
 
+// queued paints for tiles further than this many tiles away from the
+// prepared area are cancelled
+#define CANCEL_DISTANCE_INFLATE 3
+
 namespace WebCore {
 
 TileGrid::TileGrid(bool isBaseSurface)
@@ -159,6 +163,15 @@ void TileGrid::prepareGL(GLWebViewState* state, float scale,
     TilesManager* tilesManager = TilesManager::instance();
     if (scale != m_scale)
         tilesManager->removeOperationsForFilter(new ScaleFilter(painter, m_scale));
+    else if (m_prevArea != m_area && (regionFlags & StandardRegion)) {
+        // the viewport moved: drop paints that scrolled far away, and let
+        // the generators recompute the priorities of the remaining ones
+        IntRect keepArea = m_area;
+        keepArea.inflate(CANCEL_DISTANCE_INFLATE);
+        tilesManager->removeOperationsForFilter(new DistantTileFilter(painter, scale, keepArea));
+        tilesManager->reprioritizeOperations();
+    }
+    m_prevArea = m_area;
 
     m_scale = scale;
 
@@ -179,16 +192,19 @@ void TileGrid::prepareGL(GLWebViewState* state, float scale,
         m_dirtyRegion.setEmpty();
     }
 
+    Vector<PaintTileOperation*> operations;
     if (regionFlags & StandardRegion) {
         for (int i = 0; i < m_area.width(); i++) {
             if (goingDown) {
                 for (int j = 0; j < m_area.height(); j++)
                     prepareTile(m_area.x() + i, m_area.y() + j,
-                                painter, state, isLowResPrefetch, false, updateWithBlit);
+                                painter, state, isLowResPrefetch, false, updateWithBlit,
+                                operations);
             } else {
                 for (int j = m_area.height() - 1; j >= 0; j--)
                     prepareTile(m_area.x() + i, m_area.y() + j,
-                                painter, state, isLowResPrefetch, false, updateWithBlit);
+                                painter, state, isLowResPrefetch, false, updateWithBlit,
+                                operations);
             }
         }
     }
@@ -210,7 +226,18 @@ void TileGrid::prepareGL(GLWebViewState* state, float scale,
         for (int i = expandedArea.x(); i < expandedArea.maxX(); i++)
             for (int j = expandedArea.y(); j < expandedArea.maxY(); j++)
                 if (!m_area.contains(i, j))
-                    prepareTile(i, j, painter, state, isLowResPrefetch, true, updateWithBlit);
+                    prepareTile(i, j, painter, state, isLowResPrefetch, true, updateWithBlit,
+                                operations);
+    }
+
+    schedulePaints(operations, painter);
+}
+
+void TileGrid::markTilesAsUsed()
+{
+    for (unsigned int i = 0; i < m_tiles.size(); i++) {
+        if (m_tiles[i]->isTileVisible(m_area))
+            m_tiles[i]->markAsUsed();
     }
 }
 
@@ -223,7 +250,8 @@ void TileGrid::markAsDirty(const SkRegion& invalRegion)
 
 void TileGrid::prepareTile(int x, int y, TilePainter* painter,
                            GLWebViewState* state, bool isLowResPrefetch,
-                           bool isExpandPrefetch, bool shouldTryUpdateWithBlit)
+                           bool isExpandPrefetch, bool shouldTryUpdateWithBlit,
+                           Vector<PaintTileOperation*>& operations)
 {
     Tile* tile = getTile(x, y);
     if (!tile) {
@@ -252,8 +280,36 @@ void TileGrid::prepareTile(int x, int y, TilePainter* painter,
         ALOGV("painting TG %p's tile %d %d for LG %p, scale %f", this, x, y, painter, m_scale);
         PaintTileOperation *operation = new PaintTileOperation(tile, painter,
                                                                state, isLowResPrefetch);
-        tilesManager->scheduleOperation(operation);
+        operations.append(operation);
+    }
+}
+
+void TileGrid::schedulePaints(const Vector<PaintTileOperation*>& operations, TilePainter* painter)
+{
+    TilesManager* tilesManager = TilesManager::instance();
+
+    // look for the single color tiles with one search of the recording for
+    // all the tiles to paint, instead of one search per tile when painting
+    if (operations.size() > 1 && !tilesManager->getShowVisualIndicator()) {
+        Vector<FloatRect> areas;
+        areas.reserveCapacity(operations.size());
+        for (unsigned int i = 0; i < operations.size(); i++) {
+            Tile* tile = operations[i]->tile();
+            FloatRect area(tile->x() * TilesManager::tileWidth(),
+                           tile->y() * TilesManager::tileHeight(),
+                           TilesManager::tileWidth(), TilesManager::tileHeight());
+            area.scale(1 / m_scale);
+            areas.append(area);
+        }
+
+        Vector<Color> colors;
+        painter->findSolidColors(areas, colors);
+        for (unsigned int i = 0; i < operations.size(); i++)
+            operations[i]->tile()->setRecordedColor(painter, colors[i]);
     }
+
+    for (unsigned int i = 0; i < operations.size(); i++)
+        tilesManager->scheduleOperation(operations[i]);
 }
 
 bool TileGrid::tryBlitFromContents(Tile* tile, TilePainter* painter)
@@ -327,6 +383,12 @@ void TileGrid::drawGL(const IntRect& visibleContentArea, float opacity,
     bool usePointSampling =
         TilesManager::instance()->shader()->usePointSampling(m_scale, transform);
 
+    // tiles outside of the area redrawn by this frame keep their previous
+    // pixels on screen, they don't need to be drawn
+    FloatRect contentClip = TilesManager::instance()->shader()->contentClip();
+    bool cullTiles = !transform || !transform->hasPerspective();
+    int culled = 0;
+
     float minTileX =  visibleContentArea.x() / tileWidth;
     float minTileY =  visibleContentArea.y() / tileWidth;
     float maxTileWidth = visibleContentArea.maxX() / tileWidth;
@@ -337,12 +399,28 @@ void TileGrid::drawGL(const IntRect& visibleContentArea, float opacity,
         Tile* tile = m_tiles[i];
 
         bool tileInView = tile->isTileVisible(m_area);
-        if (tileInView) {
-            SkRect rect;
-            rect.fLeft = tile->x() * tileWidth;
-            rect.fTop = tile->y() * tileHeight;
-            rect.fRight = rect.fLeft + tileWidth;
-            rect.fBottom = rect.fTop + tileHeight;
+        SkRect rect;
+        rect.fLeft = tile->x() * tileWidth;
+        rect.fTop = tile->y() * tileHeight;
+        rect.fRight = rect.fLeft + tileWidth;
+        rect.fBottom = rect.fTop + tileHeight;
+
+        bool tileClipped = false;
+        if (tileInView && cullTiles) {
+            FloatRect tileRect = rect;
+            if (transform)
+                tileRect = transform->mapRect(tileRect);
+            tileClipped = !tileRect.intersects(contentClip);
+            if (tileClipped) {
+                if (semiOpaqueBaseSurface) {
+                    missingRegion.op(SkIRect::MakeXYWH(tile->x(), tile->y(), 1, 1),
+                                     SkRegion::kDifference_Op);
+                }
+                culled++;
+            }
+        }
+
+        if (tileInView && !tileClipped) {
             ALOGV("tile %p (layer tile: %d) %d,%d at scale %.2f vs %.2f [ready: %d] dirty: %d",
                   tile, tile->isLayerTile(), tile->x(), tile->y(),
                   tile->scale(), m_scale, tile->isTileReady(), tile->isDirty());
@@ -383,8 +461,8 @@ void TileGrid::drawGL(const IntRect& visibleContentArea, float opacity,
     if (semiOpaqueBaseSurface)
         drawMissingRegion(missingRegion, opacity, background);
 
-    ALOGV("TG %p drew %d tiles, scale %f",
-          this, drawn, m_scale);
+    ALOGV("TG %p drew %d tiles, skipped %d outside of the clip, scale %f",
+          this, drawn, culled, m_scale);
 }
 
 void TileGrid::drawMissingRegion(const SkRegion& region, float opacity,
@@ -35,6 +35,7 @@ namespace WebCore {
 
 class Color;
 class GLWebViewState;
+class PaintTileOperation;
 class Tile;
 class TilePainter;
 class TransformationMatrix;
@@ -57,6 +58,8 @@ public:
                 const TransformationMatrix* transform, const Color* background = 0);
 
     void markAsDirty(const SkRegion& dirtyArea);
+    // keeps the visible tiles textures when the grid isn't prepared
+    void markTilesAsUsed();
 
     Tile* getTile(int x, int y);
 
@@ -73,13 +76,17 @@ public:
 private:
     void prepareTile(int x, int y, TilePainter* painter,
                      GLWebViewState* state, bool isLowResPrefetch,
-                     bool isExpandPrefetch, bool shouldTryUpdateWithBlit);
+                     bool isExpandPrefetch, bool shouldTryUpdateWithBlit,
+                     Vector<PaintTileOperation*>& operations);
+    void schedulePaints(const Vector<PaintTileOperation*>& operations, TilePainter* painter);
     void drawMissingRegion(const SkRegion& region, float opacity, const Color* tileBackground);
     bool tryBlitFromContents(Tile* tile, TilePainter* painter);
 
     WTF::Vector<Tile*> m_tiles;
 
     IntRect m_area;
+    // tile area of the last prepare, to detect viewport moves
+    IntRect m_prevArea;
 
     SkRegion m_dirtyRegion;
 
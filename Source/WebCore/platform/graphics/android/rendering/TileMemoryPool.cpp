@@ -0,0 +1,415 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "TileMemoryPool"
+#define LOG_NDEBUG 1
+
+#include "config.h"
+#include "TileMemoryPool.h"
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "AndroidLog.h"
+#include "BaseRenderer.h"
+#include "SkColorPriv.h"
+#include "Tile.h"
+
+#include <cutils/properties.h>
+
+// Default byte budget of the pool, can be overridden (in KB) with the
+// webkit.tiles.pool_kb system property, 0 disables the pool
+#define DEFAULT_POOL_BUDGET (4 * 1024 * 1024)
+
+// Content compressing to more than this fraction of the 8888 bitmap isn't
+// worth keeping, painting it again is cheaper than the memory it holds
+#define MAX_COMPRESSED_RATIO 0.5
+
+// Painted tiles waiting for compression hold their raw pixels, so only a few
+// are kept, the others are dropped until the generators catch up
+#define MAX_PENDING_ENTRIES 4
+
+// Runs shorter than this are stored as literals
+#define MIN_RUN_LENGTH 3
+#define RUN_FLAG 0x8000
+#define MAX_RUN_LENGTH 0x7FFF
+
+namespace WebCore {
+
+// The compressed data is a sequence of chunks starting with a 16 bit header.
+// If RUN_FLAG is set the next pixel is repeated, otherwise the next pixels
+// are copied. The low bits of the header give the number of pixels.
+template<typename Pixel>
+static bool compressPixels(const Pixel* pixels, int count, Vector<uint8_t>& out, size_t maxSize)
+{
+    int i = 0;
+    while (i < count) {
+        int run = 1;
+        while (i + run < count && run < MAX_RUN_LENGTH && pixels[i + run] == pixels[i])
+            run++;
+
+        uint16_t header;
+        int length;
+        if (run >= MIN_RUN_LENGTH) {
+            header = RUN_FLAG | run;
+            length = 1;
+        } else {
+            // extend the literal up to the start of the next run
+            run = 0;
+            while (i + run < count && run < MAX_RUN_LENGTH) {
+                if (i + run + MIN_RUN_LENGTH <= count
+                    && pixels[i + run] == pixels[i + run + 1]
+                    && pixels[i + run] == pixels[i + run + 2])
+                    break;
+                run++;
+            }
+            header = run;
+            length = run;
+        }
+
+        out.append(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+        out.append(reinterpret_cast<const uint8_t*>(pixels + i), length * sizeof(Pixel));
+        if (out.size() > maxSize)
+            return false;
+        i += run;
+    }
+    return true;
+}
+
+template<typename Pixel>
+static bool decompressPixels(const Vector<uint8_t>& in, Pixel* pixels, int count)
+{
+    const uint8_t* data = in.data();
+    const uint8_t* end = data + in.size();
+    int i = 0;
+    while (data + sizeof(uint16_t) <= end) {
+        uint16_t header;
+        memcpy(&header, data, sizeof(header));
+        data += sizeof(header);
+
+        int run = header & MAX_RUN_LENGTH;
+        int length = (header & RUN_FLAG) ? 1 : run;
+        if (i + run > count || data + length * sizeof(Pixel) > end)
+            return false;
+
+        if (header & RUN_FLAG) {
+            Pixel pixel;
+            memcpy(&pixel, data, sizeof(pixel));
+            for (int j = 0; j < run; j++)
+                pixels[i + j] = pixel;
+        } else
+            memcpy(pixels + i, data, run * sizeof(Pixel));
+        data += length * sizeof(Pixel);
+        i += run;
+    }
+    return i == count;
+}
+
+bool TileMemoryPool::compressEntry(Entry* entry, bool useRGB565, size_t budget)
+{
+    // the raw pixels are replaced by the compressed ones
+    int count = entry->width * entry->height;
+    size_t maxSize = std::min(static_cast<size_t>(entry->data.size() * MAX_COMPRESSED_RATIO), budget);
+    const uint32_t* pixels = reinterpret_cast<const uint32_t*>(entry->data.data());
+    Vector<uint8_t> data;
+    bool compressed;
+    entry->isRGB565 = useRGB565 && entry->isOpaque;
+    if (entry->isRGB565) {
+        Vector<uint16_t> pixels16(count);
+        for (int i = 0; i < count; i++)
+            pixels16[i] = SkPixel32ToPixel16(pixels[i]);
+        compressed = compressPixels(pixels16.data(), count, data, maxSize);
+    } else
+        compressed = compressPixels(pixels, count, data, maxSize);
+
+    if (!compressed)
+        return false;
+    data.shrinkToFit();
+    entry->data.swap(data);
+    return true;
+}
+
+TileMemoryPool::TileMemoryPool()
+    : m_compressingTile(0)
+    , m_compressingTileRemoved(false)
+    , m_usedBytes(0)
+    , m_budget(DEFAULT_POOL_BUDGET)
+    , m_useRGB565(false)
+    , m_storedCount(0)
+    , m_rejectedCount(0)
+    , m_restoredCount(0)
+    , m_evictedCount(0)
+{
+    char value[PROPERTY_VALUE_MAX];
+    if (property_get("webkit.tiles.pool_kb", value, 0) > 0)
+        m_budget = std::max(0, atoi(value)) * 1024;
+    if (property_get("webkit.tiles.pool_rgb565", value, 0) > 0)
+        m_useRGB565 = atoi(value) > 0;
+}
+
+TileMemoryPool::~TileMemoryPool()
+{
+    clear();
+}
+
+void TileMemoryPool::store(const TileRenderInfo& renderInfo, const SkBitmap& bitmap)
+{
+    if (!m_budget || bitmap.config() != SkBitmap::kARGB_8888_Config
+        || bitmap.rowBytes() != bitmap.width() * bitmap.bytesPerPixel())
+        return;
+
+    TRACE_METHOD();
+    Entry* entry = new Entry();
+    entry->x = renderInfo.x;
+    entry->y = renderInfo.y;
+    entry->scale = renderInfo.scale;
+    entry->contentVersion = renderInfo.contentVersion;
+    entry->drawCount = renderInfo.baseTile->drawCount();
+    entry->width = bitmap.width();
+    entry->height = bitmap.height();
+    entry->isOpaque = bitmap.isOpaque();
+    entry->isRGB565 = false;
+
+    // only copy the pixels here, compressing them would delay the upload
+    bitmap.lockPixels();
+    entry->data.append(static_cast<const uint8_t*>(bitmap.getPixels()), bitmap.getSize());
+    bitmap.unlockPixels();
+
+    android::Mutex::Autolock lock(m_lock);
+    removeEntry(renderInfo.baseTile);
+    if (m_pendingEntries.size() >= MAX_PENDING_ENTRIES) {
+        ALOGV("too many tiles waiting for compression, tile (%d, %d) not kept",
+              renderInfo.x, renderInfo.y);
+        delete entry;
+        m_rejectedCount++;
+        return;
+    }
+    m_pendingEntries.set(renderInfo.baseTile, entry);
+}
+
+bool TileMemoryPool::matches(const Entry* entry, const TileRenderInfo& renderInfo)
+{
+    return entry->contentVersion == renderInfo.contentVersion
+        && entry->x == renderInfo.x && entry->y == renderInfo.y
+        && entry->scale == renderInfo.scale;
+}
+
+bool TileMemoryPool::restore(const TileRenderInfo& renderInfo, SkBitmap& bitmap)
+{
+    if (bitmap.config() != SkBitmap::kARGB_8888_Config
+        || bitmap.rowBytes() != bitmap.width() * bitmap.bytesPerPixel())
+        return false;
+
+    const Tile* tile = renderInfo.baseTile;
+    Entry* entry;
+    bool pending;
+    {
+        android::Mutex::Autolock lock(m_lock);
+        entry = m_pendingEntries.get(tile);
+        pending = entry;
+        if (!entry)
+            entry = m_entries.get(tile);
+        if (!entry)
+            return false;
+
+        if (!matches(entry, renderInfo)) {
+            removeEntry(tile);
+            return false;
+        }
+        if (entry->width != bitmap.width() || entry->height != bitmap.height())
+            return false;
+
+        // take the entry out while decompressing it without the lock
+        if (pending)
+            m_pendingEntries.remove(tile);
+        else {
+            m_entries.remove(tile);
+            m_usedBytes -= entry->data.size();
+        }
+        m_restoringTiles.set(tile, false);
+    }
+
+    TRACE_METHOD();
+    int count = bitmap.width() * bitmap.height();
+    bool restored;
+    bitmap.lockPixels();
+    uint32_t* pixels = static_cast<uint32_t*>(bitmap.getPixels());
+    if (pending) {
+        restored = entry->data.size() == bitmap.getSize();
+        if (restored)
+            memcpy(pixels, entry->data.data(), entry->data.size());
+    } else if (entry->isRGB565) {
+        Vector<uint16_t> pixels16(count);
+        restored = decompressPixels(entry->data, pixels16.data(), count);
+        for (int i = 0; restored && i < count; i++)
+            pixels[i] = SkPixel16ToPixel32(pixels16[i]);
+    } else
+        restored = decompressPixels(entry->data, pixels, count);
+    bitmap.unlockPixels();
+
+    android::Mutex::Autolock lock(m_lock);
+    bool removed = m_restoringTiles.take(tile);
+    if (!restored) {
+        ALOGE("corrupted content for tile (%d, %d)", renderInfo.x, renderInfo.y);
+        delete entry;
+        return false;
+    }
+
+    bitmap.setIsOpaque(entry->isOpaque);
+    bitmap.notifyPixelsChanged();
+    m_restoredCount++;
+    ALOGV("restored tile (%d, %d) from %d bytes, %d restored / %d kept / %d rejected / %d evicted",
+          renderInfo.x, renderInfo.y, entry->data.size(),
+          m_restoredCount, m_storedCount, m_rejectedCount, m_evictedCount);
+
+    // put the entry back, unless the tile was removed or stored again
+    if (removed || m_pendingEntries.contains(tile) || m_entries.contains(tile)) {
+        delete entry;
+        return true;
+    }
+    entry->drawCount = tile->drawCount();
+    if (pending)
+        m_pendingEntries.set(tile, entry);
+    else {
+        m_entries.set(tile, entry);
+        m_usedBytes += entry->data.size();
+        evictUntil(m_budget, tile);
+    }
+    return true;
+}
+
+void TileMemoryPool::compressPending()
+{
+    while (true) {
+        const Tile* tile;
+        Entry* entry;
+        {
+            android::Mutex::Autolock lock(m_lock);
+            // one generator compresses at a time, the others go back to painting
+            if (m_compressingTile || m_pendingEntries.isEmpty())
+                return;
+            HashMap<const Tile*, Entry*>::iterator it = m_pendingEntries.begin();
+            tile = it->first;
+            entry = it->second;
+            m_pendingEntries.remove(it);
+            m_compressingTile = tile;
+            m_compressingTileRemoved = false;
+        }
+
+        TRACE_METHOD();
+        bool compressed = compressEntry(entry, m_useRGB565, m_budget);
+
+        android::Mutex::Autolock lock(m_lock);
+        m_compressingTile = 0;
+        if (!compressed || m_compressingTileRemoved) {
+            // removed tiles must not be kept, they may have been destroyed
+            if (!compressed) {
+                ALOGV("tile (%d, %d) content does not compress, not kept", entry->x, entry->y);
+                m_rejectedCount++;
+            }
+            delete entry;
+            continue;
+        }
+
+        m_entries.set(tile, entry);
+        m_usedBytes += entry->data.size();
+        m_storedCount++;
+        evictUntil(m_budget, tile);
+
+        ALOGV("kept tile (%d, %d) in %d bytes (%s), pool uses %d bytes for %d tiles",
+              entry->x, entry->y, entry->data.size(), entry->isRGB565 ? "565" : "8888",
+              m_usedBytes, m_entries.size());
+    }
+}
+
+void TileMemoryPool::remove(const Tile* tile)
+{
+    android::Mutex::Autolock lock(m_lock);
+    removeEntry(tile);
+}
+
+void TileMemoryPool::clear()
+{
+    android::Mutex::Autolock lock(m_lock);
+    deleteAllValues(m_pendingEntries);
+    m_pendingEntries.clear();
+    if (m_compressingTile)
+        m_compressingTileRemoved = true;
+    HashMap<const Tile*, bool>::iterator end = m_restoringTiles.end();
+    for (HashMap<const Tile*, bool>::iterator it = m_restoringTiles.begin(); it != end; ++it)
+        it->second = true;
+    evictUntil(0, 0);
+}
+
+size_t TileMemoryPool::usedBytes()
+{
+    android::Mutex::Autolock lock(m_lock);
+    return m_usedBytes;
+}
+
+void TileMemoryPool::removeEntry(const Tile* tile)
+{
+    // NOTE: callers must hold m_lock
+    if (tile == m_compressingTile)
+        m_compressingTileRemoved = true;
+    HashMap<const Tile*, bool>::iterator restoring = m_restoringTiles.find(tile);
+    if (restoring != m_restoringTiles.end())
+        restoring->second = true;
+    delete m_pendingEntries.take(tile);
+
+    Entry* entry = m_entries.take(tile);
+    if (!entry)
+        return;
+    m_usedBytes -= entry->data.size();
+    delete entry;
+}
+
+void TileMemoryPool::evictUntil(size_t budget, const Tile* spared)
+{
+    // NOTE: callers must hold m_lock
+    while (m_usedBytes > budget && !m_entries.isEmpty()) {
+        // the draw count is the one saved with the entry, the tile itself may
+        // already be gone
+        const Tile* victim = 0;
+        unsigned long long victimDrawCount = 0;
+        HashMap<const Tile*, Entry*>::iterator end = m_entries.end();
+        for (HashMap<const Tile*, Entry*>::iterator it = m_entries.begin(); it != end; ++it) {
+            if (it->first == spared)
+                continue;
+            unsigned long long drawCount = it->second->drawCount;
+            if (!victim || drawCount < victimDrawCount) {
+                victim = it->first;
+                victimDrawCount = drawCount;
+            }
+        }
+        if (!victim)
+            break;
+        removeEntry(victim);
+        m_evictedCount++;
+    }
+}
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TileMemoryPool_h
+#define TileMemoryPool_h
+
+#if USE(ACCELERATED_COMPOSITING)
+
+#include "SkBitmap.h"
+#include <utils/threads.h>
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Tile;
+struct TileRenderInfo;
+
+// Keeps a run-length compressed copy of the content painted for tiles, so
+// that a tile losing its texture (stolen by another tile, or discarded under
+// memory pressure) can get its content back without being painted again,
+// typically when scrolling back. It is only such a cache: the tile textures
+// and the bitmaps they are painted into stay 8888 and are not counted in the
+// pool budget. Opaque tiles can optionally be kept in RGB565 in the pool to
+// halve the footprint of their copy.
+//
+// The pool is bounded by a byte budget, the entries of the tiles that were
+// prepared the least recently (lowest draw count) are evicted first.
+//
+// Painting only copies the pixels aside, they are compressed later by
+// compressPending() once the texture generators run out of tiles to paint.
+// All the methods are thread safe.
+class TileMemoryPool {
+public:
+    TileMemoryPool();
+    ~TileMemoryPool();
+
+    // Called by the texture generators once a tile has been painted
+    void store(const TileRenderInfo& renderInfo, const SkBitmap& bitmap);
+    // Copies the content saved for the tile into bitmap, returns false if
+    // there is no content saved for this version of the tile
+    bool restore(const TileRenderInfo& renderInfo, SkBitmap& bitmap);
+    // Compresses the content stored since the last call, called by the
+    // texture generators when they are idle
+    void compressPending();
+
+    // Drops the content saved for the tile, if any. Tiles must call this
+    // before being destroyed, the pool never dereferences them.
+    void remove(const Tile* tile);
+    void clear();
+
+    size_t usedBytes();
+
+private:
+    struct Entry {
+        int x;
+        int y;
+        float scale;
+        unsigned int contentVersion;
+        unsigned long long drawCount;
+        int width;
+        int height;
+        bool isOpaque;
+        bool isRGB565;
+        // compressed pixels, or the raw 8888 pixels while the entry is pending
+        Vector<uint8_t> data;
+    };
+
+    static bool compressEntry(Entry* entry, bool useRGB565, size_t budget);
+    bool matches(const Entry* entry, const TileRenderInfo& renderInfo);
+    void removeEntry(const Tile* tile);
+    void evictUntil(size_t budget, const Tile* spared);
+
+    android::Mutex m_lock;
+    HashMap<const Tile*, Entry*> m_entries;
+    HashMap<const Tile*, Entry*> m_pendingEntries;
+    // the tile whose content compressPending() is working on, and whether
+    // it was removed in the meantime
+    const Tile* m_compressingTile;
+    bool m_compressingTileRemoved;
+    // the tiles whose content restore() is decompressing, and whether they
+    // were removed in the meantime
+    HashMap<const Tile*, bool> m_restoringTiles;
+    size_t m_usedBytes;
+    size_t m_budget;
+    bool m_useRGB565;
+
+    unsigned int m_storedCount;
+    unsigned int m_rejectedCount;
+    unsigned int m_restoredCount;
+    unsigned int m_evictedCount;
+};
+
+} // namespace WebCore
+
+#endif // USE(ACCELERATED_COMPOSITING)
+#endif // TileMemoryPool_h
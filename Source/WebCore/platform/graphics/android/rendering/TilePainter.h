@@ -26,14 +26,16 @@
 #ifndef TilePainter_h
 #define TilePainter_h
 
+#include "Color.h"
 #include "TransformationMatrix.h"
 #include "SkRefCnt.h"
+#include <wtf/Vector.h>
 
 class SkCanvas;
 
 namespace WebCore {
 
-class Color;
+class FloatRect;
 class Tile;
 
 class TilePainter : public SkRefCnt {
@@ -46,6 +48,16 @@ public:
     virtual SurfaceType type() { return Painted; }
     virtual Color* background() { return 0; }
     virtual bool blitFromContents(Tile* tile) { return false; }
+    // returns true if the painter is known to fill area (in content
+    // coordinates) with a single opaque color, without painting it
+    virtual bool isSolidColor(const FloatRect& area, Color& color) { return false; }
+    // same as isSolidColor() for several areas, colors[i] is left invalid
+    // when areas[i] isn't known to be a single color
+    virtual void findSolidColors(const Vector<FloatRect>& areas, Vector<Color>& colors)
+    {
+        colors.clear();
+        colors.resize(areas.size());
+    }
 
     unsigned int getUpdateCount() { return m_updateCount; }
     void setUpdateCount(unsigned int updateCount) { m_updateCount = updateCount; }
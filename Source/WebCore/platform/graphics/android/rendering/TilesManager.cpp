@@ -32,6 +32,7 @@
 #if USE(ACCELERATED_COMPOSITING)
 
 #include "AndroidLog.h"
+#include "BaseRenderer.h"
 #include "GLWebViewState.h"
 #include "SkCanvas.h"
 #include "SkDevice.h"
@@ -42,8 +43,10 @@
 
 #include <android/native_window.h>
 #include <cutils/atomic.h>
+#include <cutils/properties.h>
 #include <gui/GLConsumer.h>
 #include <gui/Surface.h>
+#include <unistd.h>
 #include <wtf/CurrentTime.h>
 
 // Important: We need at least twice as many textures as is needed to cover
@@ -65,9 +68,10 @@
 
 #define LAYER_TEXTURES_DESTROY_TIMEOUT 60 // If we do not need layers for 60 seconds, free the textures
 
-// Eventually this should be dynamically be determined, and smart scheduling
-// between the generators should be implemented
-#define NUM_TEXTURES_GENERATORS 1
+// Upper bound on the number of texture generator threads. By default one
+// generator is started per online CPU, which can be overridden with the
+// webkit.tiles.generators system property.
+#define MAX_TEXTURES_GENERATORS 4
 
 namespace WebCore {
 
@@ -85,8 +89,20 @@ int TilesManager::getMaxTextureAllocation()
     return m_maxTextureAllocation;
 }
 
+int TilesManager::texturesGeneratorsCount()
+{
+    char value[PROPERTY_VALUE_MAX];
+    int count = 0;
+    if (property_get("webkit.tiles.generators", value, 0) > 0)
+        count = atoi(value);
+    if (count <= 0)
+        count = sysconf(_SC_NPROCESSORS_ONLN);
+    return std::max(1, std::min(count, MAX_TEXTURES_GENERATORS));
+}
+
 TilesManager::TilesManager()
-    : m_layerTexturesRemain(true)
+    : m_scheduleThread(0)
+    , m_layerTexturesRemain(true)
     , m_highEndGfx(false)
     , m_currentTextureCount(0)
     , m_currentLayerTextureCount(0)
@@ -110,8 +126,9 @@ TilesManager::TilesManager()
     m_tilesTextures.reserveCapacity(MAX_TEXTURE_ALLOCATION / 2);
     m_availableTilesTextures.reserveCapacity(MAX_TEXTURE_ALLOCATION / 2);
 
-    m_textureGenerators = new sp<TexturesGenerator>[NUM_TEXTURES_GENERATORS];
-    for (int i = 0; i < NUM_TEXTURES_GENERATORS; i++) {
+    m_textureGeneratorsCount = texturesGeneratorsCount();
+    m_textureGenerators = new sp<TexturesGenerator>[m_textureGeneratorsCount];
+    for (int i = 0; i < m_textureGeneratorsCount; i++) {
         m_textureGenerators[i] = new TexturesGenerator(this);
         ALOGD("Starting TG #%d, %p", i, m_textureGenerators[i].get());
         m_textureGenerators[i]->run("TexturesGenerator");
@@ -179,6 +196,11 @@ void TilesManager::discardTextures(bool allTextures, bool glTextures)
     }
     discardTexturesVector(sparedDrawCount, m_textures, glTextures);
     discardTexturesVector(sparedDrawCount, m_tilesTextures, glTextures);
+
+    // the content kept for the tiles lets them come back without being
+    // painted again, only drop it when freeing all the memory we can
+    if (allTextures && glTextures)
+        m_tileMemoryPool.clear();
 }
 
 void TilesManager::markAllGLTexturesZero()
@@ -505,25 +527,97 @@ void TilesManager::updateTilesIfContextVerified()
 
 void TilesManager::removeOperationsForFilter(OperationFilter* filter)
 {
-    for (int i = 0; i < NUM_TEXTURES_GENERATORS; i++)
+    for (int i = 0; i < m_textureGeneratorsCount; i++)
         m_textureGenerators[i]->removeOperationsForFilter(filter);
     delete filter;
 }
 
 bool TilesManager::tryUpdateOperationWithPainter(Tile* tile, TilePainter* painter)
 {
-    for (int i = 0; i < NUM_TEXTURES_GENERATORS; i++) {
+    for (int i = 0; i < m_textureGeneratorsCount; i++) {
         if (m_textureGenerators[i]->tryUpdateOperationWithPainter(tile, painter))
             return true;
     }
     return false;
 }
 
+bool TilesManager::canPaintInParallel()
+{
+    // Ganesh paints through a single shared GL context, so only the raster
+    // renderer can use more than one generator at a time.
+    return m_textureGeneratorsCount > 1
+        && BaseRenderer::getCurrentRendererType() == BaseRenderer::Raster;
+}
+
 void TilesManager::scheduleOperation(QueuedOperation* operation)
 {
-    // TODO: painter awareness, store prefer awareness, store preferred thread into painter
-    m_scheduleThread = (m_scheduleThread + 1) % NUM_TEXTURES_GENERATORS;
-    m_textureGenerators[m_scheduleThread]->scheduleOperation(operation);
+    if (!canPaintInParallel()) {
+        m_textureGenerators[0]->scheduleOperation(operation);
+        return;
+    }
+
+    // hand the operation to the least loaded generator, starting after the
+    // last one used so that ties are spread round robin
+    int best = (m_scheduleThread + 1) % m_textureGeneratorsCount;
+    int bestSize = m_textureGenerators[best]->queueSize();
+    for (int i = 1; i < m_textureGeneratorsCount && bestSize; i++) {
+        int index = (best + i) % m_textureGeneratorsCount;
+        int size = m_textureGenerators[index]->queueSize();
+        if (size < bestSize) {
+            best = index;
+            bestSize = size;
+        }
+    }
+    m_scheduleThread = best;
+    m_textureGenerators[best]->scheduleOperation(operation);
+}
+
+void TilesManager::reprioritizeOperations()
+{
+    for (int i = 0; i < m_textureGeneratorsCount; i++)
+        m_textureGenerators[i]->reprioritize();
+}
+
+QueuedOperation* TilesManager::stealOperation(TexturesGenerator* thief)
+{
+    if (!canPaintInParallel())
+        return 0;
+
+    for (int i = 0; i < m_textureGeneratorsCount; i++) {
+        if (m_textureGenerators[i].get() == thief)
+            continue;
+        QueuedOperation* operation = m_textureGenerators[i]->stealOperation(thief);
+        if (operation)
+            return operation;
+    }
+    return 0;
+}
+
+void TilesManager::wakeIdleGenerators(TexturesGenerator* busy)
+{
+    if (!canPaintInParallel())
+        return;
+
+    for (int i = 0; i < m_textureGeneratorsCount; i++) {
+        if (m_textureGenerators[i].get() != busy)
+            m_textureGenerators[i]->wakeToSteal();
+    }
+}
+
+TexturesGenerator* TilesManager::startOperation(TexturesGenerator* painter, QueuedOperation* operation)
+{
+    android::Mutex::Autolock lock(m_paintingOperationsLock);
+    void* key = operation->uniquePtr();
+    if (m_paintingOperations.contains(key))
+        return m_paintingOperations.get(key);
+    m_paintingOperations.set(key, painter);
+    return 0;
+}
+
+void TilesManager::finishOperation(QueuedOperation* operation)
+{
+    android::Mutex::Autolock lock(m_paintingOperationsLock);
+    m_paintingOperations.remove(operation->uniquePtr());
 }
 
 int TilesManager::tileWidth()
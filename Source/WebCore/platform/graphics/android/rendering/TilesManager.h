@@ -31,6 +31,7 @@
 #include "LayerAndroid.h"
 #include "ShaderProgram.h"
 #include "TexturesGenerator.h"
+#include "TileMemoryPool.h"
 #include "TilesProfiler.h"
 #include "VideoLayerManager.h"
 #include <utils/threads.h>
@@ -103,6 +104,11 @@ public:
         return &m_profiler;
     }
 
+    TileMemoryPool* tileMemoryPool()
+    {
+        return &m_tileMemoryPool;
+    }
+
     bool invertedScreen()
     {
         return m_invertedScreen;
@@ -155,10 +161,23 @@ public:
     void removeOperationsForFilter(OperationFilter* filter);
     bool tryUpdateOperationWithPainter(Tile* tile, TilePainter* painter);
     void scheduleOperation(QueuedOperation* operation);
+    // the viewport moved, queued operations need to be reprioritized
+    void reprioritizeOperations();
+    // called by an idle generator to take work queued on another generator
+    QueuedOperation* stealOperation(TexturesGenerator* thief);
+    // called by a generator with a backlog, wakes the idle ones to steal it
+    void wakeIdleGenerators(TexturesGenerator* busy);
+    // Marks the operation's tile as being painted by painter. If another
+    // generator is already painting that tile, returns it instead and leaves
+    // the operation unmarked, so that the tile is never painted twice at once.
+    TexturesGenerator* startOperation(TexturesGenerator* painter, QueuedOperation* operation);
+    void finishOperation(QueuedOperation* operation);
 
 private:
     TilesManager();
     ~TilesManager();
+    static int texturesGeneratorsCount();
+    bool canPaintInParallel();
     int m_scheduleThread;
 
     void discardTexturesVector(unsigned long long sparedDrawCount,
@@ -192,6 +211,13 @@ private:
     unsigned int m_webkitContentUpdates; // nr of paints from webkit
 
     sp<TexturesGenerator>* m_textureGenerators;
+    int m_textureGeneratorsCount;
+
+    // tiles being painted, with the generator painting each of them. The lock
+    // is never held while taking another one, generators take it with their
+    // queue locked.
+    WTF::HashMap<void*, TexturesGenerator*> m_paintingOperations;
+    android::Mutex m_paintingOperationsLock;
 
     android::Mutex m_texturesLock;
 
@@ -203,6 +229,7 @@ private:
     VideoLayerManager m_videoLayerManager;
 
     TilesProfiler m_profiler;
+    TileMemoryPool m_tileMemoryPool;
     unsigned long long m_drawGLCount;
     double m_lastTimeLayersUsed;
     bool m_hasLayerTextures;
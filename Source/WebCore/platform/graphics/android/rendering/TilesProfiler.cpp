@@ -34,6 +34,7 @@
 #include "AndroidLog.h"
 #include "Tile.h"
 #include "TilesManager.h"
+#include <cutils/atomic.h>
 #include <wtf/CurrentTime.h>
 
 // Hard limit on amount of frames (and thus memory) profiling can take
@@ -43,6 +44,10 @@
 namespace WebCore {
 TilesProfiler::TilesProfiler()
     : m_enabled(false)
+    , m_queueDepth(0)
+    , m_maxQueueDepth(0)
+    , m_cancelledOperations(0)
+    , m_missedDeadlines(0)
 {
 }
 
@@ -51,6 +56,9 @@ void TilesProfiler::start()
     m_enabled = true;
     m_goodTiles = 0;
     m_badTiles = 0;
+    android_atomic_release_store(m_queueDepth, &m_maxQueueDepth);
+    android_atomic_release_store(0, &m_cancelledOperations);
+    android_atomic_release_store(0, &m_missedDeadlines);
     m_records.clear();
     m_time = currentTimeMS();
     ALOGV("initializing tileprofiling");
@@ -60,6 +68,8 @@ float TilesProfiler::stop()
 {
     m_enabled = false;
     ALOGV("completed tile profiling, observed %d frames", m_records.size());
+    ALOGV("paint queue: depth %d, max depth %d, %d cancelled, %d missed deadlines",
+          m_queueDepth, m_maxQueueDepth, m_cancelledOperations, m_missedDeadlines);
     return (1.0 * m_goodTiles) / (m_goodTiles + m_badTiles);
 }
 
@@ -90,7 +100,8 @@ void TilesProfiler::nextFrame(int left, int top, int right, int bottom, float sc
     //first record designates viewport
     m_records.last().append(TileProfileRecord(
                                 left, top, right, bottom,
-                                scale, true, (int)(timeDelta * 1000)));
+                                scale, true, (int)(timeDelta * 1000),
+                                queueDepth(), missedDeadlines()));
 }
 
 void TilesProfiler::nextTile(Tile* tile, float scale, bool inView)
@@ -128,6 +139,33 @@ void TilesProfiler::nextInval(const SkIRect& rect, float scale)
           rect.right(), rect.bottom(), scale);
 }
 
+void TilesProfiler::operationQueued()
+{
+    int32_t depth = android_atomic_inc(&m_queueDepth) + 1;
+    int32_t maxDepth = m_maxQueueDepth;
+    while (depth > maxDepth) {
+        if (!android_atomic_cmpxchg(maxDepth, depth, &m_maxQueueDepth))
+            break;
+        maxDepth = m_maxQueueDepth;
+    }
+}
+
+void TilesProfiler::operationDequeued()
+{
+    android_atomic_dec(&m_queueDepth);
+}
+
+void TilesProfiler::operationCancelled()
+{
+    android_atomic_dec(&m_queueDepth);
+    android_atomic_inc(&m_cancelledOperations);
+}
+
+void TilesProfiler::deadlineMissed()
+{
+    android_atomic_inc(&m_missedDeadlines);
+}
+
 } // namespace WebCore
 
 #endif // USE(ACCELERATED_COMPOSITING)
@@ -37,7 +37,8 @@ namespace WebCore {
 class Tile;
 
 struct TileProfileRecord {
-    TileProfileRecord(int left, int top, int right, int bottom, float scale, int isReady, int level) {
+    TileProfileRecord(int left, int top, int right, int bottom, float scale, int isReady, int level,
+                      int queueDepth = 0, int missedDeadlines = 0) {
         this->left = left;
         this->top = top;
         this->right = right;
@@ -45,11 +46,17 @@ struct TileProfileRecord {
         this->scale = scale;
         this->isReady = isReady;
         this->level = level;
+        this->queueDepth = queueDepth;
+        this->missedDeadlines = missedDeadlines;
     }
     int left, top, right, bottom;
     bool isReady;
     int level;
     float scale;
+    // only set in the viewport record of each frame: paints queued at the
+    // start of the frame, and deadlines missed since profiling started
+    int queueDepth;
+    int missedDeadlines;
 };
 
 class TilesProfiler {
@@ -76,8 +83,23 @@ public:
 
     bool enabled() { return m_enabled; }
 
+    // Paint scheduling counters, always collected (may be called from any
+    // texture generator thread)
+    void operationQueued();
+    void operationDequeued();
+    void operationCancelled();
+    void deadlineMissed();
+    int queueDepth() { return m_queueDepth; }
+    int maxQueueDepth() { return m_maxQueueDepth; }
+    int cancelledOperations() { return m_cancelledOperations; }
+    int missedDeadlines() { return m_missedDeadlines; }
+
 private:
     bool m_enabled;
+    int32_t m_queueDepth;
+    int32_t m_maxQueueDepth;
+    int32_t m_cancelledOperations;
+    int32_t m_missedDeadlines;
     unsigned int m_goodTiles;
     unsigned int m_badTiles;
     WTF::Vector<WTF::Vector<TileProfileRecord> > m_records;
@@ -30,6 +30,7 @@
 #include "ClassTracker.h"
 
 #include "AndroidLog.h"
+#include "ImagesManager.h"
 #include "LayerAndroid.h"
 #include "TilesManager.h"
 
@@ -49,24 +50,24 @@ ClassTracker* ClassTracker::instance()
 
 ClassTracker* ClassTracker::gInstance = 0;
 
-void ClassTracker::increment(String name)
+void ClassTracker::increment(String name, int count)
 {
    android::Mutex::Autolock lock(m_lock);
    int value = 0;
    if (m_classes.contains(name))
        value = m_classes.get(name);
 
-   m_classes.set(name, value + 1);
+   m_classes.set(name, value + count);
 }
 
-void ClassTracker::decrement(String name)
+void ClassTracker::decrement(String name, int count)
 {
    android::Mutex::Autolock lock(m_lock);
    int value = 0;
    if (m_classes.contains(name))
        value = m_classes.get(name);
 
-   m_classes.set(name, value - 1);
+   m_classes.set(name, value - count);
 }
 
 void ClassTracker::add(LayerAndroid* layer)
@@ -103,6 +104,7 @@ void ClassTracker::show()
          nbAllocatedLayerTextures, nbLayerTextures,
          nbAllocatedLayerTextures * textureSize,
          (nbAllocatedTextures + nbAllocatedLayerTextures) * textureSize);
+   ImagesManager::instance()->showStats();
 
 #ifdef DEBUG_LAYERS
    for (unsigned int i = 0; i < m_layers.size(); i++) {
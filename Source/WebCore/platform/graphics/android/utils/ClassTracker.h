@@ -41,8 +41,8 @@ class ClassTracker {
 public:
     static ClassTracker* instance();
     void show();
-    void increment(String name);
-    void decrement(String name);
+    void increment(String name, int count = 1);
+    void decrement(String name, int count = 1);
     void add(LayerAndroid*);
     void remove(LayerAndroid*);
 private:
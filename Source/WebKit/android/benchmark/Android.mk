@@ -0,0 +1,114 @@
+##
+## Copyright 2012, The Android Open Source Project
+##
+## Redistribution and use in source and binary forms, with or without
+## modification, are permitted provided that the following conditions
+## are met:
+##  * Redistributions of source code must retain the above copyright
+##    notice, this list of conditions and the following disclaimer.
+##  * Redistributions in binary form must reproduce the above copyright
+##    notice, this list of conditions and the following disclaimer in the
+##    documentation and/or other materials provided with the distribution.
+##
+## THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+## EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+## IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+## PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+## CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+## EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+## PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+## PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+## OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+## (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+## OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+##
+
+LOCAL_PATH:= $(call my-dir)
+
+# Frame times of the software compositor
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+	BenchmarkCommon.cpp \
+	CompositorBenchmark.cpp
+
+# Links against the static libwebcore, the shared library only exports the
+# JNI entry point
+LOCAL_CFLAGS := $(WEBKIT_CFLAGS)
+LOCAL_CPPFLAGS := $(WEBKIT_CPPFLAGS)
+LOCAL_C_INCLUDES := $(WEBKIT_C_INCLUDES)
+LOCAL_LDLIBS := $(WEBKIT_LDLIBS)
+LOCAL_SHARED_LIBRARIES := $(WEBKIT_SHARED_LIBRARIES)
+LOCAL_STATIC_LIBRARIES := libwebcore $(WEBKIT_STATIC_LIBRARIES) libangle
+LOCAL_ADDITIONAL_DEPENDENCIES := $(filter %.h, $(WEBKIT_GENERATED_SOURCES))
+
+LOCAL_MODULE := webkit_compositor_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_EXECUTABLE)
+
+# Tiles painted per second against the number of painting threads
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+	BenchmarkCommon.cpp \
+	TileReplayBenchmark.cpp
+
+# Links against the static libwebcore, the shared library only exports the
+# JNI entry point
+LOCAL_CFLAGS := $(WEBKIT_CFLAGS)
+LOCAL_CPPFLAGS := $(WEBKIT_CPPFLAGS)
+LOCAL_C_INCLUDES := $(WEBKIT_C_INCLUDES)
+LOCAL_LDLIBS := $(WEBKIT_LDLIBS)
+LOCAL_SHARED_LIBRARIES := $(WEBKIT_SHARED_LIBRARIES)
+LOCAL_STATIC_LIBRARIES := libwebcore $(WEBKIT_STATIC_LIBRARIES) libangle
+LOCAL_ADDITIONAL_DEPENDENCIES := $(filter %.h, $(WEBKIT_GENERATED_SOURCES))
+
+LOCAL_MODULE := webkit_tile_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_EXECUTABLE)
+
+# Record and paint times of a sequence of invals
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+	BenchmarkCommon.cpp \
+	InvalReplayBenchmark.cpp
+
+# Links against the static libwebcore, the shared library only exports the
+# JNI entry point
+LOCAL_CFLAGS := $(WEBKIT_CFLAGS)
+LOCAL_CPPFLAGS := $(WEBKIT_CPPFLAGS)
+LOCAL_C_INCLUDES := $(WEBKIT_C_INCLUDES)
+LOCAL_LDLIBS := $(WEBKIT_LDLIBS)
+LOCAL_SHARED_LIBRARIES := $(WEBKIT_SHARED_LIBRARIES)
+LOCAL_STATIC_LIBRARIES := libwebcore $(WEBKIT_STATIC_LIBRARIES) libangle
+LOCAL_ADDITIONAL_DEPENDENCIES := $(filter %.h, $(WEBKIT_GENERATED_SOURCES))
+
+LOCAL_MODULE := webkit_inval_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_EXECUTABLE)
+
+# Build and search times of the RTree of the recordings
+include $(CLEAR_VARS)
+
+LOCAL_SRC_FILES := \
+	BenchmarkCommon.cpp \
+	RTreeBenchmark.cpp
+
+# Links against the static libwebcore, the shared library only exports the
+# JNI entry point
+LOCAL_CFLAGS := $(WEBKIT_CFLAGS)
+LOCAL_CPPFLAGS := $(WEBKIT_CPPFLAGS)
+LOCAL_C_INCLUDES := $(WEBKIT_C_INCLUDES)
+LOCAL_LDLIBS := $(WEBKIT_LDLIBS)
+LOCAL_SHARED_LIBRARIES := $(WEBKIT_SHARED_LIBRARIES)
+LOCAL_STATIC_LIBRARIES := libwebcore $(WEBKIT_STATIC_LIBRARIES) libangle
+LOCAL_ADDITIONAL_DEPENDENCIES := $(filter %.h, $(WEBKIT_GENERATED_SOURCES))
+
+LOCAL_MODULE := webkit_rtree_benchmark
+LOCAL_MODULE_TAGS := optional
+
+include $(BUILD_EXECUTABLE)
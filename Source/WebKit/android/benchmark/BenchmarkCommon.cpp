@@ -0,0 +1,74 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BenchmarkCommon.h"
+
+#include "BaseLayerAndroid.h"
+#include "SkData.h"
+#include "SkStream.h"
+#include "ViewStateSerializer.h"
+
+#include <algorithm>
+#include <stdio.h>
+
+using namespace WebCore;
+
+BaseLayerAndroid* loadViewState(const char* path, int version)
+{
+    SkFILEStream file(path);
+    if (!file.isValid()) {
+        fprintf(stderr, "could not open %s\n", path);
+        return 0;
+    }
+
+    // the legacy picture content needs the whole stream in memory
+    SkDynamicMemoryWStream tempStream;
+    const int bufferSize = 256*1024; // 256KB
+    uint8_t buffer[bufferSize];
+    int bytesRead = 0;
+    do {
+        bytesRead = file.read(buffer, bufferSize);
+        tempStream.write(buffer, bytesRead);
+    } while (bytesRead != 0);
+
+    SkMemoryStream stream;
+    stream.setData(tempStream.copyToData())->unref();
+    return android::deserializeViewState(version, &stream);
+}
+
+void printStats(const char* name, const Vector<double>& times)
+{
+    if (times.isEmpty())
+        return;
+    Vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (size_t i = 0; i < sorted.size(); i++)
+        total += sorted[i];
+    printf("%-10s avg %8.2fms  min %8.2fms  median %8.2fms  max %8.2fms\n", name,
+           total / sorted.size(), sorted[0], sorted[sorted.size() / 2],
+           sorted[sorted.size() - 1]);
+}
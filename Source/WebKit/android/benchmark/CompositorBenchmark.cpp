@@ -0,0 +1,188 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "webkit_compositor_benchmark"
+
+#include "config.h"
+
+#include "BaseLayerAndroid.h"
+#include "BenchmarkCommon.h"
+#include "GLWebViewState.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkImageEncoder.h"
+#include "SoftwareRenderer.h"
+#include "SurfaceCollection.h"
+#include "TilesManager.h"
+
+#include <algorithm>
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+// Loads a view state written by the ViewStateSerializer and composites it
+// in software, reporting the time spent per frame positioning the layers
+// (prepare), painting the tiles that became visible (paint) and compositing
+// the visible tiles (composite). Painted tiles are kept like textures, so the
+// composite pass never paints. Each frame scrolls the viewport by the given
+// step, wrapping around at the bottom of the content.
+
+#define DEFAULT_VERSION 2
+#define DEFAULT_WIDTH 800
+#define DEFAULT_HEIGHT 1280
+#define DEFAULT_FRAMES 100
+
+using namespace WebCore;
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-v version] [-w width] [-h height] [-s scale]\n"
+            "       [-f frames] [-d scroll step] [-o output.png] viewstate\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    int version = DEFAULT_VERSION;
+    int width = DEFAULT_WIDTH;
+    int height = DEFAULT_HEIGHT;
+    int frames = DEFAULT_FRAMES;
+    float scale = 1;
+    float scrollStep = 0;
+    const char* output = 0;
+
+    while (true) {
+        int c = getopt(argc, argv, "v:w:h:s:f:d:o:");
+        if (c == -1)
+            break;
+        switch (c) {
+            case 'v':
+                version = atoi(optarg);
+                break;
+            case 'w':
+                width = atoi(optarg);
+                break;
+            case 'h':
+                height = atoi(optarg);
+                break;
+            case 's':
+                scale = atof(optarg);
+                break;
+            case 'f':
+                frames = atoi(optarg);
+                break;
+            case 'd':
+                scrollStep = atof(optarg);
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1 || width <= 0 || height <= 0 || scale <= 0 || frames <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    WTF::initializeThreading();
+    WTF::initializeMainThread();
+
+    BaseLayerAndroid* root = loadViewState(argv[optind], version);
+    if (!root) {
+        fprintf(stderr, "could not read the view state from %s\n", argv[optind]);
+        return 1;
+    }
+
+    // the layers read the scale used to position fixed elements from the state
+    GLWebViewState* state = new GLWebViewState();
+    state->setScale(scale);
+    root->setState(state);
+
+    SurfaceCollection* collection = new SurfaceCollection(root);
+    collection->setIsDrawing();
+
+    SkBitmap bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config, width, height);
+    bitmap.allocPixels();
+    SkCanvas canvas(bitmap);
+    SoftwareRenderer renderer;
+
+    // a view state without base content still has layers to composite
+    int contentWidth = root->content() ? root->content()->width() : 0;
+    int contentHeight = root->content() ? root->content()->height() : 0;
+
+    float viewportWidth = width / scale;
+    float viewportHeight = height / scale;
+    float maxScroll = std::max(0.0f, contentHeight - viewportHeight);
+
+    printf("%s: %dx%d content, %d layers, %d surfaces, %dx%d viewport at %.2fx\n",
+           argv[optind], contentWidth, contentHeight,
+           root->nbLayers(), collection->size(), width, height, scale);
+
+    Vector<double> prepareTimes;
+    Vector<double> paintTimes;
+    Vector<double> compositeTimes;
+    Vector<double> frameTimes;
+    for (int i = 0; i < frames; i++) {
+        float top = maxScroll ? fmodf(i * scrollStep, maxScroll) : 0;
+        SkRect visibleContentRect = SkRect::MakeXYWH(0, top, viewportWidth, viewportHeight);
+
+        double start = currentTimeMS();
+        collection->prepareCanvas(visibleContentRect);
+        double prepared = currentTimeMS();
+        collection->paintCanvas(scale, &renderer);
+        double painted = currentTimeMS();
+        collection->drawCanvas(&canvas, visibleContentRect, scale, &renderer);
+        double composited = currentTimeMS();
+
+        prepareTimes.append(prepared - start);
+        paintTimes.append(painted - prepared);
+        compositeTimes.append(composited - painted);
+        frameTimes.append(composited - start);
+        printf("frame %4d at %8.1f: prepare %8.2fms  paint %8.2fms  composite %8.2fms\n",
+               i, top, prepared - start, painted - prepared, composited - painted);
+    }
+
+    printStats("prepare", prepareTimes);
+    printStats("paint", paintTimes);
+    printStats("composite", compositeTimes);
+    printStats("frame", frameTimes);
+
+    if (output && !SkImageEncoder::EncodeFile(output, bitmap, SkImageEncoder::kPNG_Type, 100))
+        fprintf(stderr, "could not write %s\n", output);
+
+    SkSafeUnref(collection);
+    root->setState(0);
+    SkSafeUnref(root);
+    delete state;
+    return 0;
+}
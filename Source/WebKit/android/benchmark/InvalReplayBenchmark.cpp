@@ -0,0 +1,251 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "webkit_inval_benchmark"
+
+#include "config.h"
+
+#include "BenchmarkCommon.h"
+#include "Color.h"
+#include "FloatRect.h"
+#include "GraphicsContext.h"
+#include "IntRect.h"
+#include "PicturePile.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+
+#include <algorithm>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/Vector.h>
+
+// Replays a sequence of invals into a PicturePile, recording the invalidated
+// content and painting it back for each frame, and reports the time spent
+// recording and painting. This measures how the pile coalesces invals, and
+// how much content each coalescing choice makes us record and paint again.
+//
+// The sequence is read from a file, one "x y w h" inval per line, and a
+// "frame" line after the invals of each frame. An optional "size w h" first
+// line gives the page size. Without a file, a mix of a ticker, a blinking
+// caret, ads changing and an occasional relayout is generated.
+//
+// The content is synthetic: small rectangles filling the page, so recording
+// and painting an area costs about the same anywhere on the page.
+
+#define DEFAULT_WIDTH 980
+#define DEFAULT_HEIGHT 4000
+#define DEFAULT_FRAMES 300
+#define DEFAULT_RUNS 3
+#define CELL_SIZE 16
+
+using namespace WebCore;
+
+typedef Vector<IntRect> Frame;
+
+class CellPainter : public PicturePainter {
+public:
+    virtual void paintContents(GraphicsContext* gc, IntRect& dirty)
+    {
+        gc->fillRect(dirty, Color::white, ColorSpaceDeviceRGB);
+        int left = dirty.x() - dirty.x() % CELL_SIZE;
+        int top = dirty.y() - dirty.y() % CELL_SIZE;
+        for (int y = top; y < dirty.maxY(); y += CELL_SIZE) {
+            for (int x = left; x < dirty.maxX(); x += CELL_SIZE) {
+                Color color(x & 0xff, y & 0xff, (x ^ y) & 0xff);
+                gc->fillRect(FloatRect(x + 2, y + 2, CELL_SIZE - 4, CELL_SIZE - 4),
+                             color, ColorSpaceDeviceRGB);
+            }
+        }
+    }
+};
+
+static bool readTrace(const char* path, IntSize& size, Vector<Frame>& frames)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "could not open %s\n", path);
+        return false;
+    }
+
+    char line[256];
+    int lineNumber = 0;
+    Frame frame;
+    while (fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        int x, y, w, h;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+        if (!strncmp(line, "frame", 5)) {
+            frames.append(frame);
+            frame.clear();
+        } else if (sscanf(line, "size %d %d", &w, &h) == 2)
+            size = IntSize(w, h);
+        else if (sscanf(line, "%d %d %d %d", &x, &y, &w, &h) == 4)
+            frame.append(IntRect(x, y, w, h));
+        else {
+            fprintf(stderr, "%s:%d: could not parse '%s'\n", path, lineNumber, line);
+            fclose(file);
+            return false;
+        }
+    }
+    if (!frame.isEmpty())
+        frames.append(frame);
+    fclose(file);
+    return true;
+}
+
+static void generateTrace(const IntSize& size, int count, Vector<Frame>& frames)
+{
+    srand(1);
+    for (int i = 0; i < count; i++) {
+        Frame frame;
+        // a news ticker below the header
+        frame.append(IntRect(0, 120, size.width(), 24));
+        // a caret blinking in a text field
+        if (i % 2)
+            frame.append(IntRect(200 + i % 40, 300, 2, 18));
+        // an ad changing every second
+        if (!(i % 60))
+            frame.append(IntRect(size.width() - 320, 400 + rand() % 800, 300, 250));
+        // a few small scattered updates
+        for (int j = rand() % 4; j > 0; j--)
+            frame.append(IntRect(rand() % size.width(), rand() % size.height(), 40, 40));
+        // a relayout of the top of the page
+        if (!(i % 100))
+            frame.append(IntRect(0, 0, size.width(), std::min(size.height(), 1600)));
+        frames.append(frame);
+    }
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-w width] [-h height] [-n frames] [-r runs] [trace]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    IntSize size(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+    int frameCount = DEFAULT_FRAMES;
+    int runs = DEFAULT_RUNS;
+
+    while (true) {
+        int c = getopt(argc, argv, "w:h:n:r:");
+        if (c == -1)
+            break;
+        switch (c) {
+            case 'w':
+                size.setWidth(atoi(optarg));
+                break;
+            case 'h':
+                size.setHeight(atoi(optarg));
+                break;
+            case 'n':
+                frameCount = atoi(optarg);
+                break;
+            case 'r':
+                runs = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind < argc - 1 || frameCount <= 0 || runs <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    WTF::initializeThreading();
+    WTF::initializeMainThread();
+
+    Vector<Frame> frames;
+    const char* name = "generated";
+    if (optind == argc - 1) {
+        name = argv[optind];
+        if (!readTrace(name, size, frames))
+            return 1;
+    } else
+        generateTrace(size, frameCount, frames);
+    if (size.isEmpty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int invalCount = 0;
+    for (size_t i = 0; i < frames.size(); i++)
+        invalCount += frames[i].size();
+    printf("%s: %dx%d page, %d frames, %d invals\n", name, size.width(), size.height(),
+           static_cast<int>(frames.size()), invalCount);
+
+    SkBitmap bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config, size.width(), size.height());
+    bitmap.allocPixels();
+    bitmap.setIsOpaque(true);
+    CellPainter painter;
+
+    Vector<double> recordTimes;
+    Vector<double> paintTimes;
+    Vector<double> frameTimes;
+    for (int run = 0; run < runs; run++) {
+        // the whole page is recorded and painted once before the replay
+        PicturePile pile;
+        pile.setSize(size);
+        pile.updatePicturesIfNeeded(&painter);
+        SkCanvas pageCanvas(bitmap);
+        pile.draw(&pageCanvas);
+
+        double startTime = currentTimeMS();
+        for (size_t i = 0; i < frames.size(); i++) {
+            double frameStart = currentTimeMS();
+            for (size_t j = 0; j < frames[i].size(); j++)
+                pile.invalidate(frames[i][j]);
+            pile.updatePicturesIfNeeded(&painter);
+            double recordTime = currentTimeMS() - frameStart;
+
+            // paint back what was dirtied, like the tiles covering it would be
+            double paintStart = currentTimeMS();
+            SkCanvas canvas(bitmap);
+            canvas.clipRegion(pile.dirtyRegion());
+            pile.draw(&canvas);
+            double paintTime = currentTimeMS() - paintStart;
+
+            recordTimes.append(recordTime);
+            paintTimes.append(paintTime);
+            frameTimes.append(recordTime + paintTime);
+            printf("frame %4d at %8.1f: %2d invals  record %8.2fms  paint %8.2fms\n",
+                   static_cast<int>(i), frameStart - startTime,
+                   static_cast<int>(frames[i].size()), recordTime, paintTime);
+        }
+    }
+
+    printStats("record", recordTimes);
+    printStats("paint", paintTimes);
+    printStats("frame", frameTimes);
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "webkit_rtree_benchmark"
+
+#include "config.h"
+
+#include "BenchmarkCommon.h"
+#include "GraphicsOperation.h"
+#include "IntRect.h"
+#include "RTree.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <utils/LinearAllocator.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/Vector.h>
+
+// Times the RTree of the recordings, on the bounds of a synthetic page:
+//  - building the tree with one insert() per element, against queuing them
+//    with append() and packing them in finalize()
+//  - searching the tree once per tile of a tile grid, against the batched
+//    search of all the tiles at once used when preparing a TileGrid
+// Both trees are searched, and the searches must return the same number of
+// elements, so that a packing or batching bug shows up as a mismatch.
+
+#define DEFAULT_WIDTH 980
+#define DEFAULT_HEIGHT 4000
+#define DEFAULT_ELEMENTS 20000
+#define DEFAULT_RUNS 10
+#define TILE_SIZE 256
+// tiles of the prepared area, about two screens
+#define GRID_WIDTH 4
+#define GRID_HEIGHT 8
+
+using namespace WebCore;
+
+static void generateBounds(const IntSize& size, int count, Vector<IntRect>& bounds)
+{
+    srand(1);
+    for (int i = 0; i < count; i++) {
+        int x = rand() % size.width();
+        int y = rand() % size.height();
+        int w, h;
+        if (!(i % 100)) {
+            // a background or a large image
+            w = 100 + rand() % size.width();
+            h = 100 + rand() % 500;
+        } else {
+            // a text run or a border
+            w = 4 + rand() % 200;
+            h = 4 + rand() % 20;
+        }
+        bounds.append(IntRect(x, y, w, h));
+    }
+}
+
+static RecordingData* createPayload(android::LinearAllocator* heap, const IntRect& bounds, size_t order)
+{
+    // the tree destroys the payloads and their operations
+    return new (heap) RecordingData(new (heap) GraphicsOperation::ClipOut(bounds), order);
+}
+
+static void buildWithInserts(RTree::RTree& tree, android::LinearAllocator* heap,
+                             const Vector<IntRect>& bounds)
+{
+    for (size_t i = 0; i < bounds.size(); i++) {
+        IntRect rect = bounds[i];
+        tree.insert(rect, createPayload(heap, rect, i));
+    }
+}
+
+static void buildWithAppends(RTree::RTree& tree, android::LinearAllocator* heap,
+                             const Vector<IntRect>& bounds)
+{
+    for (size_t i = 0; i < bounds.size(); i++) {
+        IntRect rect = bounds[i];
+        tree.append(rect, createPayload(heap, rect, i));
+    }
+    tree.finalize();
+}
+
+static size_t searchPerTile(RTree::RTree& tree, const Vector<IntRect>& tiles)
+{
+    size_t found = 0;
+    Vector<RecordingData*> list;
+    for (size_t i = 0; i < tiles.size(); i++) {
+        list.clear();
+        tree.search(tiles[i], list);
+        found += list.size();
+    }
+    return found;
+}
+
+static size_t searchBatched(RTree::RTree& tree, const Vector<IntRect>& tiles)
+{
+    Vector<Vector<RecordingData*> > lists;
+    tree.search(tiles, lists);
+    size_t found = 0;
+    for (size_t i = 0; i < lists.size(); i++)
+        found += lists[i].size();
+    return found;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-w width] [-h height] [-n elements] [-r runs]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    IntSize size(DEFAULT_WIDTH, DEFAULT_HEIGHT);
+    int count = DEFAULT_ELEMENTS;
+    int runs = DEFAULT_RUNS;
+
+    while (true) {
+        int c = getopt(argc, argv, "w:h:n:r:");
+        if (c == -1)
+            break;
+        switch (c) {
+            case 'w':
+                size.setWidth(atoi(optarg));
+                break;
+            case 'h':
+                size.setHeight(atoi(optarg));
+                break;
+            case 'n':
+                count = atoi(optarg);
+                break;
+            case 'r':
+                runs = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc || size.isEmpty() || count <= 0 || runs <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Vector<IntRect> bounds;
+    generateBounds(size, count, bounds);
+
+    // tile grids scrolled down the page, one per run
+    Vector<Vector<IntRect> > grids;
+    for (int run = 0; run < runs; run++) {
+        Vector<IntRect> tiles;
+        int top = (size.height() * run / runs) / TILE_SIZE * TILE_SIZE;
+        for (int x = 0; x < GRID_WIDTH; x++) {
+            for (int y = 0; y < GRID_HEIGHT; y++)
+                tiles.append(IntRect(x * TILE_SIZE, top + y * TILE_SIZE, TILE_SIZE, TILE_SIZE));
+        }
+        grids.append(tiles);
+    }
+
+    printf("%dx%d page, %d elements, %d tiles per search\n", size.width(), size.height(),
+           count, GRID_WIDTH * GRID_HEIGHT);
+
+    Vector<double> insertTimes;
+    Vector<double> appendTimes;
+    Vector<double> insertTreeSearchTimes;
+    Vector<double> perTileTimes;
+    Vector<double> batchedTimes;
+    for (int run = 0; run < runs; run++) {
+        android::LinearAllocator insertHeap;
+        RTree::RTree insertTree(&insertHeap);
+        double startTime = currentTimeMS();
+        buildWithInserts(insertTree, &insertHeap, bounds);
+        insertTimes.append(currentTimeMS() - startTime);
+
+        android::LinearAllocator appendHeap;
+        RTree::RTree appendTree(&appendHeap);
+        startTime = currentTimeMS();
+        buildWithAppends(appendTree, &appendHeap, bounds);
+        appendTimes.append(currentTimeMS() - startTime);
+
+        const Vector<IntRect>& tiles = grids[run];
+        startTime = currentTimeMS();
+        size_t insertTreeFound = searchPerTile(insertTree, tiles);
+        insertTreeSearchTimes.append(currentTimeMS() - startTime);
+
+        startTime = currentTimeMS();
+        size_t perTileFound = searchPerTile(appendTree, tiles);
+        perTileTimes.append(currentTimeMS() - startTime);
+
+        startTime = currentTimeMS();
+        size_t batchedFound = searchBatched(appendTree, tiles);
+        batchedTimes.append(currentTimeMS() - startTime);
+
+        if (insertTreeFound != perTileFound || perTileFound != batchedFound) {
+            fprintf(stderr, "run %d: searches disagree, %d found in the inserted tree, "
+                    "%d per tile and %d batched in the packed tree\n", run,
+                    static_cast<int>(insertTreeFound), static_cast<int>(perTileFound),
+                    static_cast<int>(batchedFound));
+            return 1;
+        }
+    }
+
+    printStats("insert", insertTimes);
+    printStats("append+finalize", appendTimes);
+    printStats("search inserted", insertTreeSearchTimes);
+    printStats("search per tile", perTileTimes);
+    printStats("search batched", batchedTimes);
+    return 0;
+}
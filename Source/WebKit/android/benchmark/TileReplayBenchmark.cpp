@@ -0,0 +1,196 @@
+/*
+ * Copyright 2012, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "webkit_tile_benchmark"
+
+#include "config.h"
+
+#include "BaseLayerAndroid.h"
+#include "BenchmarkCommon.h"
+#include "LayerContent.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "TilesManager.h"
+
+#include <algorithm>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+// Loads a view state written by the ViewStateSerializer and paints the whole
+// base content into tiles with 1 to N worker threads, reporting the tiles
+// painted per second for each worker count. The workers take the next tile
+// to paint from a shared counter, like the texture generators taking work
+// from each other, but paint into memory instead of uploading textures, so
+// the benchmark runs without a GL context.
+//
+// LayerContent::draw serializes the paints of a given content, so these
+// numbers are the scaling the generator pool gets within a single layer.
+
+#define DEFAULT_VERSION 2
+#define DEFAULT_WORKERS 4
+#define DEFAULT_RUNS 5
+
+using namespace WebCore;
+
+struct TileReplay {
+    LayerContent* content;
+    float scale;
+    int columns;
+    int tileCount;
+    int volatile nextTile;
+};
+
+static void paintTile(LayerContent* content, float scale, int x, int y, SkBitmap& bitmap)
+{
+    bitmap.eraseARGB(255, 255, 255, 255);
+    SkCanvas canvas(bitmap);
+    canvas.translate(-x * bitmap.width(), -y * bitmap.height());
+    canvas.scale(scale, scale);
+    content->draw(&canvas);
+}
+
+static void* paintTiles(void* data)
+{
+    TileReplay* replay = static_cast<TileReplay*>(data);
+    SkBitmap bitmap;
+    bitmap.setConfig(SkBitmap::kARGB_8888_Config,
+                     TilesManager::tileWidth(), TilesManager::tileHeight());
+    bitmap.allocPixels();
+    bitmap.setIsOpaque(true);
+
+    while (true) {
+        int tile = atomicIncrement(&replay->nextTile) - 1;
+        if (tile >= replay->tileCount)
+            break;
+        paintTile(replay->content, replay->scale, tile % replay->columns,
+                  tile / replay->columns, bitmap);
+    }
+    return 0;
+}
+
+// Returns the time taken to paint every tile with the given number of workers
+static double replay(TileReplay& replay, int workers)
+{
+    replay.nextTile = 0;
+    Vector<ThreadIdentifier> threads;
+    double start = currentTimeMS();
+    for (int i = 0; i < workers; i++)
+        threads.append(createThread(paintTiles, &replay, "TileReplay"));
+    for (size_t i = 0; i < threads.size(); i++)
+        waitForThreadCompletion(threads[i], 0);
+    return currentTimeMS() - start;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-v version] [-s scale] [-t max workers] [-r runs] viewstate\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    int version = DEFAULT_VERSION;
+    int maxWorkers = DEFAULT_WORKERS;
+    int runs = DEFAULT_RUNS;
+    float scale = 1;
+
+    while (true) {
+        int c = getopt(argc, argv, "v:s:t:r:");
+        if (c == -1)
+            break;
+        switch (c) {
+            case 'v':
+                version = atoi(optarg);
+                break;
+            case 's':
+                scale = atof(optarg);
+                break;
+            case 't':
+                maxWorkers = atoi(optarg);
+                break;
+            case 'r':
+                runs = atoi(optarg);
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind != argc - 1 || scale <= 0 || maxWorkers <= 0 || runs <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    WTF::initializeThreading();
+    WTF::initializeMainThread();
+
+    BaseLayerAndroid* root = loadViewState(argv[optind], version);
+    if (!root) {
+        fprintf(stderr, "could not read the view state from %s\n", argv[optind]);
+        return 1;
+    }
+    if (!root->content() || root->content()->isEmpty()) {
+        fprintf(stderr, "%s has no base content to paint\n", argv[optind]);
+        SkSafeUnref(root);
+        return 1;
+    }
+
+    TileReplay tiles;
+    tiles.content = root->content();
+    tiles.scale = scale;
+    int tileWidth = TilesManager::tileWidth();
+    int tileHeight = TilesManager::tileHeight();
+    tiles.columns = (tiles.content->width() * scale + tileWidth - 1) / tileWidth;
+    int rows = (tiles.content->height() * scale + tileHeight - 1) / tileHeight;
+    tiles.tileCount = tiles.columns * rows;
+
+    printf("%s: %dx%d content at %.2fx, %d tiles of %dx%d\n", argv[optind],
+           tiles.content->width(), tiles.content->height(), scale,
+           tiles.tileCount, tileWidth, tileHeight);
+
+    // the first pass only warms up the caches, the decoded images and fonts
+    replay(tiles, 1);
+
+    double singleWorkerTime = 0;
+    for (int workers = 1; workers <= maxWorkers; workers++) {
+        Vector<double> times;
+        for (int i = 0; i < runs; i++)
+            times.append(replay(tiles, workers));
+        std::sort(times.begin(), times.end());
+        double median = times[times.size() / 2];
+        if (workers == 1)
+            singleWorkerTime = median;
+        printf("%d workers: median %8.2fms, %8.1f tiles/s, %5.2fx\n", workers, median,
+               tiles.tileCount * 1000 / median, singleWorkerTime / median);
+    }
+
+    SkSafeUnref(root);
+    return 0;
+}
@@ -0,0 +1,244 @@
+#!/usr/bin/env python
+#
+# Copyright 2012, The Android Open Source Project
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#  * Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#  * Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+# PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+# CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+# EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+# PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+# OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""Runs webkit_compositor_benchmark, or the tile and inval benchmarks, from the host.
+
+libwebcore and the Skia and EGL libraries it links against are only built
+for the target, so the benchmark itself runs on a device or an emulator.
+This script pushes the benchmark and the view states over adb, runs them one
+after the other and prints the summary of each run, so that a set of view
+states can be measured with a single command, with no device side setup.
+With --local the benchmark is run directly instead, for a Linux host that
+can execute target binaries (a target chroot or qemu-user).
+
+For continuous builds, --json writes the median of every measurement of
+each view state, and --baseline compares them against such a file, exiting
+with an error when one of them regressed by more than --threshold percent.
+
+  run_compositor_benchmark.py [-s serial | --local] [-b benchmark] \\
+      [--pull-png dir] [--json file] [--baseline file [--threshold pct]] \\
+      viewstate... [-- benchmark options]
+"""
+
+import json
+import optparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+BENCHMARK = "webkit_compositor_benchmark"
+DEVICE_DIR = "/data/local/tmp/webkit_benchmarks"
+
+# "frame      avg    12.00ms  min ..." lines printed by printStats()
+STATS_LINE = re.compile(r"^(\S+)\s+avg\s+\S+ms\s+min\s+\S+ms\s+median\s+([\d.]+)ms")
+# "4 workers: median    12.00ms, ..." lines printed by webkit_tile_benchmark
+WORKERS_LINE = re.compile(r"^(\d+ workers): median\s+([\d.]+)ms")
+
+
+def run(command):
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    output = process.communicate()[0].decode("utf-8", "replace")
+    if process.returncode:
+        sys.stderr.write(output)
+        sys.exit("%s failed" % " ".join(command))
+    return output
+
+
+def adb(options, *args):
+    command = ["adb"]
+    if options.serial:
+        command += ["-s", options.serial]
+    return run(command + list(args))
+
+
+class DeviceRunner(object):
+    """Runs the benchmark on a device or an emulator over adb."""
+
+    def __init__(self, options, binary):
+        self.options = options
+        adb(options, "shell", "mkdir", "-p", DEVICE_DIR)
+        self.benchmark = DEVICE_DIR + "/" + options.benchmark
+        adb(options, "push", binary, self.benchmark)
+        adb(options, "shell", "chmod", "755", self.benchmark)
+
+    def push(self, viewState):
+        deviceViewState = DEVICE_DIR + "/" + os.path.basename(viewState)
+        adb(self.options, "push", viewState, deviceViewState)
+        return deviceViewState
+
+    def run(self, args):
+        return adb(self.options, "shell", " ".join([self.benchmark] + args))
+
+    def pngPath(self, viewState):
+        return viewState + ".png"
+
+    def pull(self, path, destination):
+        adb(self.options, "pull", path, destination)
+
+    def remove(self, *paths):
+        adb(self.options, "shell", "rm", "-f", *paths)
+
+    def close(self):
+        pass
+
+
+class LocalRunner(object):
+    """Runs the benchmark directly, on a host that can execute it."""
+
+    def __init__(self, options, binary):
+        self.benchmark = binary
+        self.directory = tempfile.mkdtemp(prefix="webkit_benchmarks")
+
+    def push(self, viewState):
+        return os.path.abspath(viewState)
+
+    def run(self, args):
+        return run([self.benchmark] + args)
+
+    def pngPath(self, viewState):
+        return os.path.join(self.directory, os.path.basename(viewState) + ".png")
+
+    def pull(self, path, destination):
+        shutil.copyfile(path, destination)
+
+    def remove(self, *paths):
+        pass
+
+    def close(self):
+        shutil.rmtree(self.directory)
+
+
+def parse_medians(output):
+    medians = {}
+    for line in output.splitlines():
+        match = STATS_LINE.match(line) or WORKERS_LINE.match(line)
+        if match:
+            medians[match.group(1)] = float(match.group(2))
+    return medians
+
+
+def compare(results, baseline, threshold):
+    regressions = 0
+    for name in sorted(results):
+        for measurement, median in sorted(results[name].items()):
+            base = baseline.get(name, {}).get(measurement)
+            if not base:
+                continue
+            change = (median - base) * 100.0 / base
+            regressed = change > threshold
+            if regressed:
+                regressions += 1
+            print("%-30s %-10s %8.2fms -> %8.2fms  %+6.1f%%%s" % (name, measurement, base, median,
+                  change, "  REGRESSION" if regressed else ""))
+    return regressions
+
+
+def find_benchmark(options):
+    if options.binary:
+        return options.binary
+    out = os.environ.get("ANDROID_PRODUCT_OUT")
+    if not out:
+        sys.exit("ANDROID_PRODUCT_OUT is not set, run lunch or use --binary")
+    for directory in ("system/bin", "system/xbin", "data/local/tmp"):
+        path = os.path.join(out, directory, options.benchmark)
+        if os.path.exists(path):
+            return path
+    sys.exit("%s is not built, run mmm external/webkit" % options.benchmark)
+
+
+def main():
+    parser = optparse.OptionParser(usage="%prog [options] viewstate... [-- benchmark options]")
+    parser.add_option("-s", "--serial", help="serial number of the device or emulator to use")
+    parser.add_option("-b", "--benchmark", default=BENCHMARK,
+                      help="benchmark to run, %s by default" % BENCHMARK)
+    parser.add_option("--binary", help="benchmark executable, found in $ANDROID_PRODUCT_OUT by default")
+    parser.add_option("--pull-png", metavar="DIR",
+                      help="save the last frame of each view state as a PNG in DIR")
+    parser.add_option("--full", action="store_true", help="print the per frame times too")
+    parser.add_option("--local", action="store_true",
+                      help="run the benchmark on this host rather than over adb")
+    parser.add_option("--json", metavar="FILE", help="write the medians of each view state to FILE")
+    parser.add_option("--baseline", metavar="FILE",
+                      help="compare the medians against FILE, written by --json")
+    parser.add_option("--threshold", type="float", default=5.0,
+                      help="percentage a median may regress by, 5 by default")
+    args = sys.argv[1:]
+    benchmarkArgs = []
+    if "--" in args:
+        benchmarkArgs = args[args.index("--") + 1:]
+        args = args[:args.index("--")]
+    options, viewStates = parser.parse_args(args)
+    if not viewStates:
+        parser.error("no view state given")
+    if options.pull_png and options.benchmark != BENCHMARK:
+        parser.error("only %s writes frames" % BENCHMARK)
+    if options.local and options.serial:
+        parser.error("--local and --serial are exclusive")
+
+    runnerClass = LocalRunner if options.local else DeviceRunner
+    runner = runnerClass(options, find_benchmark(options))
+    results = {}
+
+    for viewState in viewStates:
+        name = os.path.basename(viewState)
+        targetViewState = runner.push(viewState)
+
+        command = list(benchmarkArgs)
+        png = runner.pngPath(targetViewState)
+        if options.pull_png:
+            command += ["-o", png]
+        command.append(targetViewState)
+        output = runner.run(command)
+
+        for line in output.splitlines():
+            isFrameLine = line.startswith("frame ") and " at " in line
+            if options.full or not isFrameLine:
+                print(line.rstrip())
+        results[name] = parse_medians(output)
+
+        if options.pull_png:
+            if not os.path.isdir(options.pull_png):
+                os.makedirs(options.pull_png)
+            runner.pull(png, os.path.join(options.pull_png, name + ".png"))
+        runner.remove(targetViewState, png)
+    runner.close()
+
+    if options.json:
+        with open(options.json, "w") as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+    if options.baseline:
+        with open(options.baseline) as f:
+            baseline = json.load(f)
+        regressions = compare(results, baseline, options.threshold)
+        if regressions:
+            sys.exit("%d measurements regressed by more than %.1f%%" % (regressions, options.threshold))
+
+
+if __name__ == "__main__":
+    main()
@@ -30,6 +30,7 @@
 #include "PicturePile.h"
 
 #include "AndroidLog.h"
+#include "Color.h"
 #include "FloatRect.h"
 #include "GraphicsContext.h"
 #include "PlatformGraphicsContextSkia.h"
@@ -39,6 +40,8 @@
 #include "SkRect.h"
 #include "SkRegion.h"
 
+#include <wtf/CurrentTime.h>
+
 #if USE_RECORDING_CONTEXT
 #include "PlatformGraphicsContextRecording.h"
 #else
@@ -49,17 +52,46 @@
 #define MAX_OVERLAP_COUNT 2
 #define MAX_OVERLAP_AREA .7
 
+// Containers taking longer than this (in ms) to record and paint are not
+// coalesced with small invals falling inside them, the inval is recorded on
+// top of them instead
+#define EXPENSIVE_CONTAINER_TIME 8
+// An inval is small if the container is at least this many times larger
+#define SMALL_INVAL_AREA_RATIO 4
+// Overlapping invals are not promoted to a full re-record of the pile if it
+// is estimated to take longer than this (in ms)
+#define MAX_FULL_RECORD_TIME 30
+
 namespace WebCore {
 
 static SkIRect toSkIRect(const IntRect& rect) {
     return SkIRect::MakeXYWH(rect.x(), rect.y(), rect.width(), rect.height());
 }
 
+void PictureCost::recorded(double ms)
+{
+    m_recordTime = ms;
+    m_recordCount++;
+}
+
+void PictureCost::painted(double ms)
+{
+    MutexLocker locker(m_paintTimeLock);
+    m_paintTime = m_paintTime ? (m_paintTime * 3 + ms) / 4 : ms;
+}
+
+double PictureCost::paintTime() const
+{
+    MutexLocker locker(m_paintTimeLock);
+    return m_paintTime;
+}
+
 PictureContainer::PictureContainer(const PictureContainer& other)
     : picture(other.picture)
     , area(other.area)
     , dirty(other.dirty)
     , prerendered(other.prerendered)
+    , cost(other.cost)
 {
     SkSafeRef(picture);
 }
@@ -180,7 +212,9 @@ void PicturePile::updatePicturesIfNeeded(PicturePainter* painter)
 void PicturePile::updatePicture(PicturePainter* painter, PictureContainer& pc)
 {
     TRACE_METHOD();
+    double startTime = currentTimeMS();
     Picture* picture = recordPicture(painter, pc);
+    pc.cost->recorded(currentTimeMS() - startTime);
     SkSafeUnref(pc.picture);
     pc.picture = picture;
     pc.dirty = false;
@@ -230,17 +264,29 @@ void PicturePile::applyWebkitInvals()
             overlaps.append(i);
     }
 
+    if (overlaps.size() >= MAX_OVERLAP_COUNT) {
+        // Don't coalesce the containers that are expensive to regenerate,
+        // only record the inval on top of them
+        for (int i = (int) overlaps.size() - 1; i >= 0; i--) {
+            if (shouldKeepContainer(m_pile[overlaps[i]], inval))
+                overlaps.remove(i);
+        }
+    }
+
     if (overlaps.size() >= MAX_OVERLAP_COUNT) {
         ALOGV("Exceeds overlap count");
         IntRect overlap = inval;
-        for (int i = (int) overlaps.size() - 1; i >= 0; i--) {
+        for (size_t i = 0; i < overlaps.size(); i++)
             overlap.unite(m_pile[overlaps[i]].area);
-            m_pile.remove(overlaps[i]);
-        }
         float overlapArea = overlap.width() * overlap.height();
         float totalArea = m_size.width() * m_size.height();
-        if (overlapArea / totalArea > MAX_OVERLAP_AREA)
-            overlap = IntRect(0, 0, m_size.width(), m_size.height());
+        if (overlapArea / totalArea > MAX_OVERLAP_AREA) {
+            IntRect fullArea(0, 0, m_size.width(), m_size.height());
+            if (estimatedRecordTime(fullArea, overlaps) < MAX_FULL_RECORD_TIME)
+                overlap = fullArea;
+        }
+        for (int i = (int) overlaps.size() - 1; i >= 0; i--)
+            m_pile.remove(overlaps[i]);
         appendToPile(overlap, inval);
         return;
     }
@@ -249,16 +295,47 @@ void PicturePile::applyWebkitInvals()
     appendToPile(inval);
 }
 
+bool PicturePile::shouldKeepContainer(const PictureContainer& pc, const IntRect& inval)
+{
+    if (!pc.area.contains(inval) || !pc.cost->recordCount())
+        return false;
+    float containerArea = pc.area.width() * pc.area.height();
+    float invalArea = inval.width() * inval.height();
+    return pc.cost->cost() >= EXPENSIVE_CONTAINER_TIME
+        && containerArea >= SMALL_INVAL_AREA_RATIO * invalArea;
+}
+
+double PicturePile::estimatedRecordTime(const IntRect& area, const Vector<int>& containers)
+{
+    // extrapolate from the recording time per pixel of the given containers
+    double recordTime = 0;
+    float recordedArea = 0;
+    for (size_t i = 0; i < containers.size(); i++) {
+        const PictureContainer& pc = m_pile[containers[i]];
+        if (!pc.cost->recordCount())
+            continue;
+        recordTime += pc.cost->recordTime();
+        recordedArea += pc.area.width() * pc.area.height();
+    }
+    if (!recordedArea)
+        return 0;
+    return recordTime * area.width() * area.height() / recordedArea;
+}
+
 void PicturePile::appendToPile(const IntRect& inval, const IntRect& originalInval)
 {
     ALOGV("Adding inval " INT_RECT_FORMAT " for original inval " INT_RECT_FORMAT,
             INT_RECT_ARGS(inval), INT_RECT_ARGS(originalInval));
-    // Remove any entries this obscures
+    PictureContainer container(inval);
+    // Remove any entries this obscures, keeping the measured cost of the
+    // content if the area is the same
     for (int i = (int) m_pile.size() - 1; i >= 0; i--) {
-        if (inval.contains(m_pile[i].area))
+        if (inval.contains(m_pile[i].area)) {
+            if (m_pile[i].area == inval)
+                container.cost = m_pile[i].cost;
             m_pile.remove(i);
+        }
     }
-    PictureContainer container(inval);
     if (ENABLE_PRERENDERED_INVALS) {
         container.prerendered = PrerenderedInval::create(originalInval.isEmpty()
                                                          ? inval : originalInval);
@@ -279,6 +356,60 @@ PrerenderedInval* PicturePile::prerenderedInvalForArea(const IntRect& area)
     return 0;
 }
 
+bool PicturePile::isSolidColor(const IntRect& area, Color& color)
+{
+#if USE_RECORDING_CONTEXT
+    // The topmost container intersecting the area clips out the ones below,
+    // so it has to cover the area on its own
+    for (int i = (int) m_pile.size() - 1; i >= 0; i--) {
+        PictureContainer& pc = m_pile[i];
+        if (!pc.area.intersects(area))
+            continue;
+        if (!pc.picture || !pc.area.contains(area))
+            return false;
+        // recordings are made in content coordinates, like the area
+        return pc.picture->isSolidColor(area, color);
+    }
+#endif
+    return false;
+}
+
+void PicturePile::findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors)
+{
+    colors.clear();
+    colors.resize(areas.size());
+#if USE_RECORDING_CONTEXT
+    // Group the areas by the container that has to cover them, as in
+    // isSolidColor(), so that each recording is searched once for all of them
+    Vector<Vector<size_t> > areasPerContainer;
+    areasPerContainer.resize(m_pile.size());
+    for (size_t j = 0; j < areas.size(); j++) {
+        for (int i = (int) m_pile.size() - 1; i >= 0; i--) {
+            PictureContainer& pc = m_pile[i];
+            if (!pc.area.intersects(areas[j]))
+                continue;
+            if (pc.picture && pc.area.contains(areas[j]))
+                areasPerContainer[i].append(j);
+            break;
+        }
+    }
+
+    Vector<IntRect> containerAreas;
+    Vector<Color> containerColors;
+    for (size_t i = 0; i < m_pile.size(); i++) {
+        const Vector<size_t>& indexes = areasPerContainer[i];
+        if (indexes.isEmpty())
+            continue;
+        containerAreas.clear();
+        for (size_t j = 0; j < indexes.size(); j++)
+            containerAreas.append(areas[indexes[j]]);
+        m_pile[i].picture->findSolidColors(containerAreas, containerColors);
+        for (size_t j = 0; j < indexes.size(); j++)
+            colors[indexes[j]] = containerColors[j];
+    }
+#endif
+}
+
 float PicturePile::maxZoomScale() const
 {
     float maxZoomScale = 1;
@@ -301,7 +432,9 @@ bool PicturePile::isEmpty() const
 void PicturePile::drawPicture(SkCanvas* canvas, PictureContainer& pc)
 {
     TRACE_METHOD();
+    double startTime = currentTimeMS();
     pc.picture->draw(canvas);
+    pc.cost->painted(currentTimeMS() - startTime);
 }
 
 Picture* PicturePile::recordPicture(PicturePainter* painter, PictureContainer& pc)
@@ -323,8 +456,10 @@ Picture* PicturePile::recordPicture(PicturePainter* painter, PictureContainer& p
 #else
 void PicturePile::drawPicture(SkCanvas* canvas, PictureContainer& pc)
 {
+    double startTime = currentTimeMS();
     canvas->translate(pc.area.x(), pc.area.y());
     pc.picture->draw(canvas);
+    pc.cost->painted(currentTimeMS() - startTime);
 }
 
 Picture* PicturePile::recordPicture(PicturePainter* painter, PictureContainer& pc)
@@ -36,6 +36,7 @@
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
 #include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
 #include <wtf/Vector.h>
 
 #define USE_RECORDING_CONTEXT true
@@ -53,6 +54,7 @@ class SkCanvas;
 
 namespace WebCore {
 
+class Color;
 class GraphicsContext;
 
 class PicturePainter {
@@ -65,6 +67,43 @@ public:
     virtual ~PicturePainter() {}
 };
 
+// Measured cost of a PictureContainer's content. It is shared by the copies
+// of the pile handed to the UI side, so that the paint times measured while
+// rasterizing tiles are fed back to the pile used for recording.
+class PictureCost : public ThreadSafeRefCounted<PictureCost> {
+    WTF_MAKE_NONCOPYABLE(PictureCost);
+public:
+    static PassRefPtr<PictureCost> create()
+    {
+        return adoptRef(new PictureCost());
+    }
+
+    // WebKit thread only
+    void recorded(double ms);
+    double recordTime() const { return m_recordTime; }
+    int recordCount() const { return m_recordCount; }
+
+    // Called from any painting thread, the value is a running average
+    void painted(double ms);
+    double paintTime() const;
+
+    // estimated time to regenerate the content (record and paint it again)
+    double cost() const { return m_recordTime + paintTime(); }
+
+private:
+    PictureCost()
+        : m_recordTime(0)
+        , m_recordCount(0)
+        , m_paintTime(0)
+    {}
+
+    double m_recordTime;
+    int m_recordCount;
+    // doubles aren't stored atomically on every CPU, guards m_paintTime
+    mutable WTF::Mutex m_paintTimeLock;
+    double m_paintTime;
+};
+
 class PictureContainer {
 public:
     Picture* picture;
@@ -72,12 +111,14 @@ public:
     bool dirty;
     RefPtr<PrerenderedInval> prerendered;
     float maxZoomScale;
+    RefPtr<PictureCost> cost;
 
     PictureContainer(const IntRect& area)
         : picture(0)
         , area(area)
         , dirty(true)
         , maxZoomScale(1)
+        , cost(PictureCost::create())
     {}
 
     PictureContainer(const PictureContainer& other);
@@ -105,6 +146,8 @@ public:
     PrerenderedInval* prerenderedInvalForArea(const IntRect& area);
 
     // UI-side methods used to check content, after construction/updates are complete
+    bool isSolidColor(const IntRect& area, Color& color);
+    void findSolidColors(const Vector<IntRect>& areas, Vector<Color>& colors);
     float maxZoomScale() const;
     bool isEmpty() const;
 
@@ -113,6 +156,8 @@ private:
     void updatePicture(PicturePainter* painter, PictureContainer& container);
     Picture* recordPicture(PicturePainter* painter, PictureContainer& container);
     void appendToPile(const IntRect& inval, const IntRect& originalInval = IntRect());
+    bool shouldKeepContainer(const PictureContainer& container, const IntRect& inval);
+    double estimatedRecordTime(const IntRect& area, const Vector<int>& containers);
     void drawWithClipRecursive(SkCanvas* canvas, int index);
     void drawPicture(SkCanvas* canvas, PictureContainer& pc);
 
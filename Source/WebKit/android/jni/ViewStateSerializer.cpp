@@ -27,6 +27,7 @@
 #define LOG_NDEBUG 1
 
 #include "config.h"
+#include "ViewStateSerializer.h"
 
 #include "BaseLayerAndroid.h"
 #include "CreateJavaOutputStreamAdaptor.h"
@@ -176,15 +177,18 @@ static BaseLayerAndroid* nativeDeserializeViewState(JNIEnv* env, jobject, jint v
     // clean up the javaStream now that we have everything in memory
     delete javaStream;
 
-    Color color = stream.readU32();
-
+    return deserializeViewState(version, &stream);
+}
 
+BaseLayerAndroid* deserializeViewState(int version, SkMemoryStream* stream)
+{
+    Color color = stream->readU32();
 
     LayerContent* content;
     if (version == 1) {
-        content = new LegacyPictureLayerContent(&stream);
+        content = new LegacyPictureLayerContent(stream);
     } else {
-        SkPicture* picture = new SkPicture(&stream);
+        SkPicture* picture = new SkPicture(stream);
         content = new PictureLayerContent(picture);
         SkSafeUnref(picture);
     }
@@ -197,9 +201,9 @@ static BaseLayerAndroid* nativeDeserializeViewState(JNIEnv* env, jobject, jint v
     layer->markAsDirty(dirtyRegion);
 
     SkSafeUnref(content);
-    int childCount = stream.readS32();
+    int childCount = stream->readS32();
     for (int i = 0; i < childCount; i++) {
-        LayerAndroid* childLayer = deserializeLayer(version, &stream);
+        LayerAndroid* childLayer = deserializeLayer(version, stream);
         if (childLayer)
             layer->addChild(childLayer);
     }
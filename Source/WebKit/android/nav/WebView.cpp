@@ -1101,6 +1101,10 @@ static int nativeTileProfilingGetInt(JNIEnv *env, jobject obj, int frame, int ti
         return record->level;
     if (key == "isReady")
         return record->isReady ? 1 : 0;
+    if (key == "queueDepth")
+        return record->queueDepth;
+    if (key == "missedDeadlines")
+        return record->missedDeadlines;
     return -1;
 }
 